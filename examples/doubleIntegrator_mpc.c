@@ -214,7 +214,7 @@ int main( )
 
  		/** prepare QP for next solution:  put new data in second but last interval */
 		t = getTime();
-		statusFlag = qpDUNES_updateIntervalData( &(mpcProblem.qpData), mpcProblem.qpData.intervals[nI-1], 0, 0, 0, 0, ziLow,ziUpp, 0, 0,0, 0 );		/* H, C, c do not need to be updated b/c LTI */
+		statusFlag = qpDUNES_updateIntervalData( &(mpcProblem.qpData), mpcProblem.qpData.intervals[nI-1], 0, 0, 0, 0, ziLow,ziUpp, 0, 0,0, 0, QPDUNES_ROW_MAJOR );		/* H, C, c do not need to be updated b/c LTI */
 		if (statusFlag != QPDUNES_OK)
 		{
 			printf("Update of interval data failed\n");
@@ -68,6 +68,7 @@
 int main( )
 {
 	return_t statusFlag;
+	return_t prepStatusFlag = QPDUNES_OK;
 
 	int iter, ii;
 
@@ -194,6 +195,7 @@ int main( )
 
 	/** MAIN MPC SIMULATION LOOP */
  	for ( iter=0; iter<nSteps; ++iter ) {
+ 		/** FEEDBACK PHASE: only embed the current initial value and iterate */
  		/** (1) embed current initial value */
 		for ( ii=0; ii<nX; ++ii ) {
 			z0Low[ii] = x0[ii];
@@ -203,7 +205,7 @@ int main( )
 			z0Low[ii] = zLow[ii];
 			z0Upp[ii] = zUpp[ii];
 		}
-		statusFlag = qpDUNES_updateIntervalData( &qpData, qpData.intervals[0], 0, 0, 0, 0, z0Low,z0Upp, D,d0Low,d0Upp, 0 );
+		statusFlag = qpDUNES_updateIntervalData( &qpData, qpData.intervals[0], 0, 0, 0, 0, z0Low,z0Upp, D,d0Low,d0Upp, 0, QPDUNES_ROW_MAJOR );
 		if (statusFlag != QPDUNES_OK) {
 			printf( "Initial value embedding failed.\n" );
 			return (int)statusFlag;
@@ -220,8 +222,6 @@ int main( )
 			printf( "QP solution %d failed.\n", iter );
 			return (int)statusFlag;
 		}
-		
-		// up to here in fdb step
 
 
 		/** (3) obtain primal and dual optimal solution */
@@ -230,32 +230,53 @@ int main( )
 		/// ...
 		
 
- 		/** (4) prepare QP for next solution */
-		qpDUNES_shiftLambda( &qpData );			/* shift multipliers */
-		qpDUNES_shiftIntervals( &qpData );		/* shift intervals (particulary important when using qpOASES for underlying local QPs) */
-		
-		// optional
-		
-		/// H = ...
-		/// g = ...
-		/// C = ...
-		/// c = ...
-		/// zLow = ...
-		/// zUpp = ...
-		statusFlag = qpDUNES_updateData( &qpData, H, g, C, c, zLow,zUpp, D,dLow,dUpp );		/* data update: components not given here keep their previous value */
-		if (statusFlag != QPDUNES_OK) {
-			printf( "Data update failed.\n" );
-			return (int)statusFlag;
+ 		/** PREPARATION PHASE: runs in a background thread while waiting for the next measurement
+ 		 *  (if compiled with OpenMP, otherwise sequentially) */
+		#ifdef __QPDUNES_PARALLEL__
+		#pragma omp parallel sections num_threads(2)
+		#endif
+		{
+			#ifdef __QPDUNES_PARALLEL__
+			#pragma omp section
+			#endif
+			{
+				/** (4) prepare QP for next solution */
+				qpDUNES_shiftLambda( &qpData );			/* shift multipliers */
+				qpDUNES_shiftIntervals( &qpData );		/* shift intervals (particulary important when using qpOASES for underlying local QPs) */
+
+				// optional
+
+				/// H = ...
+				/// g = ...
+				/// C = ...
+				/// c = ...
+				/// zLow = ...
+				/// zUpp = ...
+				prepStatusFlag = qpDUNES_updateData( &qpData, H, g, C, c, zLow,zUpp, D,dLow,dUpp );		/* data update: components not given here keep their previous value */
+
+				// mandatory
+
+				/* precompute everything that does not depend on the next initial value */
+				if (prepStatusFlag == QPDUNES_OK) {
+					prepStatusFlag = qpDUNES_prepare( &qpData );
+				}
+			}
+
+			#ifdef __QPDUNES_PARALLEL__
+			#pragma omp section
+			#endif
+			{
+				/** (5) simulate next initial value */
+				for (ii=0; ii<nX; ++ii) {
+					/// x0 = ...
+					x0[ii] = zOpt[1*nZ+ii];
+				}
+			}
+		}
+		if (prepStatusFlag != QPDUNES_OK) {
+			printf( "Preparation of next QP failed.\n" );
+			return (int)prepStatusFlag;
 		}
-		
-		// mandatory
-
-
-		/** (5) simulate next initial value */
-		for (ii=0; ii<nX; ++ii) {
-			/// x0 = ...
-			x0[ii] = zOpt[1*nZ+ii];
- 		}
 	}
 
 
@@ -47,6 +47,16 @@ return_t qpDUNES_solve(	qpData_t* const qpData
 						);
 
 
+/* ----------------------------------------------
+ * preparation phase of a real-time iteration: precompute all
+ * parts of the next solve that do not depend on the initial value;
+ * qpDUNES_solve then acts as feedback phase
+ *
+ >>>>>>                                           */
+return_t qpDUNES_prepare(	qpData_t* const qpData
+							);
+
+
 void qpDUNES_logIteration( qpData_t* qpData,
 						itLog_t* itLogPtr,
 						real_t objValIncumbent,
@@ -55,6 +65,11 @@ void qpDUNES_logIteration( qpData_t* qpData,
 
 
 
+return_t qpDUNES_detectLambdaChanges(	qpData_t* const qpData,
+										xn_vector_t* const deltaLambda
+										);
+
+
 return_t qpDUNES_solveAllLocalQPs(	qpData_t* const qpData,
 								const xn_vector_t* const lambda
 								);
@@ -77,11 +92,79 @@ return_t qpDUNES_solveLocalQP(	qpData_t* const qpData,
 return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 									);
 
+return_t qpDUNES_setupNewtonHessian(	qpData_t* const qpData
+									);
+
+boolean_t qpDUNES_isNewtonBlockUpdatable(	const qpData_t* const qpData,
+											const interval_t* const interval
+											);
+
+real_t qpDUNES_getNewtonBlockWeight(	const qpData_t* const qpData,
+										const interval_t* const interval,
+										int_t ii,
+										actSetWord_t status
+										);
+
+boolean_t qpDUNES_updateNewtonHessianBlock(	qpData_t* const qpData,
+											xn2x_matrix_t* const hessian,
+											int_t kk
+											);
+
+boolean_t qpDUNES_updateNewtonHessianSubDiagBlock(	qpData_t* const qpData,
+													xn2x_matrix_t* const hessian,
+													int_t kk
+													);
+
+real_t* qpDUNES_lookupProjCache(	qpData_t* const qpData,
+									interval_t* const interval
+									);
+
+return_t qpDUNES_computeStageProjections(	qpData_t* const qpData,
+											interval_t* const interval,
+											real_t* const entry
+											);
+
+boolean_t qpDUNES_getCachedNewtonHessianBlock(	qpData_t* const qpData,
+												xn2x_matrix_t* const hessian,
+												int_t kk
+												);
+
+boolean_t qpDUNES_getCachedNewtonHessianSubDiagBlock(	qpData_t* const qpData,
+														xn2x_matrix_t* const hessian,
+														int_t kk
+														);
+
 return_t qpDUNES_factorNewtonSystem(	qpData_t* const qpData,
 									boolean_t* const isHessianRegularized,
 									int_t lastActSetChangeIdx
 									);
 
+return_t qpDUNES_regularizeNewtonHessianBlock(	qpData_t* const qpData,
+												xn2x_matrix_t* const hessian,
+												int_t kk
+												);
+
+void qpDUNES_adaptRegularization(	qpData_t* const qpData,
+									boolean_t isHessianRegularized,
+									real_t alpha,
+									real_t objValGain
+									);
+
+return_t qpDUNES_modifyNewtonHessianPivot(	qpData_t* const qpData,
+											facReal_t* const pivot,
+											int_t kk,
+											int_t jj
+											);
+
+return_t qpDUNES_getUnconstrainedNewtonHessianDiag(	qpData_t* const qpData,
+													real_t* const diagElem,
+													int_t kk,
+													int_t jj
+													);
+
+
+return_t qpDUNES_getNewtonGradient(	qpData_t* const qpData
+									);
 
 return_t qpDUNES_computeNewtonGradient(	qpData_t* const qpData,
 								xn_vector_t* gradient,
@@ -90,37 +173,98 @@ return_t qpDUNES_computeNewtonGradient(	qpData_t* const qpData,
 
 
 return_t qpDUNES_factorizeNewtonHessian(	qpData_t* const qpData,
-										xn2x_matrix_t* const cholHessian,
+										xn2x_factor_t* const cholHessian,
 										xn2x_matrix_t* const hessian,
+										int_t blockIdxStart,
+										int_t blockIdxEnd,
 										boolean_t* isHessianRegularized
 										);
 
 
 return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
-												xn2x_matrix_t* const cholHessian,
+												xn2x_factor_t* const cholHessian,
+												xn2x_matrix_t* const hessian,
+												int_t lastActSetChangeIdx,
+												int_t blockIdxEnd,
+												boolean_t* isHessianRegularized
+												);
+
+
+return_t qpDUNES_factorizeNewtonHessianTwisted(	qpData_t* const qpData,
+												xn2x_factor_t* const cholHessian,
 												xn2x_matrix_t* const hessian,
+												int_t firstActSetChangeIdx,
 												int_t lastActSetChangeIdx,
 												boolean_t* isHessianRegularized
 												);
 
 
+void qpDUNES_updateNewtonFactorStats(	qpData_t* const qpData,
+										int_t firstActSetChangeIdx,
+										int_t lastActSetChangeIdx
+										);
+
+int_t qpDUNES_chooseNewtonFactorTwist(	qpData_t* const qpData,
+										int_t blockIdxStart,
+										int_t blockIdxEnd
+										);
+
+
+return_t qpDUNES_factorizeNewtonHessianBlockJacobi(	qpData_t* const qpData,
+													xn2x_factor_t* const cholHessian,
+													xn2x_matrix_t* const hessian,
+													boolean_t* isHessianRegularized
+													);
+
+
 return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
 									xn_vector_t* const res,
-									const xn2x_matrix_t* const cholHessian,	/**< lower triangular Newton Hessian factor */
+									const xn2x_factor_t* const cholHessian,	/**< lower triangular Newton Hessian factor */
 									const xn_vector_t* const gradient
 									);
 
 return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 											xn_vector_t* const res,
-											const xn2x_matrix_t* const cholHessian,	/**< lower triangular Newton Hessian factor */
+											const xn2x_factor_t* const cholHessian,	/**< lower triangular Newton Hessian factor */
+											const xn_vector_t* const gradient
+											);
+
+return_t qpDUNES_solveNewtonEquationTwisted(	qpData_t* const qpData,
+											xn_vector_t* const res,
+											const xn2x_factor_t* const cholHessian,	/**< twisted Newton Hessian factor */
 											const xn_vector_t* const gradient
 											);
 
+return_t qpDUNES_solveNewtonEquationBlockJacobi(	qpData_t* const qpData,
+												xn_vector_t* const res,
+												const xn2x_factor_t* const cholHessian,	/**< factors of the diagonal Newton Hessian blocks */
+												const xn_vector_t* const gradient
+												);
+
+return_t qpDUNES_backsolveNewtonFactor(	qpData_t* const qpData,
+										xn_vector_t* const res,
+										const xn_vector_t* const rhs
+										);
+
+return_t qpDUNES_solveNewtonSystem(	qpData_t* const qpData,
+									xn_vector_t* const res,
+									const xn_vector_t* const rhs,
+									boolean_t isNewtonStep	/**< inexact solve of the (shifted) system for a Newton step */
+									);
+
 return_t qpDUNES_multiplyNewtonHessianVector(	qpData_t* const qpData,
 											xn_vector_t* const res,
 											const xn2x_matrix_t* const hessian, /**< Newton Hessian */
 											const xn_vector_t* const vec	);
 
+return_t qpDUNES_multiplyNewtonHessianVectorMatrixFree(	qpData_t* const qpData,
+														xn_vector_t* const res,
+														const xn_vector_t* const vec	);
+
+return_t qpDUNES_multiplyRegularizedNewtonHessianVector(	qpData_t* const qpData,
+															xn_vector_t* const res,
+															const xn_vector_t* const vec	);
+
 
 return_t qpDUNES_diffWorkingSet(	qpData_t* const qpData
 								);
@@ -203,6 +347,10 @@ return_t qpDUNES_gridSearch(	qpData_t* const qpData,
 return_t qpDUNES_infeasibilityCheck(	qpData_t* qpData
 										);
 
+real_t qpDUNES_getCouplingViolationBound(	qpData_t* const qpData,
+											const xn_vector_t* const dir
+											);
+
 
 void qpDUNES_getPrimalSol(	const qpData_t* const qpData,
 							real_t* const z
@@ -214,9 +362,55 @@ return_t qpDUNES_getDualSol(	const qpData_t* const qpData,
 							);
 
 
+return_t qpDUNES_refreshNewtonFactor(	qpData_t* const qpData
+										);
+
+
+/* ----------------------------------------------
+ * tangential predictor: directional sensitivity of the solution
+ * w.r.t. initial value and dynamics offsets, reusing the Newton
+ * Hessian factor of the last solve; call after qpDUNES_solve and
+ * before any data update or shift; the matrix-free Newton solver
+ * solves the sensitivity system without block shifts up to the
+ * refinement tolerance, not up to its inexact Newton forcing term
+ *
+ >>>>>>                                           */
+return_t qpDUNES_getSensitivity(	qpData_t* const qpData,
+									const real_t* const dx0,
+									const real_t* const dc,
+									real_t* const dLambda,
+									real_t* const dz
+									);
+
+return_t qpDUNES_getSensitivityMatrixX0(	qpData_t* const qpData,
+											real_t* const dLambdaDx0,
+											real_t* const dzDx0
+											);
+
+
 real_t qpDUNES_computeObjectiveValue(	qpData_t* const qpData
 									);
 
+real_t qpDUNES_updateObjectiveValue(	qpData_t* const qpData
+										);
+
+real_t qpDUNES_sumStageObjectiveValues(	qpData_t* const qpData
+										);
+
+
+return_t qpDUNES_evaluateTrialPoint(	qpData_t* const qpData,
+										real_t alpha,
+										const xn_vector_t* const deltaLambdaFS,
+										xn_vector_t* const gradientTry,
+										real_t* const objVal,
+										real_t* const slope
+										);
+
+return_t qpDUNES_computeGridObjectiveValues(	qpData_t* const qpData,
+												int_t nAlpha,
+												const real_t* const alphas,
+												real_t* const objVals
+												);
 
 real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
 												const real_t alpha
@@ -228,8 +422,6 @@ uint_t qpDUNES_getActSet(	const qpData_t* const qpData,
 						);
 
 uint_t qpDUNES_compareActSets(	const qpData_t* const qpData,
-							const int_t *const *const newActSetStatus,
-							const int_t *const *const oldActSetStatus,
 							int_t *const lastActSetChangeIdx
 							);
 
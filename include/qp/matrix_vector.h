@@ -76,25 +76,46 @@ return_t multiplyInvHz(	qpData_t* const qpData,
 						const int_t nV 	);
 
 
-return_t multiplyCz(	qpData_t* const qpData,
-						x_vector_t* const res,
+/** C is nXK1 x nV, with nXK1 the number of states of the next stage */
+return_t multiplyCz(	x_vector_t* const res,
 						const xz_matrix_t* const C,
-						const z_vector_t* const z 	);
+						const z_vector_t* const z,
+						const int_t nXK1,
+						const int_t nV 	);
 
 
 
 
-return_t multiplyCTy(	qpData_t* const qpData,
-						z_vector_t* const res,
+return_t multiplyCTy(	z_vector_t* const res,
 						const xz_matrix_t* const C,
-						const x_vector_t* const y 	);
+						const x_vector_t* const y,
+						const int_t nXK1,
+						const int_t nV 	);
 
+/** C*z and C.T*y skipping structural zeros of the A part */
+return_t multiplyCzStructured(	x_vector_t* const res,
+								const xz_matrix_t* const C,
+								const z_vector_t* const z,
+								const int_t nXK1,
+								const int_t nV
+								);
+
+return_t multiplyCTyStructured(	z_vector_t* const res,
+								const xz_matrix_t* const C,
+								const x_vector_t* const y,
+								const int_t nXK1,
+								const int_t nV
+								);
 
-/** Inverse matrix times matrix product res = Q^-1 * A */
+
+/** Inverse matrix times matrix product res = Q^-1 * A; A is the leading nXK1 x nX block of C */
 return_t multiplyAInvQ(	qpData_t* const qpData,
 						xx_matrix_t* const res,
 						const xx_matrix_t* const C,
-						const vv_matrix_t* const cholH
+						const vv_matrix_t* const cholH,
+						const int_t nXK1,
+						const int_t nX,
+						const int_t nV
 						);
 
 return_t multiplyInvQAT(	qpData_t* const qpData,
@@ -319,6 +340,14 @@ return_t multiplyInvMatrixVector(	qpData_t* const qpData,
 									int_t dim0						/**< dimension of symmetric matrix */
 									);
 
+return_t multiplyVectorInvMatrixVector(	qpData_t* const qpData,
+										real_t* const res,
+										const matrix_t* const cholH,
+										const vector_t* const x,
+										vector_t* const vecTmp,
+										int_t dim0						/**< dimension of symmetric matrix */
+										);
+
 
 return_t multiplyInvBlockDiagMatrixVector(	qpData_t* const qpData,
 											vector_t* const res,
@@ -363,7 +392,7 @@ real_t multiplyVectorMatrixVectorDense(	const real_t* const M,
 
 
 return_t multiplyMatrixVectorSparse(	real_t* const res,
-										const real_t* const M,
+										const sparseStorage_t* const M,
 										const real_t* const x,
 										int_t dim0,
 										int_t dim1 	);
@@ -388,11 +417,10 @@ return_t multiplyMatrixTVectorDense(	real_t* const res,
 										int_t dim1		);
 
 
-/** Sparse generic transposed matrix-vector product res = M.T*x */
+/** Sparse generic transposed matrix-vector product res = M.T*x; dim1 is the number of columns of M */
 return_t multiplyMatrixTVectorSparse(	real_t* const res,
-										const real_t* const M,
+										const sparseStorage_t* const M,
 										const real_t* const x,
-										int_t dim0,
 										int_t dim1		);
 
 
@@ -439,6 +467,12 @@ real_t scalarProd(	const vector_t* const x,
 					int_t len 	);
 
 
+/** Fixed-order pairwise sum of partial results, overwrites them */
+real_t treeSum(	real_t* const partial,
+				int_t n
+				);
+
+
 return_t addVectors(	vector_t* const res,
 						const vector_t* const x,
 						const vector_t* const y,
@@ -529,7 +563,8 @@ return_t backsolveRT_ZTET(	qpData_t* const qpData,
 							const zz_matrix_t* const ZT,
 							x_vector_t* const sums,
 							int_t dim0,						/* number of physical rows and columns in  RT (storage) = number of columns in ZT */
-							int_t dim1						/* number of defined rows in ZT = number of defined rows and columns in RT */
+							int_t dim1,						/* number of defined rows in ZT = number of defined rows and columns in RT */
+							int_t dim2						/* number of states of the stage */
 							);
 
 return_t backsolveRT_ZTCT(	qpData_t* const qpData,
@@ -538,7 +573,8 @@ return_t backsolveRT_ZTCT(	qpData_t* const qpData,
 							const zz_matrix_t* const ZTCT,
 							x_vector_t* const sums,
 							int_t dim0,						/* number of physical rows and columns in RT (storage) */
-							int_t dim1						/* number of (well-defined) rows in ZTCT (same as ZT) */
+							int_t dim1,						/* number of (well-defined) rows in ZTCT (same as ZT) */
+							int_t dim2						/* number of columns in ZTCT = number of rows of C */
 							);
 
 
@@ -552,9 +588,20 @@ return_t addCInvHCT(	qpData_t* const qpData,
 /*						xz_matrix_t* const C,*/			/**< temporary matrix to build up C as once */
 						xx_matrix_t* const xxMatTmp,
 						ux_matrix_t* const uxMatTmp,
-						zx_matrix_t* const zxMatTmp
+						zx_matrix_t* const zxMatTmp,
+						const int_t nXK1,
+						const int_t nV
 						);
 
+return_t addCInvHCTStructured(	qpData_t* const qpData,
+								xx_matrix_t* const res,
+								const vv_matrix_t* const cholH,
+								const xz_matrix_t* const C,
+								const d2_vector_t* const y,
+								const int_t nXK1,
+								const int_t nV
+								);
+
 
 return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 											matrix_t* const res,
@@ -567,6 +614,15 @@ return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 											int_t dim1
 											);
 
+return_t addMultiplyMatrixInvMatrixMatrixTSparse(	qpData_t* const qpData,
+													matrix_t* const res,
+													const matrix_t* const cholM1,
+													const sparseStorage_t* const M2,
+													const real_t* const y,			/**< vector containing non-zeros for columns of M2 to be eliminated */
+													int_t dim0,						/**< dimensions of M2 */
+													int_t dim1
+													);
+
 
 
 #endif	/* QP42_MATRIX_VECTOR_H */
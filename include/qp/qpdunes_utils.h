@@ -86,6 +86,12 @@ void* qpDUNES_calloc(size_t num, size_t size);
 void qpDUNES_intFree(	int_t** data
 					);
 
+void qpDUNES_uintFree(	uint_t** data
+					);
+
+void qpDUNES_facFree(	facReal_t** data
+					);
+
 
 
 /**
@@ -121,10 +127,47 @@ const real_t* offsetArray(	const real_t* const data,
 							);*/
 sparsityType_t qpDUNES_detectMatrixSparsity(	const real_t* const M,
 											int_t nRows,
-											int_t nCols
+											int_t nCols,
+											real_t zeroTolerance,		/**< magnitude below which off-diagonal entries are ignored for the diagonal check */
+											real_t densityThreshold		/**< fraction of nonzeros below which a non-diagonal matrix is classified sparse */
 											);
 
 
+/** 
+ *	\brief classify the exact zero structure of a square matrix block
+ *
+ *	Detects integrator chains, block-diagonal and banded blocks of the
+ *	leading dim x dim block of row-major M with leading dimension ldM.
+ */
+return_t qpDUNES_detectMatrixStructure(	matrixStructure_t* const S,
+										const real_t* const M,
+										int_t dim,
+										int_t ldM
+										);
+
+
+/** 
+ *	\brief column range [jBegin, jEnd) of row i that may hold nonzeros
+ */
+void qpDUNES_getStructureRowRange(	const matrixStructure_t* const S,
+									int_t i,
+									int_t dim,
+									int_t* const jBegin,
+									int_t* const jEnd
+									);
+
+
+/** 
+ *	\brief row range [iBegin, iEnd) of column j that may hold nonzeros
+ */
+void qpDUNES_getStructureColumnRange(	const matrixStructure_t* const S,
+										int_t j,
+										int_t dim,
+										int_t* const iBegin,
+										int_t* const iEnd
+										);
+
+
 /** 
  *	\brief ...
  *
@@ -137,10 +180,43 @@ sparsityType_t qpDUNES_detectMatrixSparsity(	const real_t* const M,
 return_t qpDUNES_updateMatrixData(	matrix_t* const to,
 								const real_t* const from,
 								int_t nRows,
+								int_t nCols,
+								storageOrder_t storageOrder
+								);
+
+
+/** 
+ *	\brief rebuild compressed sparse column storage from dense data
+ *
+ *	No-op unless M is QPDUNES_SPARSE; storage grows as needed.
+ */
+return_t qpDUNES_updateSparseStorage(	matrix_t* const M,
+										int_t nRows,
+										int_t nCols
+										);
+
+
+/** 
+ *	\brief scale rows and columns of a matrix in place, M = diag(r)*M*diag(c)
+ *
+ *	Null factors count as ones. An identity matrix becomes diagonal,
+ *	so r and c have to coincide in length for square matrices.
+ */
+return_t qpDUNES_scaleMatrix(	matrix_t* const M,
+								const real_t* const rowFactors,
+								const real_t* const colFactors,
+								int_t nRows,
 								int_t nCols
 								);
 
 
+/** 
+ *	\brief free compressed sparse column storage of M
+ */
+void qpDUNES_freeSparseStorage(	matrix_t* const M
+								);
+
+
 /** 
  *	\brief ...
  *
@@ -261,11 +337,12 @@ return_t qpDUNES_updateVector(	vector_t* const to,
  *	\version 1.0beta
  *	\date 2012
  */
-return_t qpDUNES_updateSimpleBoundVector(	qpData_t* qpData,
-										vector_t* const to,
+return_t qpDUNES_updateSimpleBoundVector(	vector_t* const to,
 										const real_t* const dBnd,
 										const real_t* const xBnd,
-										const real_t* const uBnd
+										const real_t* const uBnd,
+										uint_t nX,
+										uint_t nU
 										);
 
 
@@ -439,6 +516,18 @@ int_t qpDUNES_sign(	const qpData_t* const qpData,
 						);
 
 
+/** population count (number of set bits) routine  */
+uint_t qpDUNES_popcount(	actSetWord_t word
+							);
+
+
+/** status of constraint ii in a packed active set (0 = inactive, 1 = lower, 2 = upper bound active, 3 = soft-penalized)  */
+actSetWord_t qpDUNES_getActSetStatus(	const actSet_t* const actSet,
+										int_t ii,
+										boolean_t fromPrevBits
+										);
+
+
 
 /** 
  *	\brief ...
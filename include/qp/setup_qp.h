@@ -51,10 +51,24 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 						);
 
 
+/* ----------------------------------------------
+ * memory allocation for stage-wise dimensions; nX has nI+1,
+ * nU has nI entries; the last stage has nX[nI] variables
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setupVariableDims(	qpData_t* const qpData,
+									uint_t nI,
+									const uint_t* const nX,
+									const uint_t* const nU,
+									uint_t* nD,
+									qpOptions_t* options
+									);
+
+
 interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
-								uint_t nX,		/* FIXME: just use these temporary, work with nZ later on */
-								uint_t nU,		/* FIXME: just use these temporary, work with nZ later on */
-								uint_t nV,
+								uint_t nX,		/* number of states */
+								uint_t nU,		/* number of controls */
+								uint_t nXK1,	/* number of states of the next stage (rows of C) */
 								uint_t nD
 								);
 
@@ -70,6 +84,9 @@ void qpDUNES_freeInterval(	qpData_t* const qpData,
 void qpDUNES_indicateDataChange(	qpData_t* const qpData
 									);
 
+void qpDUNES_invalidateActSet(	interval_t* const interval
+								);
+
 
 return_t qpDUNES_init(	qpData_t* const qpData,
 						const real_t* const H_,
@@ -83,6 +100,19 @@ return_t qpDUNES_init(	qpData_t* const qpData,
 						const real_t* const dUpp_
 						);
 
+return_t qpDUNES_initWithStorageOrder(	qpData_t* const qpData,
+										const real_t* const H_,
+										const real_t* const g_,
+										const real_t* const C_,
+										const real_t* const c_,
+										const real_t* const zLow_,
+										const real_t* const zUpp_,
+										const real_t* const D_,
+										const real_t* const dLow_,
+										const real_t* const dUpp_,
+										storageOrder_t storageOrder
+										);
+
 
 return_t qpDUNES_updateData(	qpData_t* const qpData,
 								const real_t* const H_,
@@ -96,6 +126,19 @@ return_t qpDUNES_updateData(	qpData_t* const qpData,
 								const real_t* const dUpp_
 								);
 
+return_t qpDUNES_updateDataWithStorageOrder(	qpData_t* const qpData,
+												const real_t* const H_,
+												const real_t* const g_,
+												const real_t* const C_,
+												const real_t* const c_,
+												const real_t* const zLow_,
+												const real_t* const zUpp_,
+												const real_t* const D_,
+												const real_t* const dLow_,
+												const real_t* const dUpp_,
+												storageOrder_t storageOrder
+												);
+
 
 return_t qpDUNES_setupSimpleBoundedInterval(	qpData_t* const qpData,
 											interval_t* interval,
@@ -131,7 +174,8 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 									const real_t* const uUpp_,
 									const real_t* const D_,
 									const real_t* const dLow_,
-									const real_t* const dUpp_
+									const real_t* const dUpp_,
+									storageOrder_t storageOrder
 									);
 
 
@@ -143,7 +187,8 @@ return_t qpDUNES_setupFinalInterval(	qpData_t* const qpData,
 									const real_t* const zUpp_,
 									const real_t* const D_,
 									const real_t* const dLow_,
-									const real_t* const dUpp_
+									const real_t* const dUpp_,
+									storageOrder_t storageOrder
 									);
 
 
@@ -174,10 +219,57 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 										const real_t* const D_,
 										const real_t* const dLow_,
 										const real_t* const dUpp_,
-										vv_matrix_t* const cholH
+										vv_matrix_t* const cholH,
+										storageOrder_t storageOrder
 										);
 
 
+/* ----------------------------------------------
+ * soft variable bounds, penalized by an exact L1 and a quadratic
+ * term per coordinate; only supported by the clipping stage solver
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setSoftBounds(	qpData_t* const qpData,
+								const real_t* const softL1,		/**< linear penalty weights (sum of all nV), may be 0 */
+								const real_t* const softL2		/**< quadratic penalty weights (sum of all nV), may be 0 */
+								);
+
+return_t qpDUNES_setIntervalSoftBounds(	qpData_t* const qpData,
+										interval_t* interval,
+										const real_t* const softL1_,
+										const real_t* const softL2_
+										);
+
+
+/* ----------------------------------------------
+ * optional Ruiz scaling of the stage data, see
+ * qpOptions_t::maxNumScalingIterations
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setupScaling(	qpData_t* const qpData
+								);
+
+return_t qpDUNES_scaleIntervalData(	qpData_t* const qpData,
+									interval_t* interval,
+									const real_t* const H_,
+									const real_t* const g_,
+									const real_t* const C_,
+									const real_t* const c_,
+									const real_t* const zLow_,
+									const real_t* const zUpp_,
+									const real_t* const D_
+									);
+
+void qpDUNES_scaleSoftBounds(	interval_t* const interval,
+								boolean_t undo
+								);
+
+void qpDUNES_scaleLambda(	const qpData_t* const qpData,
+							xn_vector_t* const lambda,
+							boolean_t undo
+							);
+
+
 /* ----------------------------------------------
  * first set up of local QP
  * 
@@ -75,6 +75,26 @@ return_t directQpSolver_doStep( qpData_t* const qpData,
 								real_t* const p				);
 
 
+/** trial point, bound gaps and stage objective for step size alpha */
+return_t clippingQpSolver_evaluateTrialPoint(	qpData_t* const qpData,
+												interval_t* const interval,
+												real_t alpha,
+												z_vector_t* const zTry,
+												d2_vector_t* const mu,
+												real_t* const objVal
+												);
+
+
+/** stage objective at several trial step sizes in one pass */
+return_t clippingQpSolver_evaluateTrialPoints(	qpData_t* const qpData,
+												interval_t* const interval,
+												int_t nAlpha,
+												const real_t* const alphas,
+												real_t* const objVals,
+												real_t* const work
+												);
+
+
 
 /** ... */
 return_t directQpSolver_saturateVector(	qpData_t* const qpData,
@@ -83,10 +103,54 @@ return_t directQpSolver_saturateVector(	qpData_t* const qpData,
 										const d_vector_t* const lb,
 										const d_vector_t* const ub,
 										const zz_matrix_t* const H,
+										const z_vector_t* const softL1,
+										const z_vector_t* const softL2,
 										int_t nD
 										);
 
 
+/** saturation with soft variable bounds (L1 and quadratic penalty) */
+return_t directQpSolver_saturateVectorSoft(	qpData_t* const qpData,
+											d_vector_t* const vec,
+											d2_vector_t* const mu,
+											const d_vector_t* const lb,
+											const d_vector_t* const ub,
+											const zz_matrix_t* const H,
+											const z_vector_t* const softL1,
+											const z_vector_t* const softL2,
+											int_t nV
+											);
+
+
+/** soft bound saturation of a single coordinate */
+void directQpSolver_saturateEntrySoft(	real_t* const z,
+										real_t* const gapLow,
+										real_t* const gapUpp,
+										real_t lb,
+										real_t ub,
+										real_t hii,
+										real_t w1,
+										real_t w2,
+										real_t activenessTolerance
+										);
+
+
+/** penalty of soft bound violations in the current primal solution */
+real_t clippingQpSolver_getSoftPenalty(	const interval_t* const interval
+										);
+
+
+/** diagonal stage Hessian including active quadratic bound penalties */
+vv_matrix_t* clippingQpSolver_getNewtonHessianFactor(	interval_t* const interval
+														);
+
+
+/** ... */
+boolean_t clippingQpSolver_isSoftActive(	const interval_t* const interval,
+											int_t ii
+											);
+
+
 /** ... */
 return_t clippingQpSolver_ratioTest(	qpData_t* const qpData,
 									real_t* minStepSizeASChange,	/* minimum step size that leads to active set change */
@@ -61,6 +61,11 @@
 
 #define PRINTING_PRECISION 14
 
+/** fixed-order tree reductions; leaf sizes only depend on the vector length, never on the number of threads */
+#define QPDUNES_REDUCTION_LEAF_SIZE 64			/* vectors up to this length are summed up sequentially */
+#define QPDUNES_REDUCTION_MAX_LEAVES 256		/* leaves grow for longer vectors */
+#define QPDUNES_REDUCTION_PARALLEL_MIN_LEN 4096	/* shorter vectors are not worth waking up threads */
+
 #ifdef __MATLAB__
 	#define MAX_STR_LEN 2560
 #endif
@@ -101,28 +106,47 @@
 	typedef double real_t;
 #endif	/* __MATLAB__ */
 
+/** precision of the Newton Hessian factor; with mixed precision the
+ *  factorization runs in float and the Newton step is refined in real_t */
+#ifdef __USE_MIXED_PRECISION__
+	typedef float facReal_t;
+#else
+	typedef real_t facReal_t;
+#endif	/* __USE_MIXED_PRECISION__ */
+
 
 #if !defined(__STATIC_MEMORY__)
 	#define _NX_ (qpData->nX)
 	#define _NU_ (qpData->nU)
 	#define _NZ_ (qpData->nZ)
 	#define _NV( I ) (qpData->intervals[ I ]->nV)
-	#define _NI_ (qpData->nI)
+	#define _NX( I ) ((int_t)qpData->intervals[ I ]->nX)	/**< stage dimensions are compared with int_t loop indices */
+	#define _NU( I ) ((int_t)qpData->intervals[ I ]->nU)
+	#define _NI_ ((int_t)qpData->nI)
 	#define _ND( I ) (qpData->intervals[ I ]->nD)
 	#define _NDTTL_ (qpData->nDttl)
+	#define _NXTTL_ ((int_t)qpData->nXttl)
+	#define _XNOFF( K ) ((int_t)qpData->xnOffset[ K ])		/**< offset of lambda_K (size _NX(K+1)) in xn vectors */
+	#define _XN2XOFF( K ) ((int_t)qpData->xn2xOffset[ K ])	/**< offset of block row K in the Newton Hessian */
 #endif
 
 
 
 /** MATRIX ACCESS */
-/*                                                block offset   row offset   column offset (0=diag,-1=supDiag)   column */
-#define accHessian( K, L, I, J )	hessian->data[ (K)*2*_NX_*_NX_  + (I)*2*_NX_   + (1+L)*_NX_                         + (J) ]
-/*                                                        block offset   row offset   column offset (0=diag,-1=supDiag)   column */
-#define accCholHessian( K, L, I, J )	cholHessian->data[ (K)*2*_NX_*_NX_  + (I)*2*_NX_   + (1+L)*_NX_                         + (J) ]
+/*  block row K of the Newton Hessian stores the _NX(K+1) x _NX(K) sub-diagonal block row-wise, followed by the lower
+ *  triangle of the symmetric _NX(K+1) x _NX(K+1) diagonal block, packed row-wise; diagonal blocks are only accessed
+ *  for I >= J, the upper triangle is reached by transposed access */
+/*                                                block offset   row offset (0=diag: packed lower triangle, -1=subDiag)              column */
+#define accHessian( K, L, I, J )	hessian->data[ _XN2XOFF(K)  + ( ((L) == 0) ? _NX((K)+1)*_NX(K) + (I)*((I)+1)/2 : (I)*_NX(K) )  + (J) ]
+/*                                                        block offset   row offset (0=diag: packed lower triangle, -1=subDiag)              column */
+#define accCholHessian( K, L, I, J )	cholHessian->data[ _XN2XOFF(K)  + ( ((L) == 0) ? _NX((K)+1)*_NX(K) + (I)*((I)+1)/2 : (I)*_NX(K) )  + (J) ]
 
 #define accH( I, J )	H->data[ (I)*nV + (J) ]
 
-#define accC( I, J )	C->data[ (I)*_NZ_ + (J) ]
+#define accC( I, J )	C->data[ (I)*nV + (J) ]
+
+/** user input access, respecting the storage order the data was passed in (needs a local storageOrder) */
+#define accInput( M, I, J, NROWS, NCOLS )	( ( storageOrder == QPDUNES_COLUMN_MAJOR ) ? (M)[ (J)*(NROWS) + (I) ] : (M)[ (I)*(NCOLS) + (J) ] )
 
 #define accM( I, J, DIM )	M[ (I)*(DIM) + (J) ]		/**< generic low level matrix access */
 #define accMT( I, J, DIM )	M[ (J)*(DIM) + (I) ]		/**< generic low level transposed matrix access */
@@ -161,6 +185,24 @@ typedef enum
 } sparsityType_t;
 
 
+/** Storage order of user-supplied matrix data */
+typedef enum
+{
+	QPDUNES_ROW_MAJOR = 0,			/**< C-style, rows stored contiguously */
+	QPDUNES_COLUMN_MAJOR			/**< Fortran-style (MATLAB, Eigen default), columns stored contiguously */
+} storageOrder_t;
+
+
+/** Zero structure of the square state block A of a dense constraint matrix C = [A B] */
+typedef enum
+{
+	QPDUNES_STRUCTURE_GENERAL = 0,			/**< no exploitable zero structure */
+	QPDUNES_STRUCTURE_BANDED,				/**< nonzeros only within lowerBw sub- and upperBw super-diagonals */
+	QPDUNES_STRUCTURE_BLOCK_DIAGONAL,		/**< diagonal blocks of size blockSize, last block possibly smaller */
+	QPDUNES_STRUCTURE_INTEGRATOR_CHAIN		/**< unit diagonal plus first super-diagonal */
+} structureType_t;
+
+
 /** Log level */
 typedef enum
 {
@@ -185,7 +227,7 @@ typedef enum
 	QPDUNES_REG_LEVENBERG_MARQUARDT,				/**< 0 = ... */
 	QPDUNES_REG_NORMALIZED_LEVENBERG_MARQUARDT,		/**< 1 = ... */
 	QPDUNES_REG_SINGULAR_DIRECTIONS,				/**< 2 = regularize only in singular directions during Cholesky factorization */
-	QPDUNES_REG_UNCONSTRAINED_HESSIAN,				/**< 3 = ... */
+	QPDUNES_REG_UNCONSTRAINED_HESSIAN,				/**< 3 = replace singular pivots by the curvature of the unconstrained Newton Hessian */
 	QPDUNES_REG_GRADIENT_STEP						/**< 4 = ... */
 } nwtnHssnRegType_t;
 
@@ -194,7 +236,12 @@ typedef enum
 typedef enum
 {
 	QPDUNES_NH_FAC_BAND_FORWARD,		/**< 0 = ... */
-	QPDUNES_NH_FAC_BAND_REVERSE			/**< 1 = ... */
+	QPDUNES_NH_FAC_BAND_REVERSE,		/**< 1 = ... */
+	QPDUNES_NH_PCG_BLOCK_JACOBI,		/**< 2 = matrix-free conjugate gradients, preconditioned with the diagonal blocks only */
+	QPDUNES_NH_FAC_BAND_TWISTED,		/**< 3 = forward from the top and reverse from the bottom, meeting in a twist block;
+											 only the window of stages with active set changes is refactorized */
+	QPDUNES_NH_FAC_BAND_AUTO			/**< 4 = twisted, with the twist placed by statistics of past active set changes;
+											 twist 0 is the reverse, twist nI-1 the forward factorization */
 } nwtnHssnFacAlg_t;
 
 
@@ -236,6 +283,38 @@ typedef enum
 
 
 
+/** 
+ *	\brief compressed sparse column storage
+ *
+ *	Nonzeros of column j are val[colPtr[j]] ... val[colPtr[j+1]-1],
+ *	with ascending row indices in rowIdx. Kept alongside the dense
+ *	data array of a QPDUNES_SPARSE matrix.
+ */
+typedef struct
+{
+	int_t nnz;				/**< number of stored nonzeros */
+	int_t nnzMax;			/**< allocated length of rowIdx and val */
+	int_t* colPtr;			/**< column start offsets, nCols+1 entries */
+	int_t* rowIdx;			/**< row index of each nonzero */
+	real_t* val;			/**< nonzero values, column by column */
+} sparseStorage_t;
+
+
+/** 
+ *	\brief zero structure of a square matrix block
+ *
+ *	Only exact zeros are considered structural, so kernels skipping
+ *	them reproduce the dense results.
+ */
+typedef struct
+{
+	structureType_t type;
+	int_t lowerBw;			/**< number of nonzero sub-diagonals */
+	int_t upperBw;			/**< number of nonzero super-diagonals */
+	int_t blockSize;		/**< size of diagonal blocks (block-diagonal only) */
+} matrixStructure_t;
+
+
 /** 
  *	\brief generic matrix data type
  *
@@ -254,6 +333,12 @@ typedef struct
 
 	/** matrix data array */
 	real_t* data;
+
+	/** compressed column copy of data; only valid for QPDUNES_SPARSE */
+	sparseStorage_t sparse;
+
+	/** zero structure of leading square block; only exploited for QPDUNES_DENSE constraint matrices */
+	matrixStructure_t structure;
 } matrix_t;
 
 typedef matrix_t xx_matrix_t;
@@ -286,6 +371,14 @@ typedef matrix_t dz_matrix_t;
  */
 typedef matrix_t xn2x_matrix_t;
 
+/** Newton Hessian factor in xn2x storage format and factorization precision */
+typedef struct
+{
+	sparsityType_t sparsityType;
+
+	facReal_t* data;
+} xn2x_factor_t;
+
 typedef matrix_t xnxn_matrix_t;
 
 
@@ -343,6 +436,58 @@ typedef struct
 typedef intVector_t zn_intVector_t;
 
 
+/**
+ *	\brief packed active set data type
+ *
+ *	Stage active set stored as bitset with two bits per constraint:
+ *	00 inactive, 01 lower bound active, 10 upper bound active;
+ *	11 is reserved to mark an invalid (unknown) status.
+ *
+ *	\author Janick Frasch, Hans Joachim Ferreau
+ *	\version 1.0beta
+ *	\date 2012
+ */
+typedef uint_t actSetWord_t;
+
+#define QPDUNES_ACTSET_CONSTR_PER_WORD ( 4 * (int_t)sizeof(actSetWord_t) )
+
+typedef struct
+{
+	int_t nWords;				/**< number of words per bitset */
+
+	actSetWord_t* bits;			/**< active set of current stage QP solution */
+	actSetWord_t* prevBits;		/**< active set the Newton Hessian blocks were last set up for */
+	boolean_t prevBitsAreValid;	/**< whether the Newton Hessian blocks were set up for prevBits with the current data */
+} actSet_t;
+
+
+/**
+ *	\brief bounded cache of the Newton Hessian contributions of one stage
+ *
+ *	Entries are keyed by the stage data version and the packed active set,
+ *	and replaced in least-recently-used order. Each entry holds E P E' and
+ *	C P C' as packed lower triangles, followed by -C P E' (row-major).
+ *
+ *	\author Janick Frasch, Hans Joachim Ferreau
+ *	\version 1.0beta
+ *	\date 2012
+ */
+typedef struct
+{
+	int_t capacity;				/**< maximum number of entries, 0 if the cache is disabled */
+	int_t nEntries;				/**< number of filled entries */
+	int_t entrySize;			/**< number of reals per entry */
+	uint_t clock;				/**< lookup counter, stamps the last use of an entry */
+
+	uint_t* dataVersion;		/**< stage data version of each entry */
+	uint_t* lastUse;			/**< lookup counter at the last use of each entry */
+	actSetWord_t* bits;			/**< active set of each entry (nWords per entry) */
+	real_t* data;				/**< Newton Hessian contributions of each entry (entrySize per entry) */
+
+	real_t* curEntry;			/**< entry of the current active set during Newton Hessian setup, 0 if not cached */
+} projCache_t;
+
+
 
 /**
  *	\brief pointer to qpOASES object for C++ method access
@@ -393,6 +538,7 @@ typedef struct
 	/* workspace */
 	z_vector_t qStep;			/**< step in linear term for line search */
 	real_t pStep;				/**< step in constant term for line search */
+	vv_matrix_t HSoft;			/**< diagonal Hessian plus curvature of active quadratic bound penalties (only with soft bounds) */
 } qpSolverClipping_t;
 
 
@@ -420,6 +566,8 @@ typedef struct
 	/* dimensions */
 	uint_t nD;					/**< number of constraints */
 	uint_t nV;					/**< number of variables */
+	uint_t nX;					/**< number of states */
+	uint_t nU;					/**< number of controls (0 on the last interval) */
 	
 
 	/* primal objective function */
@@ -443,6 +591,9 @@ typedef struct
 	/* constraints */
 	z_vector_t  zLow;			/**< lower variable bound */
 	z_vector_t  zUpp;			/**< upper variable bound */
+	z_vector_t  softL1;			/**< linear penalty weight of soft variable bounds (not allocated if all bounds are hard) */
+	z_vector_t  softL2;			/**< quadratic penalty weight of soft variable bounds (not allocated if all bounds are hard) */
+	z_vector_t  scaling;		/**< primal variable scaling, z = scaling .* zScaled; stage data is stored scaled (not allocated if scaling is off) */
 	dz_matrix_t D;				/**< full constraint matrix */
 	d_vector_t  dLow;			/**< constraint lower bound */
 	d_vector_t  dUpp;			/**< constraint upper bound */
@@ -463,8 +614,15 @@ typedef struct
 	qpSolverClipping_t qpSolverClipping;	/**< workspace for clipping QP solver */
 	qpSolverQpoases_t qpSolverQpoases;		/**< pointer to qpOASES object */
 	
+	actSet_t actSet;						/**< packed active set of stage QP */
+	projCache_t projCache;					/**< cached Newton Hessian contributions of previous active sets */
+	uint_t dataVersion;						/**< incremented on every change of the stage data entering the Newton Hessian */
 	boolean_t actSetHasChanged;				/**< indicator flag whether an active set change occurred on this
 										     	 interval during the current iteration */
+	boolean_t isPrepared;					/**< indicator flag whether the initial stage QP step since the last stage QP
+												 setup was already done (in qpDUNES_prepare or qpDUNES_solve) */
+	boolean_t lambdaHasChanged;				/**< indicator flag whether the current Newton step changes a multiplier
+												 coupling to this interval; stage QP work is skipped otherwise */
 
 
 	/* workspace */
@@ -524,12 +682,36 @@ typedef struct
 											 steps with line search can be used to drive the method
 											 faster to the solution */
 	boolean_t checkForInfeasibility;	/**< perform checks for infeasibility of the problem */
+	real_t matrixZeroTolerance;			/**< entries below this magnitude are ignored when detecting diagonal matrices */
+	real_t sparseDensityThreshold;		/**< constraint matrices C, D with a nonzero fraction below this value are
+											 stored and multiplied in compressed sparse form; 0 disables */
+	int_t maxNumScalingIterations;		/**< number of Ruiz equilibration sweeps over the stage data in
+											 qpDUNES_init; 0 disables scaling */
 
 	/* regularization options */
 	nwtnHssnRegType_t regType;
-	real_t regParam;					/**< Levenberg-Marquardt relaxation parameter */
+	real_t regParam;					/**< Levenberg-Marquardt relaxation parameter (initial value, adapted during the iterations) */
+	real_t regParamMin;					/**< lower limit of the adapted Levenberg-Marquardt parameter */
+	real_t regParamMax;					/**< largest shift tried on a single Newton Hessian block before giving up */
+	real_t regParamAdaptationFactor;	/**< Levenberg-Marquardt parameter is divided or multiplied by this factor after good or
+											 poor regularized steps, and shifts of broken down blocks grow by it; 1 keeps it fixed */
 	
 	nwtnHssnFacAlg_t nwtnHssnFacAlg;
+	int_t maxNumNewtonRefinementIterations;	/**< iterative refinement steps on the Newton step, driven by the residual
+												 of the real_t Newton Hessian; needed with a mixed precision factor */
+	int_t maxNumNewtonCGIterations;		/**< iteration limit of the matrix-free conjugate gradient Newton solver */
+	real_t nwtnCGForcingTolerance;		/**< largest relative residual accepted from the conjugate gradient Newton solver
+											 (inexact Newton forcing term); tightened to |gradient| close to the solution */
+	int_t maxNumNewtonBlockUpdates;		/**< Newton Hessian blocks of clipping stages are updated by rank-one terms of the
+											 flipped bounds; a diagonal block is rebuilt from scratch after this many
+											 updates; 0 (default) always rebuilds. Updated blocks differ from rebuilt
+											 ones by accumulated rounding (about 1e-15 relative per update), which can
+											 change iterates and line search iterations slightly */
+	int_t projCacheSize;				/**< entries of the per-stage cache of Newton Hessian contributions of clipping stages
+											 with diagonal Hessian, keyed by data version and active set; 0 disables the cache */
+	real_t lambdaChangeTolerance;		/**< blocks of the Newton step below this fraction of its largest entry are dropped and
+											 the adjacent clipping stage QPs are not re-solved; 0 (default) only skips stages
+											 whose multipliers do not change at all, which leaves the iterates unchanged */
 
 	/* line search options */
 	lineSearchType_t lsType;
@@ -580,7 +762,6 @@ typedef struct
 	#endif
 
 	int_t** ieqStatus;
-	int_t** prevIeqStatus;
 
 	/* timings */
 	real_t tIt;
@@ -638,6 +819,9 @@ typedef struct
 
 	int_t numIter;
 
+	uint_t numProjCacheHits;		/**< stage projections taken from the cache, accumulated since setup */
+	uint_t numProjCacheMisses;		/**< stage projections computed and inserted into the cache */
+
 } log_t;
 
 
@@ -655,10 +839,14 @@ typedef struct
 {
 	/* variables */
 	uint_t nI;
-	uint_t nX;
-	uint_t nU;
-	uint_t nZ;
+	uint_t nX;					/**< maximum number of states over all stages */
+	uint_t nU;					/**< maximum number of controls over all stages */
+	uint_t nZ;					/**< maximum number of stage variables */
 	uint_t nDttl;				/**< total number of local constraints */
+	uint_t nXttl;				/**< total number of coupling multipliers */
+	boolean_t hasUniformDims;	/**< indicator flag whether all stages share nX and nU */
+	uint_t* xnOffset;			/**< offsets of the multiplier blocks in xn vectors (nI+1 entries) */
+	uint_t* xn2xOffset;			/**< offsets of the block rows of the Newton Hessian (nI+1 entries) */
 
 	interval_t** intervals;		/**< array of pointers to interval structs; double pointer for more efficient shifting */
 
@@ -666,8 +854,25 @@ typedef struct
 	xn_vector_t deltaLambda;
 	
 	xn2x_matrix_t hessian;
-	xn2x_matrix_t cholHessian;
+	xn2x_factor_t cholHessian;
 	xn_vector_t gradient;
+	xn_vector_t lsGradient;				/**< gradient at the step accepted by the line search, see lsGradientIsValid */
+	real_t* regShift;					/**< Levenberg-Marquardt shift contained in each diagonal Newton Hessian block (nI entries) */
+	real_t regParam;					/**< current regularization parameter (Levenberg-Marquardt shift or pivot bound) */
+	xn_vector_t regDirections;			/**< pivot modifications delta of the Newton Hessian factor, L*L' = H + diag(delta) */
+	int_t nwtnFacTwistIdx;				/**< twist block of the twisted Newton Hessian factorization; block columns above
+											 hold the forward, block columns below the reverse factor */
+	real_t* nwtnFacFirstChangeFreq;		/**< decayed frequency of each block column being the first one to refactorize (nI entries) */
+	real_t* nwtnFacLastChangeFreq;		/**< decayed frequency of each block column being the last one to refactorize (nI entries) */
+	int_t* nwtnBlockUpdateCount;		/**< incremental updates of each diagonal Newton Hessian block since its last rebuild (nI entries) */
+	real_t* stageReductionTmp;			/**< per-stage partial results of reductions over the horizon (nI+1 entries) */
+	int_t lsGridSize;					/**< number of grid points evaluated in one sweep over the horizon */
+	real_t* lsGridAlpha;				/**< step sizes of the current grid sweep (lsGridSize entries) */
+	real_t* lsGridObjVal;				/**< objective values of the current grid sweep (lsGridSize entries) */
+	real_t* lsGridStageObjVal;			/**< stage objective values of the grid sweep, grid point major (lsGridSize*(nI+1) entries) */
+	real_t* lsGridTmp;					/**< stage-wise accumulators of the grid sweep (4*lsGridSize*(nI+1) entries) */
+	boolean_t lsGradientIsValid;		/**< indicator flag whether the line search left the gradient at the
+											 accepted step in lsGradient */
 	
 
 	real_t alpha;
@@ -682,6 +887,10 @@ typedef struct
 	z_vector_t zVecTmp;			/**<  */
 	xn_vector_t xnVecTmp;		/**<  */
 	xn_vector_t xnVecTmp2;		/**<  */
+	xn_vector_t xnVecTmp3;		/**< Newton step refinement: residual */
+	xn_vector_t xnVecTmp4;		/**< Newton step refinement: preconditioned residual */
+	xn_vector_t xnVecTmp5;		/**< Newton step refinement: search direction */
+	xn_vector_t xnVecTmp6;		/**< Newton step refinement: Newton Hessian times search direction */
 	
 	xx_matrix_t xxMatTmp;		/**<  */
 	xx_matrix_t xxMatTmp2;		/**<  */
@@ -42,42 +42,129 @@ extern "C" {
 #include "matrix.h"
 #include "string.h"
 
+#include <vector>
 
-/* global pointer to MPC object */
-static mpcProblem_t* mpcProblemGlobal = 0;
+
+/* table of MPC objects, addressed by integer handles 1,2,...;
+ * actions called without a handle work on the default object */
+static std::vector<mpcProblem_t*> mpcProblemTable;
+static uint_t mpcProblemDefaultHandle = 0;
+
+
+
+/*
+ *	m p c D U N E S _ d e l e t e I n s t a n c e M a t l a b
+ */
+static void mpcDUNES_deleteInstanceMatlab(	uint_t handle
+											)
+{
+	if ( ( handle > 0 ) && ( handle <= mpcProblemTable.size() ) && ( mpcProblemTable[handle-1] != 0 ) ) {
+		mpcDUNES_cleanup( mpcProblemTable[handle-1] );
+		delete mpcProblemTable[handle-1];
+		mpcProblemTable[handle-1] = 0;
+	}
+	if ( handle == mpcProblemDefaultHandle ) {
+		mpcProblemDefaultHandle = 0;
+	}
+}
+/*<<< END OF mpcDUNES_deleteInstanceMatlab */
 
 
 
 /*
  *	m p c D U N E S _ s a f e C l e a n u p M a t l a b
  */
-//static void mpcDUNES_safeCleanupMatlab( mpcProblem_t** mpcProblemPtr
 static void mpcDUNES_safeCleanupMatlab(
 										 )
 {
-	if (mpcProblemGlobal != 0) {
-		mpcDUNES_cleanup( mpcProblemGlobal );
-		delete mpcProblemGlobal;
-		mpcProblemGlobal = 0;
+	for ( uint_t ii=1; ii<=mpcProblemTable.size(); ++ii ) {
+		mpcDUNES_deleteInstanceMatlab( ii );
 	}
+	mpcProblemTable.clear();
 }
 /*<<< END OF mpcDUNES_cleanupMatlab */
 
 
 
+/*
+ *	m p c D U N E S _ r e g i s t e r I n s t a n c e M a t l a b
+ *	enters a completely set up object into the table; nlhs == 0 replaces
+ *	the default object, otherwise its handle is returned in plhs[0]
+ */
+static void mpcDUNES_registerInstanceMatlab(	mpcProblem_t* const mpcProblem,
+														int nlhs,
+														mxArray* plhs[]
+														)
+{
+	uint_t handle = 0;
+
+	if ( nlhs == 0 ) {
+		mpcDUNES_deleteInstanceMatlab( mpcProblemDefaultHandle );
+	}
+
+	/* reuse a free slot if possible, so that handles stay small */
+	for ( uint_t ii=0; ii<mpcProblemTable.size(); ++ii ) {
+		if ( mpcProblemTable[ii] == 0 ) {
+			handle = ii+1;
+			break;
+		}
+	}
+	if ( handle == 0 ) {
+		mpcProblemTable.push_back( 0 );
+		handle = mpcProblemTable.size();
+	}
+	mpcProblemTable[handle-1] = mpcProblem;
+
+	if ( nlhs == 0 ) {
+		mpcProblemDefaultHandle = handle;
+	}
+	else {
+		plhs[0] = createHandleMatlab( handle );
+	}
+}
+/*<<< END OF mpcDUNES_registerInstanceMatlab */
+
+
+
+/*
+ *	m p c D U N E S _ g e t I n s t a n c e M a t l a b
+ *	handlePtr == 0 selects the default object
+ */
+static mpcProblem_t* mpcDUNES_getInstanceMatlab(	const mxArray* const handlePtr,
+													const char* const action
+													)
+{
+	uint_t handle = ( handlePtr != 0 ) ? getHandleMatlab( handlePtr ) : mpcProblemDefaultHandle;
+
+	if ( ( handle == 0 ) || ( handle > mpcProblemTable.size() ) || ( mpcProblemTable[handle-1] == 0 ) ) {
+		if ( handlePtr != 0 ) {
+			mexPrintf( "ERROR (qpDUNES): Invalid handle for action '%s'.\n", action );
+			mexErrMsgTxt( "ERROR (qpDUNES): Handle does not refer to an initialized MPC problem.\n                 Type 'help mpcDUNES' for further information." );
+		}
+		else {
+			mexPrintf( "ERROR (qpDUNES): QP data needs to be initialized before action '%s' can be performed.\n", action );
+			mexErrMsgTxt( "ERROR (qpDUNES): No MPC problem initialized.\n                 Type 'help mpcDUNES' for further information." );
+		}
+	}
+
+	return mpcProblemTable[handle-1];
+}
+/*<<< END OF mpcDUNES_getInstanceMatlab */
+
+
+
 /*
  *	m p c D U N E S _ s e t u p M a t l a b
+ *	options are read before allocating, since reading errors leave the MEX function
  */
-void mpcDUNES_setupMatlab( mpcProblem_t** mpcProblemPtr,
-						  uint_t nI,
-						  uint_t nX,
-						  uint_t nU,
-						  uint_t* nD,
-						  const mxArray* const optionsPtr
-						  )
+mpcProblem_t* mpcDUNES_setupMatlab(	uint_t nI,
+									uint_t nX,
+									uint_t nU,
+									uint_t* nD,
+									const mxArray* const optionsPtr
+									)
 {
-	mpcDUNES_safeCleanupMatlab( );
-	*mpcProblemPtr = new mpcProblem_t;
+	mpcProblem_t* mpcProblem = 0;
 	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
 
 	/* set up user options */
@@ -86,10 +173,13 @@ void mpcDUNES_setupMatlab( mpcProblem_t** mpcProblemPtr,
     }
 
 	/* allocate qpDUNES data */
-	mpcDUNES_setup( *mpcProblemPtr, nI, nX, nU, nD, &(qpOptions) );
+	mpcProblem = new mpcProblem_t;
+	mpcDUNES_setup( mpcProblem, nI, nX, nU, nD, &(qpOptions) );
 
 	/* register mpcDUNES memory for MATLAB-triggered clearing */
 	mexAtExit(mpcDUNES_safeCleanupMatlab);
+
+	return mpcProblem;
 }
 /*<<< END OF mpcDUNES_setupMatlab */
 
@@ -97,11 +187,13 @@ void mpcDUNES_setupMatlab( mpcProblem_t** mpcProblemPtr,
 /*
  *	i n i t X U S t y l e
  */
-void initXUStyle( int nrhs, const mxArray* const prhs[] )
+void initXUStyle( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
 {
 	mexPrintf( "setupXUStyle...\n" );
 	/* 0) VARIABLE DECLARATIONS: */
 	return_t statusFlag;
+
+	mpcProblem_t* mpcProblem = 0;
 	/* WARNING! x-u style inputs currently not possible for LTV systems */
 	mexPrintf( "WARNING! x-u style inputs currently not possible for LTV systems.\n" );
 	boolean_t isLTI = QPDUNES_TRUE;
@@ -209,8 +301,14 @@ void initXUStyle( int nrhs, const mxArray* const prhs[] )
 	}
 
 
+	if (!isLTI) {
+		mexErrMsgTxt( "Error (qpDUNES): x-u style inputs currently not possible for LTV systems.\n" );
+	}
+
+
 	/* III) ACTUALLY SET UP QP42 PROBLEM: */
-	mpcDUNES_setupMatlab( &mpcProblemGlobal, nI, nX, nU, nD, optionsPtr );
+	/* mpcProblem only enters the instance table once it is completely set up */
+	mpcProblem = mpcDUNES_setupMatlab( nI, nX, nU, nD, optionsPtr );
 
 	/* transpose matrices (Fortran to C) */
 	/* only for A, B;
@@ -225,7 +323,7 @@ void initXUStyle( int nrhs, const mxArray* const prhs[] )
 
 
 	/* setup Data */
-	if (mpcProblemGlobal->qpData.options.printLevel >= 3) {
+	if (mpcProblem->qpData.options.printLevel >= 3) {
 		if (!isLTI) {
 			mexPrintf( "Detected LTV problem of size [nI = %d, nX = %d, nU = %d]\n", nI, nX, nU );
 		}
@@ -235,16 +333,7 @@ void initXUStyle( int nrhs, const mxArray* const prhs[] )
 	}
 
 	/* depending on given problem data, either setup LTI or LTV problem */
-	if (!isLTI) {
-		mexErrMsgTxt( "Error (qpDUNES): x-u style inputs currently not possible for LTV systems.\n" );
-	}
-	else {
-		statusFlag = mpcDUNES_initLtiSb_xu( mpcProblemGlobal, Q, R, 0, P, A, B, c, xLow, xUpp, uLow, uUpp, xRef, uRef );
-	}
-	if ( statusFlag != QPDUNES_OK ) {
-		mexPrintf( "Problem setup returned error code %d", statusFlag );
-		mexErrMsgTxt( "ERROR (qpDUNES): Problem setup failed!" );
-	}
+	statusFlag = mpcDUNES_initLtiSb_xu( mpcProblem, Q, R, 0, P, A, B, c, xLow, xUpp, uLow, uUpp, xRef, uRef );
 
 
 	/* clean up temporary variables */
@@ -252,6 +341,15 @@ void initXUStyle( int nrhs, const mxArray* const prhs[] )
 	if( A ) delete[] A;
 	if( B ) delete[] B;
 
+	if ( statusFlag != QPDUNES_OK ) {
+		mpcDUNES_cleanup( mpcProblem );
+		delete mpcProblem;
+		mexPrintf( "Problem setup returned error code %d", statusFlag );
+		mexErrMsgTxt( "ERROR (qpDUNES): Problem setup failed!" );
+	}
+
+	mpcDUNES_registerInstanceMatlab( mpcProblem, nlhs, plhs );
+
 //	mexErrMsgTxt( "setupXUStyle done" );
 
 	return;
@@ -262,10 +360,12 @@ void initXUStyle( int nrhs, const mxArray* const prhs[] )
 /*
  *	i n i t Z S t y l e
  */
-void initZStyle( int nrhs, const mxArray* const prhs[] )
+void initZStyle( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
 {
 	/* 0) VARIABLE DECLARATIONS: */
 	return_t statusFlag;
+
+	mpcProblem_t* mpcProblem = 0;
 	boolean_t inputsXuStyle;
 	boolean_t isLTI;
 
@@ -382,8 +482,14 @@ void initZStyle( int nrhs, const mxArray* const prhs[] )
 
 
 
+	if ( isLTI ) {
+		mexErrMsgTxt( "ERROR (qpDUNES): LTI systems so far only supported for x-u style inputs." );
+	}
+
+
 	/* III) ACTUALLY SET UP QP42 PROBLEM: */
-	mpcDUNES_setupMatlab( &mpcProblemGlobal, nI, nX, nU, nD, optionsPtr );
+	/* mpcProblem only enters the instance table once it is completely set up */
+	mpcProblem = mpcDUNES_setupMatlab( nI, nX, nU, nD, optionsPtr );
 
 	/* transpose matrices (Fortran to C) */
 	/* only for C (or A, B);
@@ -418,13 +524,10 @@ void initZStyle( int nrhs, const mxArray* const prhs[] )
 			}
 		}
 	}
-	else {
-		mexErrMsgTxt( "ERROR (qpDUNES): LTI systems so far only supported for x-u style inputs." );
-	}
 
 
 	/* setup Data */
-	if (mpcProblemGlobal->qpData.options.printLevel >= 3) {
+	if (mpcProblem->qpData.options.printLevel >= 3) {
 		if (!isLTI) {
 			mexPrintf( "Detected LTV problem of size [nI = %d, nX = %d, nU = %d]\n", nI, nX, nU );
 		}
@@ -435,22 +538,22 @@ void initZStyle( int nrhs, const mxArray* const prhs[] )
 
 
 	/* depending on given problem data, either setup LTI or LTV problem */
-	if (!isLTI) {
-		statusFlag = mpcDUNES_initLtvSb( mpcProblemGlobal, H, g, C, c, zLow, zUpp, zRef );
-	}
-	else {
-		mexErrMsgTxt( "ERROR (qpDUNES): LTI systems so far only supported for x-u style inputs." );
-	}
-	if ( statusFlag != QPDUNES_OK ) {
-		mexPrintf( "Problem setup returned error code %d", statusFlag );
-		mexErrMsgTxt( "ERROR (qpDUNES): Problem setup failed!" );
-	}
+	statusFlag = mpcDUNES_initLtvSb( mpcProblem, H, g, C, c, zLow, zUpp, zRef );
 
 
 	if( nD ) delete[] nD;
 	if( H ) delete[] H;
 	if( C ) delete[] C;
 
+	if ( statusFlag != QPDUNES_OK ) {
+		mpcDUNES_cleanup( mpcProblem );
+		delete mpcProblem;
+		mexPrintf( "Problem setup returned error code %d", statusFlag );
+		mexErrMsgTxt( "ERROR (qpDUNES): Problem setup failed!" );
+	}
+
+	mpcDUNES_registerInstanceMatlab( mpcProblem, nlhs, plhs );
+
 
 	return;
 }
@@ -478,7 +581,6 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 
 	mxArray* Cptr = 0;
 	real_t* C_F = 0;
-	real_t* C = 0;
 
 	mxArray* cPtr = 0;
 	real_t* c = 0;
@@ -586,16 +688,9 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 
 
 	/* III) ACTUALLY SET UP QP42 PROBLEM: */
-	/* transpose matrices (Fortran to C) */
-	/* only for C, D */
-	if (C_F != 0) {
-		C = new real_t[nI*nX*nZ];
-		for (uint_t kk=0; kk<nI; ++kk) {
-			convertFortranToC( &(C[kk*nX*nZ]), &(C_F[kk*nX*nZ]), nX, nZ );
-		}
-	}
+	/* matrices are passed on in Fortran (column-major) order, no transposition needed */
 	if (D_F != 0) {
-		/* TODO: transpose D */
+		/* TODO: pass on D (column-major) once affine constraints are supported */
 	}
 
 	/* combine H and P (only given if LTV system) */
@@ -617,7 +712,7 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 
 
 	/* print which data fields are updated */
-	if (mpcProblemGlobal->qpData.options.printLevel >= 3) {
+	if (mpcProblem->qpData.options.printLevel >= 3) {
 		mexPrintf( "Detected Data updates for " );
 		mpcProblem->isLTI ?	mexPrintf( "LTI " ) : mexPrintf( "LTV " );
 		mexPrintf( "problem of size [nI = %d, nX = %d, nU = %d]:\n", nI, nX, mpcProblem->qpData.nU );
@@ -636,12 +731,12 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 	if( !mpcProblem->isLTI ) {
 		/* date all intervals up */
 		/* TODO: maybe distinguish also between LTV MPC (matrices only get shifted) and NMPC (all matrices get renewed) */
-		statusFlag = qpDUNES_updateData( &(mpcProblem->qpData), H, g, C, c, zLow, zUpp, 0, 0, 0 );	/* TODO: support general constraints	*/
+		statusFlag = qpDUNES_updateDataWithStorageOrder( &(mpcProblem->qpData), H, g, C_F, c, zLow, zUpp, 0, 0, 0, QPDUNES_COLUMN_MAJOR );	/* TODO: support general constraints	*/
 		if (statusFlag != QPDUNES_OK) {
 			mexErrMsgTxt( "LTV data update failed." );
 			return;
 		}
-		if (mpcProblemGlobal->qpData.options.printLevel >= 3) {
+		if (mpcProblem->qpData.options.printLevel >= 3) {
 			mexPrintf( "Did LTV data update for:\n" );
 			( H_in != 0 ) ? mexPrintf( "H\n" ) : mexPrintf( "" );
 			( P != 0 ) ? mexPrintf( "P\n" ) : mexPrintf( "" );
@@ -657,7 +752,7 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 	else {
 		/* only date objective in last interval up (if given) */
 		/* H, C, c do not need to be updated b/c LTI */
-		statusFlag = qpDUNES_updateIntervalData( &(mpcProblem->qpData), mpcProblem->qpData.intervals[nI], P, g, 0, 0, 0, 0, 0, 0, 0, 0 );
+		statusFlag = qpDUNES_updateIntervalData( &(mpcProblem->qpData), mpcProblem->qpData.intervals[nI], P, g, 0, 0, 0, 0, 0, 0, 0, 0, QPDUNES_COLUMN_MAJOR );
 		if (statusFlag != QPDUNES_OK) {
 			mexErrMsgTxt( "LTI data update failed." );
 			return;
@@ -668,7 +763,7 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 			mexErrMsgTxt( "LTI data update failed." );
 			return;
 		}
-		if (mpcProblemGlobal->qpData.options.printLevel >= 3) {
+		if (mpcProblem->qpData.options.printLevel >= 3) {
 			mexPrintf( "Did LTV data update for:\n" );
 			( P != 0 ) ? mexPrintf( "P\n" ) : mexPrintf( "" );
 			( g != 0 ) ? mexPrintf( "g\n" ) : mexPrintf( "" );
@@ -681,7 +776,6 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 
 
 	if( H ) delete[] H;
-	if( C ) delete[] C;
 	if( D ) delete[] D;
 
 
@@ -694,7 +788,7 @@ void updateZStyle( mpcProblem_t* mpcProblem, int nrhs, const mxArray* const prhs
 /*
  *	s o l v e M a t l a b
  */
-void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
+void solveMatlab( mpcProblem_t* const mpcProblem, int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
 {
 	/* GET INPUTS */
 	mxArray* x0Ptr = (mxArray*)prhs[0];
@@ -703,7 +797,7 @@ void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs
 
 	/* CONSISTENCY CHECKS */
 	/* 1)   Check for proper number of output arguments. */
-	if (mpcProblemGlobal->qpData.options.logLevel == QPDUNES_LOG_ALL_DATA ) {
+	if (mpcProblem->qpData.options.logLevel == QPDUNES_LOG_ALL_DATA ) {
 		if ( nlhs > 5 )	mexErrMsgTxt( "ERROR (qpDUNES): At most five output arguments are allowed: \n       [uOpt, xOpt, status, objVal, log]!" );
 	}
 	else {
@@ -713,21 +807,21 @@ void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs
 
 	/* 2)   Check inputs */
 	if ( x0 != 0 ) {	/* x0 exists */
-		if ( mxGetM( x0Ptr )*mxGetN( x0Ptr ) != mpcProblemGlobal->qpData.nX )	mexErrMsgTxt( "ERROR (qpDUNES): Detected x0, but dimensions are inconsistent." );
+		if ( mxGetM( x0Ptr )*mxGetN( x0Ptr ) != mpcProblem->qpData.nX )	mexErrMsgTxt( "ERROR (qpDUNES): Detected x0, but dimensions are inconsistent." );
 	}
 
 
 	/* ALLOCATE OUTPUTS */
-	allocateOutputsMPC( plhs,nlhs, mpcProblemGlobal->qpData.nI,mpcProblemGlobal->qpData.nX,mpcProblemGlobal->qpData.nU );
+	allocateOutputsMPC( plhs,nlhs, mpcProblem->qpData.nI,mpcProblem->qpData.nX,mpcProblem->qpData.nU );
 
 
 	/* SOLVE QPDUNES PROBLEM: */
-	return_t statusFlag = mpcDUNES_solve( mpcProblemGlobal, x0 );
+	return_t statusFlag = mpcDUNES_solve( mpcProblem, x0 );
 	if ( statusFlag != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) {
 		mexPrintf( "qpDUNES returned flag %d\n", statusFlag );
-		if (mpcProblemGlobal->qpData.options.logLevel == QPDUNES_LOG_ALL_DATA ) {
+		if (mpcProblem->qpData.options.logLevel == QPDUNES_LOG_ALL_DATA ) {
 			if ( nlhs == 5 ) {
-				fullLogging( &(mpcProblemGlobal->qpData), &(plhs[4]) );
+				fullLogging( &(mpcProblem->qpData), &(plhs[4]) );
 			}
 			mexPrintf( "ERROR (qpDUNES): Problem could not be solved!\n" );
 		}
@@ -738,13 +832,13 @@ void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs
 
 
 	/* V) PASS SOLUTION ON TO MATLAB: */
-	obtainOutputsMPC( mpcProblemGlobal, plhs, nlhs );
+	obtainOutputsMPC( mpcProblem, plhs, nlhs );
 
 
 	/* VI) PASS DETAILED LOG INFORMATION ON TO MATLAB: */
-	if (mpcProblemGlobal->qpData.options.logLevel == QPDUNES_LOG_ALL_DATA ) {
+	if (mpcProblem->qpData.options.logLevel == QPDUNES_LOG_ALL_DATA ) {
 		if ( nlhs == 5 ) {
-			fullLogging( &(mpcProblemGlobal->qpData), &(plhs[4]) );
+			fullLogging( &(mpcProblem->qpData), &(plhs[4]) );
 		}
 	}
 
@@ -770,6 +864,8 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 
 	char* typeString = (char*) mxGetPr( prhs[0] );
 
+	mpcProblem_t* mpcProblem = 0;
+
 
 	/* SELECT QPDUNES ACTION TO BE PERFORMED */
 	/* a) initial setup */
@@ -779,19 +875,19 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Init" ) == 0 ) ||
 		 ( strcmp( typeString,"INIT" ) == 0 ) )
 	{
-		if (nlhs > 0) {
+		if (nlhs > 1) {
 			mexErrMsgTxt( "ERROR (qpDUNES): Too many output arguments for action 'init'.\n                 Type 'help mpcDUNES' for further information.");
 		}
 
 		switch ( nrhs-1 ) {
 			case 9:
 			case 10:
-				initZStyle( nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				initZStyle( nlhs, plhs, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
 				break;
 
 			case 13:
 			case 14:
-				initXUStyle( nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				initXUStyle( nlhs, plhs, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
 				break;
 
 			default:
@@ -810,18 +906,24 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Update" ) == 0 ) ||
 		 ( strcmp( typeString,"UPDATE" ) == 0 ) )
 	{
-		if( mpcProblemGlobal == 0 )
-			mexErrMsgTxt( "ERROR (qpDUNES): QP data needs to initialized at least once before action 'update' can be performed.\n                 Type 'help mpcDUNES' for further information." );
-
 		if (nlhs > 0) {
 			mexErrMsgTxt( "ERROR (qpDUNES): Too many output arguments for action 'update'.\n                 Type 'help mpcDUNES' for further information.");
 		}
 
-		if (nrhs-1 != 9) {
-			mexErrMsgTxt( "ERROR (qpDUNES): Wrong number of input arguments for action 'update'.\n                 Type 'help mpcDUNES' for further information.");
-		}
+		switch ( nrhs-1 ) {
+			case 9:
+				mpcProblem = mpcDUNES_getInstanceMatlab( 0, "update" );
+				updateZStyle( mpcProblem, nrhs-1, prhs+1 );
+				break;
 
-		updateZStyle( mpcProblemGlobal, nrhs-1, prhs+1 );
+			case 10:	/* leading handle */
+				mpcProblem = mpcDUNES_getInstanceMatlab( prhs[1], "update" );
+				updateZStyle( mpcProblem, nrhs-2, prhs+2 );
+				break;
+
+			default:
+				mexErrMsgTxt( "ERROR (qpDUNES): Wrong number of input arguments for action 'update'.\n                 Type 'help mpcDUNES' for further information.");
+		}
 
 		return;
 	}
@@ -833,14 +935,18 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Solve" ) == 0 ) ||
 		 ( strcmp( typeString,"SOLVE" ) == 0 ) )
 	{
-		if( mpcProblemGlobal == 0 )
-			mexErrMsgTxt( "ERROR (qpDUNES): QP data needs to initialized before action 'solve' can be performed.\n                 Type 'help mpcDUNES' for further information." );
-
-		if (nrhs > 2) {
+		if (nrhs > 3) {
 			mexErrMsgTxt( "ERROR (qpDUNES): Too many input arguments for action 'solve'.\n                 Type 'help mpcDUNES' for further information.");
 		}
 
-		solveMatlab( nlhs, plhs, nrhs-1, prhs+1 );
+		if (nrhs == 3) {	/* leading handle */
+			mpcProblem = mpcDUNES_getInstanceMatlab( prhs[1], "solve" );
+			solveMatlab( mpcProblem, nlhs, plhs, nrhs-2, prhs+2 );
+		}
+		else {
+			mpcProblem = mpcDUNES_getInstanceMatlab( 0, "solve" );
+			solveMatlab( mpcProblem, nlhs, plhs, nrhs-1, prhs+1 );
+		}
 
 		return;
 	}
@@ -852,8 +958,13 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Cleanup" ) == 0 ) ||
 		 ( strcmp( typeString,"CLEANUP" ) == 0 ) )
 	{
-		mexWarnMsgTxt( "[qpDUNES]: A 'cleanup' is not needed anymore and the command will be deprecated in the future.\n                    Simply do a new 'init', use MATLAB's 'clear mpcDUNES', or exit MATLAB." );
-		/*mpcDUNES_safeCleanupMatlab( &mpcProblemGlobal );*/
+		if (nrhs == 2) {	/* free a single object, addressed by its handle */
+			mpcDUNES_getInstanceMatlab( prhs[1], "cleanup" );	/* validate handle */
+			mpcDUNES_deleteInstanceMatlab( getHandleMatlab( prhs[1] ) );
+		}
+		else {
+			mexWarnMsgTxt( "[qpDUNES]: A 'cleanup' is not needed anymore and the command will be deprecated in the future.\n                    Simply do a new 'init', use MATLAB's 'clear mpcDUNES', or exit MATLAB." );
+		}
 
 		return;
 	}
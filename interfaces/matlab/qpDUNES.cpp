@@ -42,9 +42,32 @@ extern "C" {
 #include "matrix.h"
 #include "string.h"
 
+#include <vector>
 
-/* global pointer to qpDUNES object */
-static qpData_t* qpDataGlobal = 0;
+
+/* table of qpDUNES objects, addressed by integer handles 1,2,...;
+ * actions called without a handle work on the default object */
+static std::vector<qpData_t*> qpDataTable;
+static uint_t qpDataDefaultHandle = 0;
+
+
+
+/*
+ *	q p D U N E S _ d e l e t e I n s t a n c e M a t l a b
+ */
+static void qpDUNES_deleteInstanceMatlab(	uint_t handle
+											)
+{
+	if ( ( handle > 0 ) && ( handle <= qpDataTable.size() ) && ( qpDataTable[handle-1] != 0 ) ) {
+		qpDUNES_cleanup( qpDataTable[handle-1] );
+		delete qpDataTable[handle-1];
+		qpDataTable[handle-1] = 0;
+	}
+	if ( handle == qpDataDefaultHandle ) {
+		qpDataDefaultHandle = 0;
+	}
+}
+/*<<< END OF qpDUNES_deleteInstanceMatlab */
 
 
 
@@ -54,29 +77,94 @@ static qpData_t* qpDataGlobal = 0;
 static void qpDUNES_safeCleanupMatlab(
 										 )
 {
-	if (qpDataGlobal != 0) {
-		qpDUNES_cleanup( qpDataGlobal );
-		delete qpDataGlobal;
-		qpDataGlobal = 0;
+	for ( uint_t ii=1; ii<=qpDataTable.size(); ++ii ) {
+		qpDUNES_deleteInstanceMatlab( ii );
 	}
+	qpDataTable.clear();
 }
 /*<<< END OF qpDUNES_cleanupMatlab */
 
 
 
+/*
+ *	q p D U N E S _ r e g i s t e r I n s t a n c e M a t l a b
+ *	enters a completely set up object into the table; nlhs == 0 replaces
+ *	the default object, otherwise its handle is returned in plhs[0]
+ */
+static void qpDUNES_registerInstanceMatlab(	qpData_t* const qpData,
+													int nlhs,
+													mxArray* plhs[]
+													)
+{
+	uint_t handle = 0;
+
+	if ( nlhs == 0 ) {
+		qpDUNES_deleteInstanceMatlab( qpDataDefaultHandle );
+	}
+
+	/* reuse a free slot if possible, so that handles stay small */
+	for ( uint_t ii=0; ii<qpDataTable.size(); ++ii ) {
+		if ( qpDataTable[ii] == 0 ) {
+			handle = ii+1;
+			break;
+		}
+	}
+	if ( handle == 0 ) {
+		qpDataTable.push_back( 0 );
+		handle = qpDataTable.size();
+	}
+	qpDataTable[handle-1] = qpData;
+
+	if ( nlhs == 0 ) {
+		qpDataDefaultHandle = handle;
+	}
+	else {
+		plhs[0] = createHandleMatlab( handle );
+	}
+}
+/*<<< END OF qpDUNES_registerInstanceMatlab */
+
+
+
+/*
+ *	q p D U N E S _ g e t I n s t a n c e M a t l a b
+ *	handlePtr == 0 selects the default object
+ */
+static qpData_t* qpDUNES_getInstanceMatlab(	const mxArray* const handlePtr,
+												const char* const action
+												)
+{
+	uint_t handle = ( handlePtr != 0 ) ? getHandleMatlab( handlePtr ) : qpDataDefaultHandle;
+
+	if ( ( handle == 0 ) || ( handle > qpDataTable.size() ) || ( qpDataTable[handle-1] == 0 ) ) {
+		if ( handlePtr != 0 ) {
+			mexPrintf( "[qpDUNES] Error: Invalid handle for action '%s'.\n", action );
+			mexErrMsgTxt( "[qpDUNES] Error: Handle does not refer to an initialized QP.\n                 Type 'help qpDUNES' for further information." );
+		}
+		else {
+			mexPrintf( "[qpDUNES] Error: QP data needs to be initialized before action '%s' can be performed.\n", action );
+			mexErrMsgTxt( "[qpDUNES] Error: No QP initialized.\n                 Type 'help qpDUNES' for further information." );
+		}
+	}
+
+	return qpDataTable[handle-1];
+}
+/*<<< END OF qpDUNES_getInstanceMatlab */
+
+
+
 /*
  *	q p D U N E S _ s e t u p M a t l a b
+ *	options are read before allocating, since reading errors leave the MEX function
  */
-void qpDUNES_setupMatlab( qpData_t** qpDataPtr,
-						  uint_t nI,
-						  uint_t nX,
-						  uint_t nU,
-						  uint_t* nD,
-						  const mxArray* const optionsPtr
-						  )
+qpData_t* qpDUNES_setupMatlab(	uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								uint_t* nD,
+								const mxArray* const optionsPtr
+								)
 {
-	qpDUNES_safeCleanupMatlab( );
-	*qpDataPtr = new qpData_t;
+	qpData_t* qpData = 0;
 	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
 
 	/* set up user options */
@@ -85,10 +173,13 @@ void qpDUNES_setupMatlab( qpData_t** qpDataPtr,
     }
 
 	/* allocate qpDUNES data */
-	qpDUNES_setup( *qpDataPtr, nI, nX, nU, nD, &(qpOptions) );
+	qpData = new qpData_t;
+	qpDUNES_setup( qpData, nI, nX, nU, nD, &(qpOptions) );
 
 	/* register qpDUNES memory for MATLAB-triggered clearing */
 	mexAtExit(qpDUNES_safeCleanupMatlab);
+
+	return qpData;
 }
 /*<<< END OF qpDUNES_setupMatlab */
 
@@ -97,11 +188,13 @@ void qpDUNES_setupMatlab( qpData_t** qpDataPtr,
 /*
  *	i n i t Q P
  */
-void initQP( int nrhs, const mxArray* const prhs[] )
+void initQP( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
 {
 	/* 0) VARIABLE DECLARATIONS: */
 	return_t statusFlag;
 
+	qpData_t* qpData = 0;
+
 	mxArray* nIuserPtr = 0;
 	real_t* nIuser = 0;
 
@@ -298,21 +391,12 @@ void initQP( int nrhs, const mxArray* const prhs[] )
 
 
 	/* III) ACTUALLY SET UP QP42 PROBLEM: */
-	qpDUNES_setupMatlab( &qpDataGlobal, nI, nX, nU, nD, optionsPtr );
+	/* qpData only enters the instance table once it is completely set up */
+	qpData = qpDUNES_setupMatlab( nI, nX, nU, nD, optionsPtr );
 
-	/* transpose matrices (Fortran to C) */
-	/* for C;
-	 * H and P should be symmetric
-	 */
-	real_t* C = 0;
-	C = new real_t[nI*nX*nZ];
-	for (uint_t kk=0; kk<nI; ++kk) {
-		convertFortranToC( &(C[kk*nX*nZ]), &(C_F[kk*nX*nZ]), nX, nZ );
-	}
+	/* matrices are passed on in Fortran (column-major) order, no transposition needed */
 	/* for D */
 	real_t* D = 0;
-	/*D = new real_t[nDttl];
-	convertFortranToC( D, D_F, nDttl, nZ );*/
 
 
 	/* combine H and P */
@@ -333,25 +417,30 @@ void initQP( int nrhs, const mxArray* const prhs[] )
 
 
 	/* setup Data */
-	if (qpDataGlobal->options.printLevel >= 3) {
+	if (qpData->options.printLevel >= 3) {
 		mexPrintf( "Received QP problem of size [nI = %d, nX = %d, nU = %d]\n", nI, nX, nU );
 	}
 
 
 	/* set up a QP problem */
-	statusFlag = qpDUNES_init( qpDataGlobal, H, g, C, c, zLow,zUpp, D, dLow, dUpp );
-	if ( statusFlag != QPDUNES_OK ) {
-		mexPrintf( "Problem setup returned error code %d", statusFlag );
-		mexErrMsgTxt( "[qpDUNES] Error: Problem setup failed!" );
-	}
+	statusFlag = qpDUNES_initWithStorageOrder( qpData, H, g, C_F, c, zLow,zUpp, D, dLow, dUpp, QPDUNES_COLUMN_MAJOR );
 
 
 	if( nD ) delete[] nD;
 	if( H ) delete[] H;
-	if( C ) delete[] C;
 	if( D ) delete[] D;
 
 
+	if ( statusFlag != QPDUNES_OK ) {
+		qpDUNES_cleanup( qpData );
+		delete qpData;
+		mexPrintf( "Problem setup returned error code %d", statusFlag );
+		mexErrMsgTxt( "[qpDUNES] Error: Problem setup failed!" );
+	}
+
+	qpDUNES_registerInstanceMatlab( qpData, nlhs, plhs );
+
+
 	return;
 }
 /*<<< END OF initQP */
@@ -474,20 +563,10 @@ void updateAllIntervals( qpData_t* qpData, int nrhs, const mxArray* const prhs[]
 
 
 	/* III) ACTUALLY SET UP QP42 PROBLEM: */
-	/* transpose matrices (Fortran to C) */
-	/* only for C, D
-	 * H should be symmetric
-	*/
-	real_t* C = 0;
-	if (C_F != 0) {
-		C = new real_t[nI*nX*nZ];
-		for (uint_t kk=0; kk<nI; ++kk) {
-			convertFortranToC( &(C[kk*nX*nZ]), &(C_F[kk*nX*nZ]), nX, nZ );
-		}
-	}
+	/* matrices are passed on in Fortran (column-major) order, no transposition needed */
 	real_t* D = 0;
 	if (D_F != 0) {
-		/* TODO: transpose D */
+		/* TODO: pass on D (column-major) once affine constraints are supported */
 	}
 
 	/* combine H and P (only given if LTV system) */
@@ -509,7 +588,7 @@ void updateAllIntervals( qpData_t* qpData, int nrhs, const mxArray* const prhs[]
 	}
 
 
-	statusFlag = qpDUNES_updateData( qpData, H, g, C, c, zLow, zUpp, D, dLow, dUpp );	/* TODO: support general constraints	*/
+	statusFlag = qpDUNES_updateDataWithStorageOrder( qpData, H, g, C_F, c, zLow, zUpp, D, dLow, dUpp, QPDUNES_COLUMN_MAJOR );	/* TODO: support general constraints	*/
 	if (statusFlag != QPDUNES_OK) {
 		mexErrMsgTxt( "QP data update failed." );
 		return;
@@ -533,7 +612,6 @@ void updateAllIntervals( qpData_t* qpData, int nrhs, const mxArray* const prhs[]
 
 
 	if( H ) delete[] H;
-	if( C ) delete[] C;
 	if( D ) delete[] D;
 
 
@@ -668,30 +746,19 @@ void updateSingleInterval( qpData_t* qpData, int nrhs, const mxArray* const prhs
 
 
 	/* III) ACTUALLY SET UP QP42 PROBLEM: */
-	/* transpose matrices (Fortran to C) */
-	/* only for C, D
-	 * H should be symmetric
-	*/
-	real_t* C = 0;
-	if (C_F != 0) {
-		C = new real_t[nI*nX*nZ];
-		for (uint_t kk=0; kk<nI; ++kk) {
-			convertFortranToC( &(C[kk*nX*nZ]), &(C_F[kk*nX*nZ]), nX, nZ );
-		}
-	}
+	/* matrices are passed on in Fortran (column-major) order, no transposition needed */
 	real_t* D = 0;
 	if (D_F != 0) {
-		/* TODO: transpose D */
+		/* TODO: pass on D (column-major) once affine constraints are supported */
 	}
 
 
-	statusFlag = qpDUNES_updateIntervalData( qpData, qpData->intervals[Iidx], H, g, C, c, zLow,zUpp, D,dLow,dUpp, 0 );
+	statusFlag = qpDUNES_updateIntervalData( qpData, qpData->intervals[Iidx], H, g, C_F, c, zLow,zUpp, D,dLow,dUpp, 0, QPDUNES_COLUMN_MAJOR );
 	if (statusFlag != QPDUNES_OK) {
 		mexErrMsgTxt( "QP data update failed." );
 		return;
 	}
 
-	if( C ) delete[] C;
 	if( D ) delete[] D;
 
 	return;
@@ -703,7 +770,7 @@ void updateSingleInterval( qpData_t* qpData, int nrhs, const mxArray* const prhs
 /*
  *	s o l v e M a t l a b
  */
-void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
+void solveMatlab( qpData_t* const qpData, int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs[] )
 {
 	/* GET INPUTS */
 //	mxArray* x0Ptr = (mxArray*)prhs[0];
@@ -712,7 +779,7 @@ void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs
 
 	/* CONSISTENCY CHECKS */
 	/* 1)   Check for proper number of output arguments. */
-	if (qpDataGlobal->options.logLevel == QPDUNES_LOG_ALL_DATA ) {
+	if (qpData->options.logLevel == QPDUNES_LOG_ALL_DATA ) {
 		if ( nlhs > 6 )	mexErrMsgTxt( "[qpDUNES] Error: At most six output arguments are allowed: \n                 [zOpt, status, lambda, mu, objVal, log]!" );
 	}
 	else {
@@ -722,16 +789,16 @@ void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs
 
 
 	/* ALLOCATE OUTPUTS */
-	allocateOutputsQP( plhs,nlhs, qpDataGlobal->nI,qpDataGlobal->nX,qpDataGlobal->nZ );
+	allocateOutputsQP( plhs,nlhs, qpData->nI,qpData->nX,qpData->nZ );
 
 
 	/* SOLVE QP42 PROBLEM: */
-	return_t statusFlag = qpDUNES_solve( qpDataGlobal );
+	return_t statusFlag = qpDUNES_solve( qpData );
 	if ( statusFlag != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) {
 		mexPrintf( "qpDUNES returned flag %d\n", statusFlag );
-		if (qpDataGlobal->options.logLevel == QPDUNES_LOG_ALL_DATA ) {
+		if (qpData->options.logLevel == QPDUNES_LOG_ALL_DATA ) {
 			if ( nlhs == 5 ) {
-				fullLogging( qpDataGlobal, &(plhs[4]) );
+				fullLogging( qpData, &(plhs[4]) );
 			}
 		}
 		mexErrMsgTxt( "[qpDUNES] Error: Problem could not be solved!" );
@@ -739,13 +806,13 @@ void solveMatlab( int nlhs, mxArray* plhs[], int nrhs, const mxArray* const prhs
 
 
 	/* V) PASS SOLUTION ON TO MATLAB: */
-	obtainOutputsQP( qpDataGlobal, plhs, nlhs, statusFlag );
+	obtainOutputsQP( qpData, plhs, nlhs, statusFlag );
 
 
 	/* VI) PASS DETAILED LOG INFORMATION ON TO MATLAB: */
-	if (qpDataGlobal->options.logLevel == QPDUNES_LOG_ALL_DATA ) {
+	if (qpData->options.logLevel == QPDUNES_LOG_ALL_DATA ) {
 		if ( nlhs == 5 ) {
-			fullLogging( qpDataGlobal, &(plhs[4]) );
+			fullLogging( qpData, &(plhs[4]) );
 		}
 	}
 
@@ -771,6 +838,8 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 
 	char* typeString = mxArrayToString( prhs[0] );
 
+	qpData_t* qpData = 0;
+
 
 	/* SELECT QPDUNES ACTION TO BE PERFORMED */
 	/* a) initial setup */
@@ -780,14 +849,14 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Init" ) == 0 ) ||
 		 ( strcmp( typeString,"INIT" ) == 0 ) )
 	{
-		if (nlhs > 0) {
+		if (nlhs > 1) {
 			mexErrMsgTxt( "[qpDUNES] Error: Too many output arguments for action 'init'.\n                 Type 'help qpDUNES' for further information.");
 		}
 
 		switch ( nrhs-1 ) {
 			case 11:
 			case 12:
-				initQP( nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				initQP( nlhs, plhs, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
 				break;
 
 			default:
@@ -807,16 +876,19 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Update" ) == 0 ) ||
 		 ( strcmp( typeString,"UPDATE" ) == 0 ) )
 	{
-		if( qpDataGlobal == 0 )
-			mexErrMsgTxt( "[qpDUNES] Error: QP data needs to initialized at least once before action 'update' can be performed.\n                 Type 'help qpDUNES' for further information." );
-
 		if (nlhs > 0) {
 			mexErrMsgTxt( "[qpDUNES] Error: Too many output arguments for action 'update'.\n                 Type 'help qpDUNES' for further information.");
 		}
 
 		switch ( nrhs-1 ) {
 			case 10:
-				updateAllIntervals( qpDataGlobal, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				qpData = qpDUNES_getInstanceMatlab( 0, "update" );
+				updateAllIntervals( qpData, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				break;
+
+			case 11:	/* leading handle */
+				qpData = qpDUNES_getInstanceMatlab( prhs[1], "update" );
+				updateAllIntervals( qpData, nrhs-2, prhs+2 );
 				break;
 
 			default:
@@ -853,16 +925,19 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"StageUpdate" ) == 0 ) ||
 		 ( strcmp( typeString,"STAGEUPDATE" ) == 0 ) )
 	{
-		if( qpDataGlobal == 0 )
-			mexErrMsgTxt( "[qpDUNES] Error: QP data needs to initialized at least once before action 'updateInterval' can be performed.\n                 Type 'help qpDUNES' for further information." );
-
 		if (nlhs > 0) {
 			mexErrMsgTxt( "[qpDUNES] Error: Too many output arguments for action 'updateInterval'.\n                 Type 'help qpDUNES' for further information.");
 		}
 
 		switch ( nrhs-1 ) {
 			case 10:
-				updateSingleInterval( qpDataGlobal, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				qpData = qpDUNES_getInstanceMatlab( 0, "updateInterval" );
+				updateSingleInterval( qpData, nrhs-1, prhs+1 );	/* shift input pointers to begin of data */
+				break;
+
+			case 11:	/* leading handle */
+				qpData = qpDUNES_getInstanceMatlab( prhs[1], "updateInterval" );
+				updateSingleInterval( qpData, nrhs-2, prhs+2 );
 				break;
 
 			default:
@@ -880,14 +955,16 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Solve" ) == 0 ) ||
 		 ( strcmp( typeString,"SOLVE" ) == 0 ) )
 	{
-		if( qpDataGlobal == 0 )
-			mexErrMsgTxt( "[qpDUNES] Error: QP data needs to initialized before action 'solve' can be performed.\n                 Type 'help qpDUNES' for further information." );
-
 		if (nrhs > 2) {
 			mexErrMsgTxt( "[qpDUNES] Error: Too many input arguments for action 'solve'.\n                 Type 'help qpDUNES' for further information.");
 		}
 
-		solveMatlab( nlhs, plhs, nrhs-1, prhs+1 );
+		if ( ( nrhs == 2 ) && ( isHandleMatlab( prhs[1] ) == QPDUNES_FALSE ) ) {
+			mexErrMsgTxt( "[qpDUNES] Error: Second input argument of action 'solve' has to be a handle returned by 'init'.\n                 Type 'help qpDUNES' for further information.");
+		}
+
+		qpData = qpDUNES_getInstanceMatlab( ( nrhs == 2 ) ? prhs[1] : 0, "solve" );
+		solveMatlab( qpData, nlhs, plhs, nrhs-1, prhs+1 );
 
 		return;
 	}
@@ -901,22 +978,53 @@ void mexFunction( int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[] )
 		 ( strcmp( typeString,"Shift" ) == 0 ) ||
 		 ( strcmp( typeString,"SHIFT" ) == 0 ) )
 	{
-		if( qpDataGlobal == 0 )
-			mexErrMsgTxt( "[qpDUNES] Error: QP data needs to initialized before action 'shift' can be performed.\n                 Type 'help qpDUNES' for further information." );
-
 		if (nlhs > 0) {
 			mexErrMsgTxt( "[qpDUNES] Error: Too many output arguments for action 'shift'.\n                 Type 'help qpDUNES' for further information.");
 		}
 
-		if (nrhs-1 > 0) {
+		if (nrhs-1 > 1) {
 			mexErrMsgTxt( "[qpDUNES] Error: Too many input arguments for action 'shift'.\n                 Type 'help qpDUNES' for further information.");
 		}
 
+		if ( ( nrhs == 2 ) && ( isHandleMatlab( prhs[1] ) == QPDUNES_FALSE ) ) {
+			mexErrMsgTxt( "[qpDUNES] Error: Second input argument of action 'shift' has to be a handle returned by 'init'.\n                 Type 'help qpDUNES' for further information.");
+		}
+
+		qpData = qpDUNES_getInstanceMatlab( ( nrhs == 2 ) ? prhs[1] : 0, "shift" );
+
 
 		/* shift to prepare QP for next solution */
-		qpDUNES_shiftLambda( qpDataGlobal );			/* shift multipliers */
-		qpDUNES_shiftIntervals( qpDataGlobal );			/* shift intervals (particulary important when using qpOASES for underlying local QPs) */
+		qpDUNES_shiftLambda( qpData );			/* shift multipliers */
+		qpDUNES_shiftIntervals( qpData );			/* shift intervals (particulary important when using qpOASES for underlying local QPs) */
+
 
+		return;
+	}
+
+
+	/* f) cleanup */
+	if ( ( strcmp( typeString,"c" ) == 0 ) ||
+		 ( strcmp( typeString,"C" ) == 0 ) ||
+		 ( strcmp( typeString,"cleanup" ) == 0 ) ||
+		 ( strcmp( typeString,"Cleanup" ) == 0 ) ||
+		 ( strcmp( typeString,"CLEANUP" ) == 0 ) )
+	{
+		if (nlhs > 0) {
+			mexErrMsgTxt( "[qpDUNES] Error: Too many output arguments for action 'cleanup'.\n                 Type 'help qpDUNES' for further information.");
+		}
+
+		if (nrhs-1 > 1) {
+			mexErrMsgTxt( "[qpDUNES] Error: Too many input arguments for action 'cleanup'.\n                 Type 'help qpDUNES' for further information.");
+		}
+
+		/* free a single object; all objects are freed on 'clear qpDUNES' */
+		if ( nrhs == 2 ) {
+			qpDUNES_getInstanceMatlab( prhs[1], "cleanup" );	/* validate handle */
+			qpDUNES_deleteInstanceMatlab( getHandleMatlab( prhs[1] ) );
+		}
+		else {
+			qpDUNES_deleteInstanceMatlab( qpDataDefaultHandle );
+		}
 
 		return;
 	}
@@ -226,6 +226,49 @@ boolean_t getOptionValue( const mxArray* const optionsPtr, const char* const opt
 }
 
 
+/*
+ *	i s H a n d l e
+ *	instance handles are uint32 scalars, so that they cannot be confused with numerical data
+ */
+boolean_t isHandleMatlab( const mxArray* const handlePtr )
+{
+	if ( ( handlePtr == 0 ) || ( !mxIsUint32( handlePtr ) ) || ( mxGetM( handlePtr )*mxGetN( handlePtr ) != 1 ) ) {
+		return QPDUNES_FALSE;
+	}
+
+	return ( *(unsigned int*)mxGetData( handlePtr ) > 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+}
+
+
+
+/*
+ *	g e t H a n d l e
+ *	read an instance handle; returns 0 if the argument is no valid handle
+ */
+uint_t getHandleMatlab( const mxArray* const handlePtr )
+{
+	if ( isHandleMatlab( handlePtr ) == QPDUNES_FALSE ) {
+		return 0;
+	}
+
+	return (uint_t)( *(unsigned int*)mxGetData( handlePtr ) );
+}
+
+
+
+/*
+ *	c r e a t e H a n d l e
+ */
+mxArray* createHandleMatlab( uint_t handle )
+{
+	mxArray* handlePtr = mxCreateNumericMatrix( 1, 1, mxUINT32_CLASS, mxREAL );
+	*(unsigned int*)mxGetData( handlePtr ) = (unsigned int)handle;
+
+	return handlePtr;
+}
+
+
+
 /*
  *	s e t u p O p t i o n s
  */
@@ -292,6 +335,33 @@ return_t qpDUNES_setupOptionsMatlab( qpOptions_t* options, const mxArray* const
 	if ( getOptionValue( optionsPtr, "regParam", &optionValue ) == QPDUNES_TRUE )
 		options->regParam = (real_t)*optionValue;
 
+	if ( getOptionValue( optionsPtr, "regParamMin", &optionValue ) == QPDUNES_TRUE )
+		options->regParamMin = (real_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "regParamMax", &optionValue ) == QPDUNES_TRUE )
+		options->regParamMax = (real_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "regParamAdaptationFactor", &optionValue ) == QPDUNES_TRUE )
+		options->regParamAdaptationFactor = (real_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "maxNumNewtonRefinementIterations", &optionValue ) == QPDUNES_TRUE )
+		options->maxNumNewtonRefinementIterations = (int_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "maxNumNewtonCGIterations", &optionValue ) == QPDUNES_TRUE )
+		options->maxNumNewtonCGIterations = (int_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "nwtnCGForcingTolerance", &optionValue ) == QPDUNES_TRUE )
+		options->nwtnCGForcingTolerance = (real_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "maxNumNewtonBlockUpdates", &optionValue ) == QPDUNES_TRUE )
+		options->maxNumNewtonBlockUpdates = (int_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "projCacheSize", &optionValue ) == QPDUNES_TRUE )
+		options->projCacheSize = (int_t)*optionValue;
+
+	if ( getOptionValue( optionsPtr, "lambdaChangeTolerance", &optionValue ) == QPDUNES_TRUE )
+		options->lambdaChangeTolerance = (real_t)*optionValue;
+
 
 	/* line search options */
 	if ( getOptionValue( optionsPtr, "lsType", &optionValue ) == QPDUNES_TRUE )
@@ -347,7 +417,7 @@ return_t makeNewtonHessianDense( const qpData_t* const qpData,
 				to[kk*nX*(nI*nX)+ii*(nI*nX)+(kk-1)*nX+jj] = accHessian( kk, -1, ii, jj );
 			}
 			for( jj=0; jj<nX; ++jj ) {						/* diagonal block */
-				to[kk*nX*(nI*nX)+ii*(nI*nX)+kk*nX+jj] = accHessian( kk, 0, ii, jj );
+				to[kk*nX*(nI*nX)+ii*(nI*nX)+kk*nX+jj] = (jj <= ii) ? accHessian( kk, 0, ii, jj ) : accHessian( kk, 0, jj, ii );
 			}
 			for( jj=0; jj<(kk < nI-1 ? 1 : 0)*nX; ++jj ) {  /* superdiagonal block */
 				to[kk*nX*(nI*nX)+ii*(nI*nX)+(kk+1)*nX+jj] = accHessian( kk+1, -1, jj, ii );
@@ -150,6 +150,15 @@ function [ options ] = qpDUNES_default_options( )
                         ... % regularization options
 						'regType', 		0, ...		% LEVENBERG_MARQUARDT
 						'regParam',		1.e-6, ...
+						'regParamMin',	1.e-9, ...
+						'regParamMax',	1.e-1, ...
+						'regParamAdaptationFactor',	10., ...
+						'maxNumNewtonRefinementIterations',	0, ...	% 3 for a mixed precision build
+						'maxNumNewtonCGIterations',	100, ...
+						'nwtnCGForcingTolerance',	1.e-2, ...
+						'maxNumNewtonBlockUpdates',	0, ...
+						'projCacheSize',			0, ...
+						'lambdaChangeTolerance',	0., ...
 						... % line search options
 						'lsType',							4, ...			% ACCELERATED_GRADIENT_BISECTION_LS
 						'lineSearchReductionFactor',		0.3, ...		% needs to be between 0 and 1
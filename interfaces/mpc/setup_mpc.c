@@ -299,7 +299,7 @@ return_t mpcDUNES_initLtiSb_xu(	mpcProblem_t* const mpcProblem,
 												0, Q, R, S, 0,
 												0, A, B, &(cMod[kk*nX]),
 												&(zLowMod[kk*nZ]), &(zUppMod[kk*nZ]), 0,0,0,0,
-												0,0,0 );
+												0,0,0, QPDUNES_ROW_MAJOR );
 		if (statusFlag != QPDUNES_OK) {
 			qpDUNES_printError(qpData, __FILE__, __LINE__, "Setup of interval %d of %d failed. Bailing out.", kk, nI );
 			return statusFlag;
@@ -310,13 +310,13 @@ return_t mpcDUNES_initLtiSb_xu(	mpcProblem_t* const mpcProblem,
 		statusFlag = qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI],
 											  P, 0,
 											  &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]),
-											  0,0,0 );
+											  0,0,0, QPDUNES_ROW_MAJOR );
 	}
 	else {
 		statusFlag = qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI],
 											  Q, 0,
 											  &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]),
-											  0,0,0 );
+											  0,0,0, QPDUNES_ROW_MAJOR );
 	}
 	if (statusFlag != QPDUNES_OK) {
 		qpDUNES_printError(qpData, __FILE__, __LINE__, "Setup of interval %d of %d failed. Bailing out.", nI, nI );
@@ -453,7 +453,7 @@ return_t mpcDUNES_initLtiSb(	mpcProblem_t* const mpcProblem,
 												H_, 0, 0, 0, g_,
 												C_, 0, 0, &(cMod[kk*nX]),
 												&(zLowMod[kk*nZ]), &(zUppMod[kk*nZ]), 0,0,0,0,
-												0, 0,0 );
+												0, 0,0, QPDUNES_ROW_MAJOR );
 		if (statusFlag != QPDUNES_OK) {
 			qpDUNES_printError(qpData, __FILE__, __LINE__, "Setup of interval %d of %d failed. Bailing out.", kk, nI );
 			return statusFlag;
@@ -463,7 +463,7 @@ return_t mpcDUNES_initLtiSb(	mpcProblem_t* const mpcProblem,
 	statusFlag = qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI],
 										  P_, g_,
 										  &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]),
-										  0, 0,0 );
+										  0, 0,0, QPDUNES_ROW_MAJOR );
 	if (statusFlag != QPDUNES_OK) {
 		qpDUNES_printError(qpData, __FILE__, __LINE__, "Setup of interval %d of %d failed. Bailing out.", nI, nI );
 		return statusFlag;
@@ -597,19 +597,19 @@ return_t mpcDUNES_initLtvSb(	mpcProblem_t* const mpcProblem,
 									   &(H_[kk*nZ*nZ]), 0, 0, 0, &(g_[kk*nZ]),
 									   &(C_[kk*nX*nZ]), 0, 0, &(cMod[kk*nX]),
 									   &(zLowMod[kk*nZ]), &(zUppMod[kk*nZ]), 0,0,0,0,
-									   0, 0,0 );
+									   0, 0,0, QPDUNES_ROW_MAJOR );
 		}
 		else {
 			qpDUNES_setupRegularInterval( qpData, qpData->intervals[kk],
 									   &(H_[kk*nZ*nZ]), 0, 0, 0, 0,
 									   &(C_[kk*nX*nZ]), 0, 0, &(cMod[kk*nX]),
 									   &(zLowMod[kk*nZ]), &(zUppMod[kk*nZ]), 0,0,0,0,
-									   0, 0,0 );
+									   0, 0,0, QPDUNES_ROW_MAJOR );
 		}
 	}
 	/** (3b) set up final interval */
-	if (g_ != 0)	qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI], &(H_[nI*nZ*nZ]), &(g_[nI*nZ]), &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]), 0, 0,0 );
-	else			qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI], &(H_[nI*nZ*nZ]), 0, &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]), 0, 0,0 );
+	if (g_ != 0)	qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI], &(H_[nI*nZ*nZ]), &(g_[nI*nZ]), &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]), 0, 0,0, QPDUNES_ROW_MAJOR );
+	else			qpDUNES_setupFinalInterval( qpData, qpData->intervals[nI], &(H_[nI*nZ*nZ]), 0, &(zLowMod[nI*nZ]), &(zUppMod[nI*nZ]), 0, 0,0, QPDUNES_ROW_MAJOR );
 
 
 
@@ -632,8 +632,33 @@ return_t mpcDUNES_solve(	mpcProblem_t* const mpcProblem,
 							const real_t* const x0
 							)
 {
+	return_t statusFlag;
+
 	/* TODO: make shift in data optional */
 
+	/* (1) feedback phase: embed initial value and solve */
+	mpcDUNES_feedback( mpcProblem, x0 );
+
+	/* (2) preparation phase for next QP */
+	statusFlag = mpcDUNES_prepare( mpcProblem );
+	if (statusFlag != QPDUNES_OK) {
+		qpDUNES_printError( &(mpcProblem->qpData), __FILE__, __LINE__, "Preparation of next QP failed." );
+		return statusFlag;
+	}
+
+	return mpcProblem->exitFlag;
+}
+/*<<< END OF mpcDUNES_solve */
+
+
+/* ----------------------------------------------
+ * feedback phase: embed initial value, solve QP, and recover MPC solution
+ *
+ # >>>>>>                                           */
+return_t mpcDUNES_feedback(	mpcProblem_t* const mpcProblem,
+								const real_t* const x0
+								)
+{
 	int_t kk, ii;
 	qpData_t* qpData = &(mpcProblem->qpData);
 
@@ -675,28 +700,46 @@ return_t mpcDUNES_solve(	mpcProblem_t* const mpcProblem,
 	
 	/*  - objective value */
 	mpcProblem->optObjVal = qpDUNES_computeObjectiveValue( qpData );
-	
 
-	/* (4) prepare next QP solution */
+	return mpcProblem->exitFlag;
+}
+/*<<< END OF mpcDUNES_feedback */
+
+
+/* ----------------------------------------------
+ * preparation phase: shift and set up next QP as far as possible
+ * without knowledge of the next initial value
+ *
+ # >>>>>>                                           */
+return_t mpcDUNES_prepare(	mpcProblem_t* const mpcProblem
+							)
+{
+	int_t kk;
+	qpData_t* qpData = &(mpcProblem->qpData);
+
 	/*  - shift variables */
 	qpDUNES_shiftLambda( &(mpcProblem->qpData) );			/* shift multipliers */
 	qpDUNES_shiftIntervals( &(mpcProblem->qpData) );		/* shift intervals (particulary important when using qpOASES for underlying local QPs) */
+	if ( mpcProblem->isLTI == QPDUNES_FALSE ) {
+		qpDUNES_indicateDataChange( qpData );				/* Newton Hessian blocks were built from the unshifted matrices */
+	}
 
 	/*  - reset original variable bounds (important in LTI case, might be redundant if data is updated) */
 	qpDUNES_updateIntervalData( &(mpcProblem->qpData),
 								mpcProblem->qpData.intervals[_NI_-1],
 								0, 0, 0, 0,
 								mpcProblem->z0LowOrig,mpcProblem->z0UppOrig,
-								0, 0,0, 0 );
+								0, 0,0, 0, QPDUNES_ROW_MAJOR );
 
 	/* TODO: this is a bit inefficient, but makes sure the local clipping QPs are correct initialized (qStep) for the next iteration */
 	for( kk=0; kk<_NI_+1; ++kk ) {
 		qpDUNES_setupStageQP( qpData, qpData->intervals[kk], QPDUNES_FALSE );
 	}
 
-	return mpcProblem->exitFlag;
+	/*  - precompute everything independent of the next initial value */
+	return qpDUNES_prepare( qpData );
 }
-/*<<< END OF mpcDUNES_solve */
+/*<<< END OF mpcDUNES_prepare */
 
 
 
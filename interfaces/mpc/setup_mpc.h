@@ -201,6 +201,31 @@ return_t mpcDUNES_solve(	mpcProblem_t* const mpcProblem,
 
 
 
+/**
+ *	\brief Feedback phase of a real-time iteration
+ *
+ *	Embeds the initial value x0, solves the prepared QP and recovers the
+ *	MPC solution. Does not shift; call mpcDUNES_prepare afterwards.
+ */
+return_t mpcDUNES_feedback(	mpcProblem_t* const mpcProblem,
+								const real_t* const x0
+								);
+
+
+
+/**
+ *	\brief Preparation phase of a real-time iteration
+ *
+ *	Shifts the problem and precomputes all parts of the next QP solution
+ *	that do not depend on the next initial value. May run in a background
+ *	thread while waiting for the next measurement; it has to be completed
+ *	before mpcDUNES_feedback is called.
+ */
+return_t mpcDUNES_prepare(	mpcProblem_t* const mpcProblem
+							);
+
+
+
 #endif	/* SETUP_MPC_H */
 
 
@@ -37,7 +37,7 @@
  * 
  >>>>>>                                           */
 return_t qpDUNES_solve(qpData_t* const qpData) {
-	uint_t ii, kk;
+	int_t ii;
 
 	
 	#ifdef __MEASURE_TIMINGS__
@@ -49,6 +49,8 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 	return_t statusFlag = QPDUNES_OK; /* generic status flag */
 	int_t lastActSetChangeIdx = _NI_;
 	real_t objValIncumbent = qpData->options.QPDUNES_INFTY;
+	real_t objValPrev;
+	real_t alphaInit;
     
 	int_t* itCntr = &(qpData->log.numIter);
 	itLog_t* itLogPtr = &(qpData->log.itLog[0]);
@@ -69,10 +71,14 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 
 		if (interval->qpSolverSpecification	== QPDUNES_STAGE_QP_SOLVER_CLIPPING) { /* clip solution */
 			/* clip solution: */
-			/* TODO: already clip all QPs except for the first one (initial value embedding); but take care for MHE!!!*/
+			/* the initial step is pending only after a stage QP setup; stages stepped in
+			 * qpDUNES_prepare or a previous solve only need re-clipping for possibly updated bounds */
+			alphaInit = (interval->isPrepared == QPDUNES_TRUE) ? 0. : 1.;
+			interval->isPrepared = QPDUNES_TRUE;
+			interval->lambdaHasChanged = QPDUNES_TRUE;		/* no stage results can be reused from previous solves */
 			statusFlag = directQpSolver_doStep(	qpData,
 												interval,
-												&(interval->qpSolverClipping.dz), 1,
+												&(interval->qpSolverClipping.dz), alphaInit,
 												&(interval->qpSolverClipping.zUnconstrained),
 												&(interval->z),
 												&(interval->y),
@@ -98,6 +104,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 	}
 
 	objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
+	qpData->lsGradientIsValid = QPDUNES_FALSE;
 	#ifdef __MEASURE_TIMINGS__
 	tQpEnd = getTime();
 	#endif
@@ -110,10 +117,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 	}
 	/* get active set of local constraints */
 	itLogPtr->nActConstr = qpDUNES_getActSet( qpData, itLogPtr->ieqStatus );
-	itLogPtr->nChgdConstr = qpDUNES_compareActSets( qpData,
-												 	(const int_t * const * const ) itLogPtr->ieqStatus, /* explicit casting necessary due to gcc bug */
-												 	(const int_t * const * const ) itLogPtr->prevIeqStatus,
-												 	&lastActSetChangeIdx );
+	itLogPtr->nChgdConstr = qpDUNES_compareActSets( qpData, &lastActSetChangeIdx );
 
 	/** (3a) log and display */
 	if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)
@@ -157,8 +161,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 			#ifdef __MEASURE_TIMINGS__
 			tNwtnSetupStart = getTime();
 			#endif
-			qpDUNES_computeNewtonGradient(qpData, &(qpData->gradient),
-					&(qpData->xVecTmp));
+			qpDUNES_getNewtonGradient(qpData);
 			#ifdef __MEASURE_TIMINGS__
 			tNwtnSetupEnd = getTime();
 			#endif
@@ -168,7 +171,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 			tNwtnSolveStart = getTime();
 			#endif
 			qpDUNES_copyVector(&(qpData->deltaLambda), &(qpData->gradient),
-					_NI_ * _NX_);
+					_NXTTL_);
 			statusFlag = QPDUNES_OK;
 			#ifdef __MEASURE_TIMINGS__
 			tNwtnSolveEnd = getTime();
@@ -184,20 +187,9 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 				case QPDUNES_OK:
 					break;
 				case QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND: /* zero gradient norm detected */
-					qpDUNES_printSuccess(qpData, "Optimal solution found: gradient norm %.1e",	vectorNorm(&(qpData->gradient), _NI_ * _NX_));
+					qpDUNES_printSuccess(qpData, "Optimal solution found: gradient norm %.1e",	vectorNorm(&(qpData->gradient), _NXTTL_));
 					if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)  qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, lastActSetChangeIdx);
-					/* save active set corresponding to last Hessian factorization */
-					if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS) {
-						/* the Hessian was factorized in the previous iteration, and it was computed at the point before the step was taken */
-						for (kk = 0; kk < _NI_ + 1; ++kk) {
-							for (ii = 0; ii < _ND(kk)+_NV(kk); ++ii ) {
-								qpData->log.itLog[0].prevIeqStatus[kk][ii] = qpData->log.itLog[(*itCntr) - 1].prevIeqStatus[kk][ii];
-							}
-						}
-					}
-					else {
-						/* if iterations logging is switched off, the last active set is already saved in itLog[0].prevIeqStatus */
-					}
+					/* the active set of the last Hessian setup is kept in the intervals' packed active sets */
 					/* ...and leave */
 					return QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND;
 				default:
@@ -213,7 +205,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 			#ifdef __MEASURE_TIMINGS__
 			tNwtnFactorStart = getTime();
 			#endif
-			statusFlag = qpDUNES_factorNewtonSystem(qpData, &(itLogPtr->isHessianRegularized), lastActSetChangeIdx);		/* TODO! can we get a problem with on-the-fly regularization in partial refactorization? might only be partially reg.*/
+			statusFlag = qpDUNES_factorNewtonSystem(qpData, &(itLogPtr->isHessianRegularized), lastActSetChangeIdx);
 			switch (statusFlag) {
 				case QPDUNES_OK:
 					break;
@@ -230,19 +222,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 			#ifdef __MEASURE_TIMINGS__
 			tNwtnSolveStart = getTime();
 			#endif
-			switch (qpData->options.nwtnHssnFacAlg) {
-			case QPDUNES_NH_FAC_BAND_FORWARD:
-				statusFlag = qpDUNES_solveNewtonEquation(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), &(qpData->gradient));
-				break;
-
-			case QPDUNES_NH_FAC_BAND_REVERSE:
-				statusFlag = qpDUNES_solveNewtonEquationBottomUp(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), &(qpData->gradient));
-				break;
-
-			default:
-				qpDUNES_printError(qpData, __FILE__, __LINE__, "Unknown Newton Hessian factorization algorithm. Cannot do backsolve.");
-				return QPDUNES_ERR_INVALID_ARGUMENT;
-			}
+			statusFlag = qpDUNES_solveNewtonSystem(qpData, &(qpData->deltaLambda), &(qpData->gradient), QPDUNES_TRUE);
 			#ifdef __MEASURE_TIMINGS__
 			tNwtnSolveEnd = getTime();
 			#endif
@@ -258,6 +238,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 		#ifdef __MEASURE_TIMINGS__
 		tQpStart = getTime();
 		#endif
+		qpDUNES_detectLambdaChanges(qpData, &(qpData->deltaLambda));
 		statusFlag = qpDUNES_solveAllLocalQPs(qpData, &(qpData->deltaLambda));
 		#ifdef __MEASURE_TIMINGS__
 		tQpEnd = getTime();
@@ -273,7 +254,12 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 		/** (3) do infeasibility check */
 		if ( qpData->options.checkForInfeasibility == QPDUNES_TRUE )
 		{
-			qpDUNES_printWarning(qpData, __FILE__, __LINE__, "Infeasibility check not yet implemented.");
+			statusFlag = qpDUNES_infeasibilityCheck(qpData);
+			if (statusFlag != QPDUNES_OK) {
+				qpDUNES_printError(qpData, __FILE__, __LINE__, "Stage coupling constraints are infeasible.");
+				if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)  qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, lastActSetChangeIdx);
+				return statusFlag;
+			}
 		}
 
 
@@ -283,6 +269,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 		#ifdef __MEASURE_TIMINGS__
 		tLineSearchStart = getTime();
 		#endif
+		objValPrev = objValIncumbent;
 		statusFlag = qpDUNES_determineStepLength(qpData, &(qpData->lambda),
 				&(qpData->deltaLambda), &(itLogPtr->numLineSearchIter),
 				&(qpData->alpha), &objValIncumbent,
@@ -304,29 +291,13 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 				if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)  qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, lastActSetChangeIdx);
 				return statusFlag;
 		}
+		qpDUNES_adaptRegularization(qpData, itLogPtr->isHessianRegularized, qpData->alpha, objValIncumbent - objValPrev);
 		
 
 		/** (5) regular log and display iteration */
-		/* get active set of local constraints */
-		/* - save old active set */
-		if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS) {
-			itLogPtr->prevIeqStatus = qpData->log.itLog[(*itCntr) - 1].ieqStatus;
-		}
-		else {
-			/* itLogPtr stays constant */
-			/* copy prevIeqStatus */
-			for (kk = 0; kk < _NI_ + 1; ++kk) {
-				for (ii = 0; ii < _ND(kk)+_NV(kk); ++ii ) {
-					itLogPtr->prevIeqStatus[kk][ii] = itLogPtr->ieqStatus[kk][ii];
-				}
-			}
-		}
-		/* - get new active set */
+		/* get active set of local constraints and compare against last Hessian setup */
 		itLogPtr->nActConstr = qpDUNES_getActSet( qpData, itLogPtr->ieqStatus );
-		itLogPtr->nChgdConstr = qpDUNES_compareActSets( qpData,
-													 (const int_t * const * const ) itLogPtr->ieqStatus, /* explicit casting necessary due to gcc bug */
-													 (const int_t * const * const ) itLogPtr->prevIeqStatus,
-													 &lastActSetChangeIdx);
+		itLogPtr->nChgdConstr = qpDUNES_compareActSets( qpData, &lastActSetChangeIdx );
 		qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, lastActSetChangeIdx);
 		/* display */
 		if ((*itCntr) % qpData->options.printIntervalHeader == 1) {
@@ -391,6 +362,104 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 /*<<< END OF qpDUNES_solve */
 
 
+/* ----------------------------------------------
+ * preparation phase of a real-time iteration
+ *
+ * Everything that does not depend on the embedded initial value
+ * (bounds on the first stage) is computed ahead of qpDUNES_solve:
+ * initial steps of stages 1..nI, the Newton Hessian blocks that only
+ * depend on those stages and, for the reverse factorization, the
+ * Cholesky factor of block columns nI-1..1. The subsequent feedback
+ * call then only needs to process stage 0 and Newton block 0; the
+ * twisted factorization refactorizes the window of changed stages
+ * and leaves block columns up to the twist to the feedback call.
+ *
+ * Call after shifting and data updates, before embedding x0.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_prepare(	qpData_t* const qpData
+							)
+{
+	int_t kk;
+	int_t firstActSetChangeIdx;
+	int_t lastActSetChangeIdx = -1;
+	boolean_t isHessianRegularized = QPDUNES_FALSE;
+
+	interval_t* interval;
+	return_t statusFlag;
+
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (qpData->intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
+			qpDUNES_printWarning(qpData, __FILE__, __LINE__, "Preparation is only supported with clipping stage QPs. Skipping.");
+			return QPDUNES_OK;
+		}
+	}
+
+	/** (1) initial step for stage QPs that do not depend on the initial value */
+	for (kk = 1; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+		if (interval->isPrepared == QPDUNES_TRUE) {
+			continue;
+		}
+		statusFlag = directQpSolver_doStep(	qpData,
+											interval,
+											&(interval->qpSolverClipping.dz), 1,
+											&(interval->qpSolverClipping.zUnconstrained),
+											&(interval->z),
+											&(interval->y),
+											&(interval->q),
+											&(interval->p)
+											);
+		if (statusFlag != QPDUNES_OK) {
+			qpDUNES_printError(qpData, __FILE__, __LINE__, "QP on interval %d infeasible!", kk);
+			return statusFlag;
+		}
+		interval->isPrepared = QPDUNES_TRUE;
+	}
+
+	/** (2) detect active set changes on stages 1..nI; stage 0 is marked as changed
+	 *      so that its Newton blocks are rebuilt once the initial value is known */
+	qpDUNES_getActSet( qpData, qpData->log.itLog[0].ieqStatus );
+	qpDUNES_invalidateActSet( qpData->intervals[0] );
+	qpDUNES_compareActSets( qpData, &lastActSetChangeIdx );
+	qpData->intervals[0]->actSetHasChanged = QPDUNES_FALSE;
+
+	/** (3) rebuild Newton Hessian blocks of changed stages */
+	statusFlag = qpDUNES_setupNewtonHessian(qpData);
+	if (statusFlag != QPDUNES_OK) {
+		qpDUNES_printError(qpData, __FILE__, __LINE__, "Setup of Newton Hessian failed.");
+		return statusFlag;
+	}
+
+	/** (4) reverse factorization can be advanced up to block column 1 */
+	if ( (qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_REVERSE) && (lastActSetChangeIdx >= 1) ) {
+		statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, &(qpData->cholHessian), &(qpData->hessian), lastActSetChangeIdx, 1, &isHessianRegularized );
+		if (statusFlag != QPDUNES_OK) {
+			/* leave (regularized) factorization to feedback phase: force full refactorization */
+			qpDUNES_invalidateActSet( qpData->intervals[_NI_] );
+		}
+	}
+
+	/*     twisted factorization: refactorize the changed window now, the feedback phase then only redoes block columns up to the twist */
+	if ( ( (qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_TWISTED) || (qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_AUTO) )
+		 && (lastActSetChangeIdx >= 1) )
+	{
+		for (firstActSetChangeIdx = 1; firstActSetChangeIdx < _NI_ + 1; ++firstActSetChangeIdx) {
+			if (qpData->intervals[firstActSetChangeIdx]->actSetHasChanged == QPDUNES_TRUE) {
+				break;
+			}
+		}
+		statusFlag = qpDUNES_factorizeNewtonHessianTwisted( qpData, &(qpData->cholHessian), &(qpData->hessian), firstActSetChangeIdx, lastActSetChangeIdx, &isHessianRegularized );
+		if (statusFlag != QPDUNES_OK) {
+			qpDUNES_invalidateActSet( qpData->intervals[_NI_] );
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_prepare */
+
+
 /* ----------------------------------------------
  * log all data of this iteration
  *
@@ -403,27 +472,33 @@ void qpDUNES_logIteration(	qpData_t* qpData,
 {
 	int_t kk, ii;
 
-	itLogPtr->gradNorm = vectorNorm(&(qpData->gradient), _NI_ * _NX_);
-	itLogPtr->stepNorm = vectorNorm(&(qpData->deltaLambda), _NI_ * _NX_);
+	itLogPtr->gradNorm = vectorNorm(&(qpData->gradient), _NXTTL_);
+	itLogPtr->stepNorm = vectorNorm(&(qpData->deltaLambda), _NXTTL_);
 	itLogPtr->stepSize = qpData->alpha;
-	itLogPtr->lambdaNorm = vectorNorm(&(qpData->lambda), _NI_ * _NX_);
+	itLogPtr->lambdaNorm = vectorNorm(&(qpData->lambda), _NXTTL_);
 	itLogPtr->objVal = objValIncumbent;
 	itLogPtr->lastActSetChangeIdx = lastActSetChangeIdx;
 
 	/* full logging */
 	if (qpData->options.logLevel == QPDUNES_LOG_ALL_DATA) {
 		/* - dual variables */
-		qpDUNES_copyVector(&(itLogPtr->lambda), &(qpData->lambda), _NI_ * _NX_);
+		qpDUNES_copyVector(&(itLogPtr->lambda), &(qpData->lambda), _NXTTL_);
 		qpDUNES_copyVector(&(itLogPtr->deltaLambda), &(qpData->deltaLambda),
-				_NI_ * _NX_);
+				_NXTTL_);
 		/* - Newton system */
-		for (ii = 0; ii < _NI_ * _NX_ * 2 * _NX_; ++ii) {
+		for (ii = 0; ii < _XN2XOFF(_NI_); ++ii) {
 			itLogPtr->hessian.data[ii] = qpData->hessian.data[ii];
 			itLogPtr->cholHessian.data[ii] = qpData->cholHessian.data[ii];
 		}
-		for (ii = 0; ii < _NI_ * _NX_; ++ii) {
+		for (ii = 0; ii < _NXTTL_; ++ii) {
 			itLogPtr->gradient.data[ii] = qpData->gradient.data[ii];
 		}
+		/* - regularization: pivot modifications and Levenberg-Marquardt block shifts */
+		for (kk = 0; kk < _NI_; ++kk) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				itLogPtr->regDirections.data[_XNOFF(kk)+ii] = qpData->regDirections.data[_XNOFF(kk)+ii] + qpData->regShift[kk];
+			}
+		}
 		/* - local primal and variables */
 		for (kk = 0; kk < _NI_ + 1; ++kk) {
 			interval_t* interval = qpData->intervals[kk];
@@ -449,14 +524,14 @@ void qpDUNES_logIteration(	qpData_t* qpData,
 			/* do a backsolve with unit vectors to obtain inverse Newton Hessian for analysis */
 			xn_vector_t* unitVec = &(qpData->xnVecTmp);
 			xn_vector_t* resVec = &(qpData->xnVecTmp2);
-			for( ii=0; ii<_NI_*_NX_; ++ii ) {
+			for( ii=0; ii<_NXTTL_; ++ii ) {
 				unitVec->data[ii] = 0.;
 			}
-			for( ii=0; ii<_NI_*_NX_; ++ii ) {
+			for( ii=0; ii<_NXTTL_; ++ii ) {
 				unitVec->data[ii] = 1.;
 				qpDUNES_solveNewtonEquation( qpData, resVec, &(qpData->cholHessian), unitVec );
-				for ( kk=0; kk<_NI_*_NX_; ++kk) {
-					itLogPtr->invHessian.data[kk*_NI_*_NX_+ii] = resVec->data[kk];
+				for ( kk=0; kk<_NXTTL_; ++kk) {
+					itLogPtr->invHessian.data[kk*_NXTTL_+ii] = resVec->data[kk];
 				}
 				unitVec->data[ii] = 0.;
 			}
@@ -469,6 +544,63 @@ void qpDUNES_logIteration(	qpData_t* qpData,
 /*<<< END OF qpDUNES_logIteration */
 
 
+/* ----------------------------------------------
+ * mark stages whose coupling multipliers change along the step deltaLambda
+ *
+ *   Stages with zero step in both adjacent blocks keep their solution,
+ *   objective value and gradient contributions. With a positive
+ *   lambdaChangeTolerance, blocks below that fraction of the full step are
+ *   set to zero first, so that skipped stages stay consistent with lambda.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_detectLambdaChanges(	qpData_t* const qpData,
+										xn_vector_t* const deltaLambda
+										)
+{
+	int_t ii, kk;
+	boolean_t blockHasChanged;
+	boolean_t prevBlockHasChanged = QPDUNES_FALSE;
+
+	real_t stepTol = 0.;
+
+	if (qpData->options.lambdaChangeTolerance > 0.) {
+		for (ii = 0; ii < _NXTTL_; ++ii) {
+			stepTol = qpDUNES_fmax( stepTol, fabs(deltaLambda->data[ii]) );
+		}
+		stepTol *= qpData->options.lambdaChangeTolerance;
+	}
+
+	for (kk = 0; kk < _NI_; ++kk) {
+		blockHasChanged = QPDUNES_FALSE;
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			if ( fabs(deltaLambda->data[_XNOFF(kk) + ii]) > stepTol ) {
+				blockHasChanged = QPDUNES_TRUE;
+				break;
+			}
+		}
+		if (blockHasChanged == QPDUNES_FALSE) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				deltaLambda->data[_XNOFF(kk) + ii] = 0.;
+			}
+		}
+		/* stage kk couples to lambda blocks kk-1 and kk */
+		qpData->intervals[kk]->lambdaHasChanged = ( (prevBlockHasChanged == QPDUNES_TRUE) || (blockHasChanged == QPDUNES_TRUE) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+		prevBlockHasChanged = blockHasChanged;
+	}
+	qpData->intervals[_NI_]->lambdaHasChanged = prevBlockHasChanged;
+
+	/* stage QPs with general constraints are always re-solved to keep the hot-start homotopy consistent */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (qpData->intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
+			qpData->intervals[kk]->lambdaHasChanged = QPDUNES_TRUE;
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_detectLambdaChanges */
+
+
 /* ----------------------------------------------
  * update all qSteps and pSteps (linear and constant objective function contribution) of the local QPs
  *
@@ -483,21 +615,27 @@ return_t qpDUNES_updateAllLocalQPs(	qpData_t* const qpData,
 
 	/* first interval: */
 	interval = qpData->intervals[0];
-	qpDUNES_updateVector( &(interval->lambdaK1), &(lambda->data[0]), _NX_ );
+	qpDUNES_updateVector( &(interval->lambdaK1), &(lambda->data[0]), _NX(1) );
 	/* intermediate intervals: */
 	for (kk = 1; kk < _NI_; ++kk) {
 		interval = qpData->intervals[kk];
-		qpDUNES_updateVector( &(interval->lambdaK), &(lambda->data[(kk - 1) * _NX_]), _NX_ );
-		qpDUNES_updateVector( &(interval->lambdaK1), &(lambda->data[kk * _NX_]), _NX_ );
+		qpDUNES_updateVector( &(interval->lambdaK), &(lambda->data[_XNOFF(kk - 1)]), _NX(kk) );
+		qpDUNES_updateVector( &(interval->lambdaK1), &(lambda->data[_XNOFF(kk)]), _NX(kk + 1) );
 	}
 	/* last interval: */
 	interval = qpData->intervals[_NI_];
-	qpDUNES_updateVector( &(interval->lambdaK), &(lambda->data[(_NI_ - 1) * _NX_]), _NX_ );
+	qpDUNES_updateVector( &(interval->lambdaK), &(lambda->data[_XNOFF(_NI_ - 1)]), _NX(_NI_) );
 
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
 		interval = qpData->intervals[kk];
 		switch (interval->qpSolverSpecification) {
 		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+			if (interval->lambdaHasChanged == QPDUNES_FALSE) {
+				/* zero multiplier step on this stage */
+				qpDUNES_setupZeroVector( &(interval->qpSolverClipping.qStep), interval->nV );
+				interval->qpSolverClipping.pStep = 0.;
+				break;
+			}
 			statusFlag = clippingQpSolver_updateStageData( qpData, interval, &(interval->lambdaK), &(interval->lambdaK1) );
 			break;
 		case QPDUNES_STAGE_QP_SOLVER_QPOASES:
@@ -528,7 +666,7 @@ return_t qpDUNES_solveAllLocalQPs(	qpData_t* const qpData,
 								)
 {
 	int_t kk;
-#ifndef __QPDUNES_PARALLEL__
+#ifdef __QPDUNES_PARALLEL__
 	int_t errCntr = 0;
 #endif
 	return_t statusFlag = QPDUNES_OK;
@@ -544,6 +682,13 @@ return_t qpDUNES_solveAllLocalQPs(	qpData_t* const qpData,
 	#pragma omp parallel for private(kk) shared(statusFlag) schedule(static) /*shared(qpData)*/  /* TODO: manage threads outside!*/
 	for (kk = 0; kk < _NI_ + 1; ++kk)
 	{
+		if ( (qpData->intervals[kk]->lambdaHasChanged == QPDUNES_FALSE) &&
+			 (qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING) )
+		{
+			/* stage QP solution does not move along this step */
+			qpDUNES_setupZeroVector( &(qpData->intervals[kk]->qpSolverClipping.dz), qpData->intervals[kk]->nV );
+			continue;
+		}
 		statusFlag = qpDUNES_solveLocalQP(qpData, qpData->intervals[kk]);
 		if (statusFlag != QPDUNES_OK)
 		{
@@ -551,6 +696,7 @@ return_t qpDUNES_solveAllLocalQPs(	qpData_t* const qpData,
 			#ifndef __QPDUNES_PARALLEL__
 			break;
 			#else
+			#pragma omp atomic
 			errCntr++;
 			#endif
 		}
@@ -616,21 +762,42 @@ return_t qpDUNES_solveLocalQP(	qpData_t* const qpData,
  >>>>>>                                           */
 return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 									)
+{
+	/** calculate gradient and check gradient norm for convergence */
+	qpDUNES_getNewtonGradient(qpData);
+	if ((vectorNorm(&(qpData->gradient), _NXTTL_)
+			< qpData->options.stationarityTolerance)) {
+		return QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND;
+	}
+
+	/** calculate hessian */
+	return qpDUNES_setupNewtonHessian(qpData);
+}
+/*<<< END OF qpDUNES_setupNewtonSystem */
+
+
+/* ----------------------------------------------
+ * rebuild Newton Hessian blocks adjacent to stages with changed active set
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setupNewtonHessian(	qpData_t* const qpData
+									)
 {
 	int_t ii, jj, kk;
+	int_t nXK, nXK1;	/* dimensions of the multiplier blocks lambda_{kk-1} and lambda_kk */
 	
 	#ifndef __SIMPLE_BOUNDS_ONLY__
 	boolean_t addToRes;
 	zx_matrix_t* ZTCT;
 	#endif /* __SIMPLE_BOUNDS_ONLY__ */
 
-	x_vector_t* xVecTmp = &(qpData->xVecTmp);
 	xx_matrix_t* xxMatTmp = &(qpData->xxMatTmp);
 	xx_matrix_t* xxMatTmp2 = &(qpData->xxMatTmp2);
 	ux_matrix_t* uxMatTmp = &(qpData->uxMatTmp);
 	zx_matrix_t* zxMatTmp = &(qpData->zxMatTmp);
 
 	#ifndef __SIMPLE_BOUNDS_ONLY__
+	x_vector_t* xVecTmp = &(qpData->xVecTmp);
 	zx_matrix_t* zxMatTmp2 = &(qpData->xzMatTmp);
 	zz_matrix_t* ZT = &(qpData->zzMatTmp);/* TODO: share memory between qpOASES and qpDUNES!!!*/
 	zz_matrix_t* cholProjHess = &(qpData->zzMatTmp2);/* TODO: share memory between qpOASES and qpDUNES!!!*/
@@ -641,23 +808,33 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 
 	xn2x_matrix_t* hessian = &(qpData->hessian);
 
-	return_t statusFlag;
+	return_t statusFlag = QPDUNES_OK;
 
-	/** calculate gradient and check gradient norm for convergence */
-	qpDUNES_computeNewtonGradient(qpData, &(qpData->gradient), xVecTmp);
-	if ((vectorNorm(&(qpData->gradient), _NX_ * _NI_)
-			< qpData->options.stationarityTolerance)) {
-		return QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND;
+	/* 0) cached contributions of the stages adjacent to a rebuilt block */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		intervals[kk]->projCache.curEntry = 0;
+		if ( (intervals[kk]->actSetHasChanged == QPDUNES_TRUE) ||
+			 ( (kk > 0) && (intervals[kk-1]->actSetHasChanged == QPDUNES_TRUE) ) ||
+			 ( (kk < _NI_) && (intervals[kk+1]->actSetHasChanged == QPDUNES_TRUE) ) )
+		{
+			intervals[kk]->projCache.curEntry = qpDUNES_lookupProjCache( qpData, intervals[kk] );
+		}
 	}
 
-
-	/** calculate hessian */
-
 	/* 1) diagonal blocks */
 	/*    E_{k+1} P_{k+1}^-1 E_{k+1}' + C_{k} P_{k} C_{k}'  for projected Hessian  P = Z (Z'HZ)^-1 Z'  */
 	for (kk = 0; kk < _NI_; ++kk) {
 		/* check whether block needs to be recomputed */
 		if ( (intervals[kk]->actSetHasChanged == QPDUNES_TRUE) || (intervals[kk+1]->actSetHasChanged == QPDUNES_TRUE) ) {
+			if ( qpDUNES_getCachedNewtonHessianBlock( qpData, hessian, kk ) == QPDUNES_TRUE ) {
+				continue;	/* both stage contributions were cached */
+			}
+			if ( qpDUNES_updateNewtonHessianBlock( qpData, hessian, kk ) == QPDUNES_TRUE ) {
+				continue;	/* a few bounds flipped, rank-one updates were cheaper */
+			}
+			nXK1 = _NX(kk+1);
+			qpData->regShift[kk] = 0.;		/* block is rebuilt without regularization */
+			qpData->nwtnBlockUpdateCount[kk] = 0;
 			#ifdef __DEBUG__
 			if (qpData->options.printLevel >= 4) {
 				qpDUNES_printf("rebuilt diagonal block %d of %d", kk, _NI_-1);
@@ -669,9 +846,9 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 				#ifndef __SIMPLE_BOUNDS_ONLY__
 					qpOASES_getZT(qpData, intervals[kk + 1]->qpSolverQpoases.qpoasesObject, &nFree,	ZT);
 					qpOASES_getCholZTHZ(qpData, intervals[kk + 1]->qpSolverQpoases.qpoasesObject, cholProjHess);
-					backsolveRT_ZTET(qpData, zxMatTmp2, cholProjHess, ZT, xVecTmp, intervals[kk + 1]->nV, nFree);
+					backsolveRT_ZTET(qpData, zxMatTmp2, cholProjHess, ZT, xVecTmp, intervals[kk + 1]->nV, nFree, nXK1);
 					addToRes = QPDUNES_FALSE;
-					multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp2->data, nFree, _NX_, _NX_, addToRes);
+					multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp2->data, nFree, nXK1, nXK1, addToRes);
 				#else
 					qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
 					return QPDUNES_ERR_INVALID_ARGUMENT;
@@ -679,20 +856,20 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 			}
 			else { /* clipping QP solver */
 
-				statusFlag = getInvQ(qpData, xxMatTmp, &(intervals[kk + 1]->cholH), intervals[kk + 1]->nV); /* getInvQ not supported with matrices other than diagonal... is this even possible? */
+				statusFlag = getInvQ(qpData, xxMatTmp, clippingQpSolver_getNewtonHessianFactor(intervals[kk + 1]), intervals[kk + 1]->nV); /* getInvQ not supported with matrices other than diagonal... is this even possible? */
 				if (statusFlag != QPDUNES_OK)
 					break;
 
 				/* Annihilate columns in invQ; WARNING: this can really only be applied for diagonal matrices */
-				statusFlag = qpDUNES_makeMatrixDense(xxMatTmp, _NX_, _NX_);
+				statusFlag = qpDUNES_makeMatrixDense(xxMatTmp, nXK1, nXK1);
 				if (statusFlag != QPDUNES_OK)
 					break;
 				
-				for (ii = 0; ii < _NX_; ++ii) {
+				for (ii = 0; ii < nXK1; ++ii) {
 					if ((intervals[kk + 1]->y.data[2 * ii] >= qpData->options.equalityTolerance) ||		/* check if local constraint lb_x is active*/
 						(intervals[kk + 1]->y.data[2 * ii + 1] >= qpData->options.equalityTolerance))	/* check if local constraint ub_x is active*/	/* WARNING: weakly active constraints are excluded here!*/
 					{
-						xxMatTmp->data[ii * _NX_ + ii] = 0.;
+						xxMatTmp->data[ii * nXK1 + ii] = 0.;
 					}
 				}
 			}
@@ -706,44 +883,55 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 					qpOASES_getCholZTHZ(qpData,	intervals[kk]->qpSolverQpoases.qpoasesObject, cholProjHess);
 					/* computer Z.T * C.T */
 					ZTCT = zxMatTmp;
-					multiplyMatrixMatrixTDenseDense(ZTCT->data, ZT->data, intervals[kk]->C.data, nFree, _NZ_, _NX_);
+					multiplyMatrixMatrixTDenseDense(ZTCT->data, ZT->data, intervals[kk]->C.data, nFree, intervals[kk]->nV, nXK1);
 					/* compute "squareroot" of C_{k} P_{k} C_{k}' */
-					backsolveRT_ZTCT(qpData, zxMatTmp2, cholProjHess, ZTCT, xVecTmp, intervals[kk]->nV, nFree);
+					backsolveRT_ZTCT(qpData, zxMatTmp2, cholProjHess, ZTCT, xVecTmp, intervals[kk]->nV, nFree, nXK1);
 					/* compute C_{k} P_{k} C_{k}' contribution */
 					addToRes = QPDUNES_TRUE;
-					multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp2->data, nFree, _NX_, _NX_, addToRes);
+					multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp2->data, nFree, nXK1, nXK1, addToRes);
 				#else
 					qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
 					return QPDUNES_ERR_INVALID_ARGUMENT;
 				#endif /* __SIMPLE_BOUNDS_ONLY__ */
 			}
 			else { /* clipping QP solver */
-				statusFlag = addCInvHCT(qpData, xxMatTmp, &(intervals[kk]->cholH), &(intervals[kk]->C), &(intervals[kk]->y), xxMatTmp2, uxMatTmp, zxMatTmp);
+				statusFlag = addCInvHCT(qpData, xxMatTmp, clippingQpSolver_getNewtonHessianFactor(intervals[kk]), &(intervals[kk]->C), &(intervals[kk]->y), xxMatTmp2, uxMatTmp, zxMatTmp, nXK1, intervals[kk]->nV);
 				if (statusFlag != QPDUNES_OK)
 					break;
 			}
 
-			/* write Hessian part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				for (jj = 0; jj < _NX_; ++jj) {
-					accHessian( kk, 0, ii, jj ) = xxMatTmp->data[ii * _NX_ + jj];
-					/* clean xxMatTmp */
-					xxMatTmp->data[ii * _NX_ + jj] = 0.; /* TODO: this cleaning part is probably not needed, but we need to be very careful if we decide to leave it out! */
+			/* write Hessian part, lower triangle only */
+			for (ii = 0; ii < nXK1; ++ii) {
+				for (jj = 0; jj <= ii; ++jj) {
+					accHessian( kk, 0, ii, jj ) = xxMatTmp->data[ii * nXK1 + jj];
 				}
 			}
+			/* clean xxMatTmp */
+			for (ii = 0; ii < nXK1 * nXK1; ++ii) {
+				xxMatTmp->data[ii] = 0.; /* TODO: this cleaning part is probably not needed, but we need to be very careful if we decide to leave it out! */
+			}
 		}
 	}	/* END OF diagonal block for loop */
 
 	if (statusFlag != QPDUNES_OK)
 	{
+		qpDUNES_indicateDataChange( qpData );	/* blocks may be partially updated, force a rebuild */
 		qpDUNES_printError( qpData, __FILE__, __LINE__, "Building of diagonal blocks of the Hessian failed." );
 		qpDUNES_printf("Building of the Hessian failed at iteration %d.", kk);
 		return statusFlag;
 	}
 
-	/* 2) sub-diagonal blocks */
+	/* 2) sub-diagonal blocks; never used by the matrix-free Newton solver */
 	for (kk = 1; kk < _NI_; ++kk) {
-		if (intervals[kk]->actSetHasChanged == QPDUNES_TRUE) {
+		if ( (intervals[kk]->actSetHasChanged == QPDUNES_TRUE) && (qpData->options.nwtnHssnFacAlg != QPDUNES_NH_PCG_BLOCK_JACOBI) ) {
+			if ( qpDUNES_getCachedNewtonHessianSubDiagBlock( qpData, hessian, kk ) == QPDUNES_TRUE ) {
+				continue;
+			}
+			if ( qpDUNES_updateNewtonHessianSubDiagBlock( qpData, hessian, kk ) == QPDUNES_TRUE ) {
+				continue;
+			}
+			nXK = _NX(kk);
+			nXK1 = _NX(kk+1);
 			#ifdef __DEBUG__
 			if (qpData->options.printLevel >= 4) {
 				qpDUNES_printf("rebuilt off-diag block %d of %d", kk, _NI_-1);
@@ -757,20 +945,20 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 
 					/* compute "squareroot" of C_{k} P_{k} C_{k}' */
 					/* computer Z.T * C.T */
-					multiplyMatrixMatrixTDenseDense(zxMatTmp->data, ZT->data, intervals[kk]->C.data, nFree, _NZ_, _NX_);
-					backsolveRT_ZTCT(qpData, zxMatTmp2, cholProjHess, zxMatTmp, xVecTmp, intervals[kk]->nV, nFree);
+					multiplyMatrixMatrixTDenseDense(zxMatTmp->data, ZT->data, intervals[kk]->C.data, nFree, intervals[kk]->nV, nXK1);
+					backsolveRT_ZTCT(qpData, zxMatTmp2, cholProjHess, zxMatTmp, xVecTmp, intervals[kk]->nV, nFree, nXK1);
 
 					/* compute "squareroot" of E_{k} P_{k} E_{k}' */
-					backsolveRT_ZTET(qpData, zxMatTmp, cholProjHess, ZT, xVecTmp, intervals[kk]->nV, nFree);
+					backsolveRT_ZTET(qpData, zxMatTmp, cholProjHess, ZT, xVecTmp, intervals[kk]->nV, nFree, nXK);
 
 					/* compute C_{k} P_{k} E_{k}' contribution */
 					addToRes = QPDUNES_FALSE;
-					multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp->data, nFree, _NX_, _NX_, addToRes);
+					multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp->data, nFree, nXK1, nXK, addToRes);
 
 					/* write Hessian part */
-					for (ii = 0; ii < _NX_; ++ii) {
-						for (jj = 0; jj < _NX_; ++jj) {
-							accHessian( kk, -1, ii, jj ) = - xxMatTmp->data[ii * _NX_ + jj];
+					for (ii = 0; ii < nXK1; ++ii) {
+						for (jj = 0; jj < nXK; ++jj) {
+							accHessian( kk, -1, ii, jj ) = - xxMatTmp->data[ii * nXK + jj];
 						}
 					}
 				#else
@@ -779,18 +967,18 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 				#endif /* __SIMPLE_BOUNDS_ONLY__ */
 			}
 			else { /* clipping QP solver */
-				statusFlag = multiplyAInvQ( qpData, &(qpData->xxMatTmp), &(intervals[kk]->C), &(intervals[kk]->cholH) );
+				statusFlag = multiplyAInvQ( qpData, &(qpData->xxMatTmp), &(intervals[kk]->C), clippingQpSolver_getNewtonHessianFactor(intervals[kk]), nXK1, nXK, intervals[kk]->nV );
 				if (statusFlag != QPDUNES_OK)
 					break;
 
 				/* write Hessian part */
-				for (ii=0; ii<_NX_; ++ii) {
-					for (jj=0; jj<_NX_; ++jj) {
+				for (ii=0; ii<nXK1; ++ii) {
+					for (jj=0; jj<nXK; ++jj) {
 						/* cheap way of annihilating columns; TODO: make already in multiplication routine! */
 						if ( ( intervals[kk]->y.data[2*jj] <= qpData->options.equalityTolerance ) &&		/* check if local constraint lb_x is inactive*/
 							 ( intervals[kk]->y.data[2*jj+1] <= qpData->options.equalityTolerance ) )		/* check if local constraint ub_x is inactive*/
 						{
-							accHessian( kk, -1, ii, jj ) = - xxMatTmp->data[ii * _NX_ + jj];
+							accHessian( kk, -1, ii, jj ) = - xxMatTmp->data[ii * nXK + jj];
 						}
 						else {
 							/* eliminate column if variable bound is active */
@@ -802,665 +990,2018 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData
 		}
 	}	/* END OF sub-diagonal block for loop */
 
-/*	qpDUNES_printMatrixData( qpData->hessian.data, _NI_*_NX_, 2*_NX_, "H = ");*/
 	
 	if (statusFlag != QPDUNES_OK)
 	{
+		qpDUNES_indicateDataChange( qpData );
 		qpDUNES_printError( qpData, __FILE__, __LINE__, "Building of sub-diagonal blocks of the Hessian failed." );
 		qpDUNES_printf("Building of the Hessian sub-blocks failed at iteration %d.", kk);
+		return statusFlag;
+	}
+
+	/* 3) remember active sets the rebuilt blocks correspond to */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (intervals[kk]->actSetHasChanged == QPDUNES_TRUE) {
+			for (ii = 0; ii < intervals[kk]->actSet.nWords; ++ii) {
+				intervals[kk]->actSet.prevBits[ii] = intervals[kk]->actSet.bits[ii];
+			}
+			intervals[kk]->actSet.prevBitsAreValid = QPDUNES_TRUE;
+		}
 	}
 
 	return statusFlag;
 }
-/*<<< END OF qpDUNES_setupNewtonSystem */
+/*<<< END OF qpDUNES_setupNewtonHessian */
 
 
 /* ----------------------------------------------
- * ...
+ * whether a Newton Hessian block of stage kk can be updated from
+ * the bounds flipped since its last setup: needs a clipping stage
+ * with diagonal Hessian and dense C, and valid previous active set
  *
- * >>>>>>                                           */
-return_t qpDUNES_computeNewtonGradient(qpData_t* const qpData, xn_vector_t* gradient,
-		x_vector_t* gradPiece) {
-	int_t kk, ii;
-
-	interval_t** intervals = qpData->intervals;
-
-	/* d/(d lambda_ii) for kk=0.._NI_-1 */
-	for (kk = 0; kk < _NI_; ++kk) {
-		/* ( C_kk*z_kk^opt + c_kk ) - x_(kk+1)^opt */
-		multiplyCz(qpData, gradPiece, &(intervals[kk]->C), &(intervals[kk]->z));
-		addToVector(gradPiece, &(intervals[kk]->c), _NX_);
-
-		/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX_ ); */
-		for (ii = 0; ii < _NX_; ++ii) {
-			gradPiece->data[ii] -= intervals[kk + 1]->z.data[ii];
-		}
-
-		/* write gradient part */
-		for (ii = 0; ii < _NX_; ++ii) {
-			gradient->data[kk * _NX_ + ii] = gradPiece->data[ii];
-		}
+ >>>>>>                                           */
+boolean_t qpDUNES_isNewtonBlockUpdatable(	const qpData_t* const qpData,
+											const interval_t* const interval
+											)
+{
+	if ( qpData->options.maxNumNewtonBlockUpdates <= 0 ) {
+		return QPDUNES_FALSE;
 	}
-	return QPDUNES_OK;
+	if ( ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING ) ||
+		 ( interval->actSet.prevBitsAreValid == QPDUNES_FALSE ) )
+	{
+		return QPDUNES_FALSE;
+	}
+	if ( ( interval->H.sparsityType != QPDUNES_DIAGONAL ) && ( interval->H.sparsityType != QPDUNES_IDENTITY ) ) {
+		return QPDUNES_FALSE;
+	}
+	if ( ( (int_t)interval->id < _NI_ ) && ( interval->C.sparsityType != QPDUNES_DENSE ) ) {
+		return QPDUNES_FALSE;
+	}
+
+	return QPDUNES_TRUE;
 }
-/*<<< END OF computeNewtonGradient */
+/*<<< END OF qpDUNES_isNewtonBlockUpdatable */
 
 
-return_t qpDUNES_factorNewtonSystem( qpData_t* const qpData,
-								  	 boolean_t* const isHessianRegularized,
-								  	 int_t lastActSetChangeIdx
-								  	 )
+/* ----------------------------------------------
+ * weight of variable ii of a clipping stage with diagonal Hessian
+ * in the Newton Hessian, 1/H_ii for free, 1/(H_ii + softL2_ii) for
+ * soft-penalized and 0 for variables at a bound; status as packed
+ * in the active set bits; negative if H_ii vanishes
+ *
+ >>>>>>                                           */
+real_t qpDUNES_getNewtonBlockWeight(	const qpData_t* const qpData,
+										const interval_t* const interval,
+										int_t ii,
+										actSetWord_t status
+										)
 {
-	int_t ii, jj, kk;
-
-	return_t statusFlag;
+	real_t hii = ( interval->H.sparsityType == QPDUNES_DIAGONAL ) ? interval->H.data[ii] : 1.;
 
-	real_t minDiagElem = qpData->options.QPDUNES_INFTY;
+	if ( ( status == 1 ) || ( status == 2 ) ) {		/* lower or upper bound active */
+		return 0.;
+	}
+	if ( ( status == 3 ) && ( interval->softL2.data != 0 ) ) {	/* soft bound penalized; cannot occur without soft bounds */
+		hii += interval->softL2.data[ii];
+	}
+	if ( hii < qpData->options.QPDUNES_ZERO ) {
+		return -1.;
+	}
 
-	xn2x_matrix_t* hessian = &(qpData->hessian);
-	xn2x_matrix_t* cholHessian = &(qpData->cholHessian);
+	return 1. / hii;
+}
+/*<<< END OF qpDUNES_getNewtonBlockWeight */
 
-	/* Try to factorize Newton Hessian, to check if positive definite */
-	switch (qpData->options.nwtnHssnFacAlg) {
-		case QPDUNES_NH_FAC_BAND_FORWARD:
-			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, hessian, isHessianRegularized );
-			break;
 
-		case QPDUNES_NH_FAC_BAND_REVERSE:
-			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, lastActSetChangeIdx, isHessianRegularized );
-			break;
+/* ----------------------------------------------
+ * update diagonal Newton Hessian block kk,
+ *   E_{k+1} P_{k+1} E_{k+1}' + C_{k} P_{k} C_{k}',
+ * for clipping stages with diagonal Hessians: P only changes by the
+ * weights of flipped bounds, giving a diagonal correction from stage
+ * kk+1 and a rank-one term c_l*c_l' per flipped variable l of stage kk;
+ * returns false if the block has to be rebuilt instead
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_updateNewtonHessianBlock(	qpData_t* const qpData,
+											xn2x_matrix_t* const hessian,
+											int_t kk
+											)
+{
+	int_t ii, jj, ll;
+	int_t nFlipped = 0;
+	int_t nXK1 = _NX(kk+1);
+	real_t dw;
+	real_t wPrev, wCurr;
+	actSetWord_t statPrev, statCurr;
+
+	interval_t* interval = qpData->intervals[kk];
+	interval_t* intervalK1 = qpData->intervals[kk+1];
+	xz_matrix_t* C = &(interval->C);
+	int_t nV = interval->nV;		/* for accC */
+
+	if ( ( qpDUNES_isNewtonBlockUpdatable( qpData, interval ) == QPDUNES_FALSE ) ||
+		 ( qpDUNES_isNewtonBlockUpdatable( qpData, intervalK1 ) == QPDUNES_FALSE ) ||
+		 ( qpData->nwtnBlockUpdateCount[kk] >= qpData->options.maxNumNewtonBlockUpdates ) )
+	{
+		return QPDUNES_FALSE;
+	}
 
-		default:
-			qpDUNES_printError(qpData, __FILE__, __LINE__, "Unknown Newton Hessian factorization algorithm.");
-			return QPDUNES_ERR_INVALID_ARGUMENT;
+	/* updates only pay off for few flipped bounds */
+	for (ll = 0; ll < nV; ++ll) {
+		if ( qpDUNES_getActSetStatus( &(interval->actSet), ll, QPDUNES_FALSE ) != qpDUNES_getActSetStatus( &(interval->actSet), ll, QPDUNES_TRUE ) ) {
+			++nFlipped;
+		}
+	}
+	if ( 2 * nFlipped > nV ) {
+		return QPDUNES_FALSE;
 	}
 
-	/* check maximum diagonal element */
-	if (statusFlag == QPDUNES_OK) {
-		for (kk = 0; kk < _NI_; ++kk) {
-			for (ii = 0; ii < _NX_; ++ii) {
-/*				if (minDiagElem > fabs(accCholHessian(kk, 0, ii, ii)) ) {
-					minDiagElem = fabs( accCholHessian(kk, 0, ii, ii) );*/
-				if (minDiagElem > accCholHessian(kk, 0, ii, ii) ) {
-					minDiagElem = accCholHessian(kk, 0, ii, ii);
-				}
+	/* remove regularization of the last factorization */
+	for (jj = 0; jj < nXK1; ++jj) {
+		accHessian( kk, 0, jj, jj ) -= qpData->regShift[kk];
+	}
+	qpData->regShift[kk] = 0.;
+
+	/* EPE part: diagonal correction by the state variables of stage kk+1 */
+	for (ii = 0; ii < nXK1; ++ii) {
+		statPrev = qpDUNES_getActSetStatus( &(intervalK1->actSet), ii, QPDUNES_TRUE );
+		statCurr = qpDUNES_getActSetStatus( &(intervalK1->actSet), ii, QPDUNES_FALSE );
+		if ( statPrev != statCurr ) {
+			wPrev = qpDUNES_getNewtonBlockWeight( qpData, intervalK1, ii, statPrev );
+			wCurr = qpDUNES_getNewtonBlockWeight( qpData, intervalK1, ii, statCurr );
+			if ( ( wPrev < 0. ) || ( wCurr < 0. ) ) {
+				return QPDUNES_FALSE;	/* rebuild reports the singular stage Hessian */
 			}
+			accHessian( kk, 0, ii, ii ) += wCurr - wPrev;
 		}
 	}
-	#ifdef __DEBUG__
-		if (qpData->options.printLevel >= 4) {
-			qpDUNES_printf( "Minimum NH diagonal element: % .5e", minDiagElem );
-		}
-	#endif
 
-
-	if ( ( statusFlag == QPDUNES_ERR_DIVISION_BY_ZERO ) || 					/* regularize if Cholesky failed */
-		 ( minDiagElem < qpData->options.newtonHessDiagRegTolerance ) ) 	/* or if diagonal elements are too small */
-	{
-		switch (qpData->options.regType) {
-		case QPDUNES_REG_LEVENBERG_MARQUARDT:
-			for (kk = 0; kk < _NI_; ++kk) {
-				for (jj = 0; jj < _NX_; ++jj) {
-					accHessian( kk, 0, jj, jj )+= qpData->options.regParam;
-				}
+	/* CPC part: rank-one correction per flipped variable of stage kk */
+	for (ll = 0; ll < nV; ++ll) {
+		statPrev = qpDUNES_getActSetStatus( &(interval->actSet), ll, QPDUNES_TRUE );
+		statCurr = qpDUNES_getActSetStatus( &(interval->actSet), ll, QPDUNES_FALSE );
+		if ( statPrev == statCurr ) {
+			continue;
+		}
+		wPrev = qpDUNES_getNewtonBlockWeight( qpData, interval, ll, statPrev );
+		wCurr = qpDUNES_getNewtonBlockWeight( qpData, interval, ll, statCurr );
+		if ( ( wPrev < 0. ) || ( wCurr < 0. ) ) {
+			return QPDUNES_FALSE;
+		}
+		dw = wCurr - wPrev;
+		for (ii = 0; ii < nXK1; ++ii) {
+			for (jj = 0; jj <= ii; ++jj) {
+				accHessian( kk, 0, ii, jj ) += dw * accC(ii,ll) * accC(jj,ll);
 			}
-			break;
-
-			case QPDUNES_REG_NORMALIZED_LEVENBERG_MARQUARDT :
-			qpDUNES_printError(qpData, __FILE__, __LINE__, "QPDUNES_REG_NORMALIZED_LEVENBERG_MARQUARDT is deprecated.");
-			break;
+		}
+	}
+	++qpData->nwtnBlockUpdateCount[kk];
 
-			case QPDUNES_REG_SINGULAR_DIRECTIONS :
-			/* already done inside factorization, we do not get here anyways */
-			return QPDUNES_OK;
+	#ifdef __DEBUG__
+	if (qpData->options.printLevel >= 4) {
+		qpDUNES_printf("updated diagonal block %d of %d (%d flipped bounds)", kk, _NI_-1, nFlipped);
+	}
+	#endif
 
-			case QPDUNES_REG_UNCONSTRAINED_HESSIAN :
-			qpDUNES_printError( qpData, __FILE__, __LINE__, "Regularization with unconstrained Hessian not yet implemented." );
-			return QPDUNES_ERR_UNKNOWN_ERROR;
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_updateNewtonHessianBlock */
 
-			case QPDUNES_REG_GRADIENT_STEP :
-			*isHessianRegularized = QPDUNES_TRUE;
-			return QPDUNES_ERR_DIVISION_BY_ZERO;
 
-			default:
-			qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown regularization type.");
-			break;
-		}
-		*isHessianRegularized = QPDUNES_TRUE;
+/* ----------------------------------------------
+ * update sub-diagonal Newton Hessian block kk, -C_{k} P_{k} E_{k}',
+ * for a clipping stage with diagonal Hessian: only the columns of
+ * flipped state bounds change, and are rewritten exactly
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_updateNewtonHessianSubDiagBlock(	qpData_t* const qpData,
+													xn2x_matrix_t* const hessian,
+													int_t kk
+													)
+{
+	int_t ii, jj;
+	int_t nXK = _NX(kk);
+	real_t wCurr;
+	actSetWord_t statCurr;
 
-		/* refactor Newton Hessian */
-		switch (qpData->options.nwtnHssnFacAlg) {
-			case QPDUNES_NH_FAC_BAND_FORWARD:
-			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, hessian, isHessianRegularized );
-			break;
+	interval_t* interval = qpData->intervals[kk];
+	xz_matrix_t* C = &(interval->C);
+	int_t nV = interval->nV;		/* for accC */
 
-			case QPDUNES_NH_FAC_BAND_REVERSE:
-			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, _NI_+1, isHessianRegularized );	/* refactor full hessian */
-			break;
+	if ( qpDUNES_isNewtonBlockUpdatable( qpData, interval ) == QPDUNES_FALSE ) {
+		return QPDUNES_FALSE;
+	}
 
-			default:
-			qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown Newton Hessian factorization algorithm." );
-			return QPDUNES_ERR_INVALID_ARGUMENT;
+	for (jj = 0; jj < nXK; ++jj) {
+		statCurr = qpDUNES_getActSetStatus( &(interval->actSet), jj, QPDUNES_FALSE );
+		if ( statCurr == qpDUNES_getActSetStatus( &(interval->actSet), jj, QPDUNES_TRUE ) ) {
+			continue;
 		}
-		if ( statusFlag != QPDUNES_OK ) {
-			qpDUNES_printError( qpData, __FILE__, __LINE__, "Regularization of Newton Hessian failed." );
-			return statusFlag;
+		wCurr = qpDUNES_getNewtonBlockWeight( qpData, interval, jj, statCurr );
+		if ( wCurr < 0. ) {
+			return QPDUNES_FALSE;
 		}
-	}
-	else {
-		if ( statusFlag != QPDUNES_OK ) {
-			qpDUNES_printError( qpData, __FILE__, __LINE__, "Factorization of Newton Hessian failed for unknown reason." );
-			return statusFlag;
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			accHessian( kk, -1, ii, jj ) = - accC(ii,jj) * wCurr;
 		}
 	}
 
-	return QPDUNES_OK;
+	return QPDUNES_TRUE;
 }
-/*<<< END OF qpDUNES_factorNewtonSystem */
+/*<<< END OF qpDUNES_updateNewtonHessianSubDiagBlock */
 
 
 /* ----------------------------------------------
- * Special block tridiagonal Cholesky for special storage format of Newton matrix
- * 
+ * cached Newton Hessian contributions of a clipping stage with
+ * diagonal Hessian for its current active set; computed and inserted
+ * on a miss, replacing the least recently used entry of a full
+ * cache; returns 0 if the stage is not cached
+ *
  >>>>>>                                           */
-return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
-									  xn2x_matrix_t* const cholHessian,
-									  xn2x_matrix_t* const hessian,
-									  boolean_t* isHessianRegularized
-									  )
+real_t* qpDUNES_lookupProjCache(	qpData_t* const qpData,
+									interval_t* const interval
+									)
 {
-	int_t jj, ii, kk, ll;
-	real_t sum;
+	int_t ii, ee;
+	int_t slot = 0;
+	int_t nWords = interval->actSet.nWords;
 
-	/* TEMPORARY*/
-	real_t colMax;
-	real_t colSum;
-	/* END TEMPORARY*/
+	projCache_t* cache = &(interval->projCache);
 
-	/* go by block columns */
-	for (kk = 0; kk < _NI_; ++kk) {
-		/* go by in-block columns */
-		for (jj = 0; jj < _NX_; ++jj) {
-			/* 1) compute diagonal element: ii == jj */
-			/* take diagonal element of original */
-			sum = accHessian(kk,0,jj,jj);
+	if ( ( cache->capacity <= 0 ) ||
+		 ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING ) ||
+		 ( ( interval->H.sparsityType != QPDUNES_DIAGONAL ) && ( interval->H.sparsityType != QPDUNES_IDENTITY ) ) )
+	{
+		return 0;
+	}
 
-			/* subtract squared forepart of corresponding row: */
-			/*  - this diagonal block */
-			for( ll = 0; ll < jj; ++ll ) {
-				sum -= accCholHessian(kk,0,jj,ll) * accCholHessian(kk,0,jj,ll);
-			}
-			/*  - this row's subdiagonal block */
-			if( kk > 0 ) { /* for all block columns but the first one */
-				for( ll = 0; ll < _NX_; ++ll ) {
-					sum -= accCholHessian(kk,-1,jj,ll) * accCholHessian(kk,-1,jj,ll);
-				}
-			}
-			
+	++cache->clock;
 
-			/* 2) check for too small diagonal elements */
-			if((qpData->options.regType == QPDUNES_REG_SINGULAR_DIRECTIONS) &&	/* Add regularization on too small values already in factorization */
-			   (sum < qpData->options.newtonHessDiagRegTolerance) ) 		/* TODO: take branching in options.regType out of the loop if too slow */
-			{
-				/* FIXME: maybe log which elements were regularized */
-				#ifdef __DEBUG__
-				if ( qpData->options.printLevel >= 3 ) {
-					qpDUNES_printf( "Regularized NH[k=%d,j=%d] = %.2e + %.2e", kk, jj, sum, qpData->options.regParam );
-				}
-				#endif
-/*				sum += qpData->options.regParam;*/
-				sum += qpData->options.QPDUNES_INFTY * qpData->options.QPDUNES_INFTY + 1.;
-				*isHessianRegularized = QPDUNES_TRUE;
-			}
-			else {
-				if ( sum < qpData->options.newtonHessDiagRegTolerance ) {	/* matrix not positive definite */
-					return QPDUNES_ERR_DIVISION_BY_ZERO;
-				}
+	for (ee = 0; ee < cache->nEntries; ++ee) {
+		if ( cache->dataVersion[ee] != interval->dataVersion ) {
+			continue;
+		}
+		for (ii = 0; ii < nWords; ++ii) {
+			if ( cache->bits[ee * nWords + ii] != interval->actSet.bits[ii] ) {
+				break;
 			}
-			accCholHessian(kk,0,jj,jj) = sqrt( sum );
-			
-			/* TEMPORARY*/
-			colMax = 0.;
-			colSum = 0.;
-			/* END TEMPORARY*/
-
-			/* 3) write remainder of jj-th column: */		/* TODO: think about how we can avoid this column-wise access and postpone until the respective element is needed */
-			/*  - this diagonal block */
-			for( ii=(jj+1); ii<_NX_; ++ii )
-			{
-				sum = accHessian(kk,0,ii,jj);
-				
-				/* subtract forepart of this row times forepart of jj-th row */
-				/*  - diagonal block */
-				for( ll = 0; ll < jj; ++ll ) {	
-					sum -= accCholHessian(kk,0,ii,ll) * accCholHessian(kk,0,jj,ll);
-				}
-				/*  - subdiagonal block */
-				if( kk > 0 ) {	/* for all block columns but the first one */
-					for( ll = 0; ll < _NX_; ++ll ) {
-						sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
-					}
-				}
-				
-				/* TEMPORARY */
-				if (colMax<fabs(sum)) colMax =fabs(sum);
-				colSum += fabs(accHessian(kk,0,ii,jj));
-				/* END TEMPORARY */
+		}
+		if ( ii == nWords ) {
+			cache->lastUse[ee] = cache->clock;
+			++qpData->log.numProjCacheHits;
+			return &(cache->data[ee * cache->entrySize]);
+		}
+	}
 
-				accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+	/* miss: fill a free entry or evict the least recently used one */
+	if ( cache->nEntries < cache->capacity ) {
+		slot = cache->nEntries;
+	}
+	else {
+		for (ee = 1; ee < cache->nEntries; ++ee) {
+			if ( cache->lastUse[ee] < cache->lastUse[slot] ) {
+				slot = ee;
 			}
-			/*  - following row's subdiagonal block */
-			if( kk < _NI_-1 ) {	/* for all block columns but the last one */
-				for( ii=0; ii<_NX_; ++ii )
-				{
-					sum = accHessian(kk+1,-1,ii,jj);
-					
-					/* subtract forepart of this row times forepart of jj-th row (only this block is non-zero) */
-					for( ll = 0; ll < jj; ++ll ) {	
-						sum -= accCholHessian(kk+1,-1,ii,ll) * accCholHessian(kk,0,jj,ll);
-					}
-					
-					/* TEMPORARY */
-					if (colMax<fabs(sum)) colMax =fabs(sum);
-					colSum += fabs(accHessian(kk+1,-1,ii,jj));
-					/* END TEMPORARY */
+		}
+	}
 
-					accCholHessian(kk+1,-1,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
-				}
+	if ( qpDUNES_computeStageProjections( qpData, interval, &(cache->data[slot * cache->entrySize]) ) != QPDUNES_OK ) {
+		/* drop the overwritten entry; the full rebuild reports the error */
+		if ( slot < cache->nEntries ) {
+			--cache->nEntries;
+			cache->dataVersion[slot] = cache->dataVersion[cache->nEntries];
+			cache->lastUse[slot] = cache->lastUse[cache->nEntries];
+			for (ii = 0; ii < nWords; ++ii) {
+				cache->bits[slot * nWords + ii] = cache->bits[cache->nEntries * nWords + ii];
 			}
-		} /* next column */
-		} /* next block column */
+			for (ii = 0; ii < cache->entrySize; ++ii) {
+				cache->data[slot * cache->entrySize + ii] = cache->data[cache->nEntries * cache->entrySize + ii];
+			}
+		}
+		return 0;
+	}
 
-/*	qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, isHessianRegularized );*/
+	cache->dataVersion[slot] = interval->dataVersion;
+	cache->lastUse[slot] = cache->clock;
+	for (ii = 0; ii < nWords; ++ii) {
+		cache->bits[slot * nWords + ii] = interval->actSet.bits[ii];
+	}
+	if ( slot == cache->nEntries ) {
+		++cache->nEntries;
+	}
+	++qpData->log.numProjCacheMisses;
 
-	return QPDUNES_OK;
+	return &(cache->data[slot * cache->entrySize]);
 }
-/*<<< END OF qpDUNES_factorizeNewtonHessian */
+/*<<< END OF qpDUNES_lookupProjCache */
+
 
 /* ----------------------------------------------
- * Bottom-up block-tridiagonal Cholesky for special storage format of Newton matrix
+ * Newton Hessian contributions of a clipping stage for its current
+ * multipliers, with the kernels of the full block setup: E P E' and
+ * C P C' as packed lower triangles, followed by -C P E'
  *
  >>>>>>                                           */
-return_t qpDUNES_factorizeNewtonHessianBottomUp( qpData_t* const qpData,
-											  xn2x_matrix_t* const cholHessian,
-											  xn2x_matrix_t* const hessian,
-											  int_t lastActSetChangeIdx, 			/**< index from where the reverse factorization is restarted */
-											  boolean_t* isHessianRegularized
-											  )
+return_t qpDUNES_computeStageProjections(	qpData_t* const qpData,
+											interval_t* const interval,
+											real_t* const entry
+											)
 {
-	int_t jj, ii, kk, ll;
-	real_t sum;
+	int_t ii, jj;
+	int_t kk = interval->id;
+	int_t nXK = interval->nX;
+	int_t nXK1 = ( kk < _NI_ ) ? _NX(kk+1) : 0;
 
-	int_t blockIdxStart = (lastActSetChangeIdx>=0)  ?  qpDUNES_min(lastActSetChangeIdx, _NI_-1)  :  -1;
-/*	int_t blockIdxStart = _NI_-1; */
+	real_t* EPE = entry;
+	real_t* CPC = EPE + nXK * (nXK + 1) / 2;
+	real_t* CPE = CPC + nXK1 * (nXK1 + 1) / 2;
 
-	#ifdef __DEBUG__
-	if (qpData->options.printLevel >= 3) {
-		qpDUNES_printf( "Restarting reverse Cholesky factorization at block %d of %d", blockIdxStart, _NI_-1 );
-	}
-	#endif
+	xx_matrix_t* xxMatTmp = &(qpData->xxMatTmp);
+	vv_matrix_t* hessFactor = clippingQpSolver_getNewtonHessianFactor( interval );
+	d2_vector_t* y = &(interval->y);
 
-	/* go by block columns */
-	for (kk = blockIdxStart; kk >= 0; --kk) {
-		/* go by in-block columns */
-		for (jj = _NX_ - 1; jj >= 0; --jj) {
-			/* 1) compute diagonal element: ii == jj */
-			/* take diagonal element of original */
-			sum = accHessian(kk,0,jj,jj);
+	return_t statusFlag;
 
-			/* subtract squared rearpart of corresponding row (transposed access, therefore rest of column): */
-			/*  - this diagonal block */
-			for( ll = jj+1; ll < _NX_; ++ll ) {
-				/* TODO: get rid of transposed access...maybe start to save Hessian also in upper triangular format */
-				sum -= accCholHessian(kk,0,ll,jj) * accCholHessian(kk,0,ll,jj); /* transposed access */
-			}
-			/*  - this row's subdiagonal block */
-			if( kk < _NI_-1 ) { /* for all block columns but the last one */
-				for( ll = 0; ll < _NX_; ++ll ) {
-					sum -= accCholHessian(kk+1,-1,ll,jj) * accCholHessian(kk+1,-1,ll,jj);	/* transposed access */
-				}
-			}
+	/* E P E', columns of active state bounds vanish */
+	statusFlag = getInvQ( qpData, xxMatTmp, hessFactor, interval->nV );
+	if (statusFlag != QPDUNES_OK)
+		return statusFlag;
+	statusFlag = qpDUNES_makeMatrixDense( xxMatTmp, nXK, nXK );
+	if (statusFlag != QPDUNES_OK)
+		return statusFlag;
+	for (ii = 0; ii < nXK; ++ii) {
+		for (jj = 0; jj < ii; ++jj) {
+			EPE[ii * (ii + 1) / 2 + jj] = xxMatTmp->data[ii * nXK + jj];
+		}
+		if ( (y->data[2 * ii] >= qpData->options.equalityTolerance) ||
+			 (y->data[2 * ii + 1] >= qpData->options.equalityTolerance) )
+		{
+			EPE[ii * (ii + 1) / 2 + ii] = 0.;
+		}
+		else {
+			EPE[ii * (ii + 1) / 2 + ii] = xxMatTmp->data[ii * nXK + ii];
+		}
+	}
 
+	if ( kk < _NI_ ) {
+		/* C P C' */
+		for (ii = 0; ii < nXK1 * nXK1; ++ii) {
+			xxMatTmp->data[ii] = 0.;
+		}
+		xxMatTmp->sparsityType = QPDUNES_DENSE;
+		statusFlag = addCInvHCT( qpData, xxMatTmp, hessFactor, &(interval->C), y, &(qpData->xxMatTmp2), &(qpData->uxMatTmp), &(qpData->zxMatTmp), nXK1, interval->nV );
+		if (statusFlag != QPDUNES_OK)
+			return statusFlag;
+		for (ii = 0; ii < nXK1; ++ii) {
+			for (jj = 0; jj <= ii; ++jj) {
+				CPC[ii * (ii + 1) / 2 + jj] = xxMatTmp->data[ii * nXK1 + jj];
+			}
+		}
 
-			/* 2) check for too small diagonal elements */
-			if ( (qpData->options.regType == QPDUNES_REG_SINGULAR_DIRECTIONS) &&	/* Add regularization on too small values already in factorization */
-			     (sum < qpData->options.newtonHessDiagRegTolerance) ) 		/* TODO: take branching in options.regType out of the loop if too slow */
-			{
-				sum += qpData->options.regParam;
-				*isHessianRegularized = QPDUNES_TRUE;
-				#ifdef __DEBUG__
-				if (sum < qpData->options.newtonHessDiagRegTolerance) {
-					qpDUNES_printError( qpData, __FILE__, __LINE__, "On-the-fly regularization failed. Your problem might be too ill-conditioned.");
-					return QPDUNES_ERR_DIVISION_BY_ZERO;
+		/* -C P E', columns of active state bounds vanish */
+		statusFlag = multiplyAInvQ( qpData, xxMatTmp, &(interval->C), hessFactor, nXK1, nXK, interval->nV );
+		if (statusFlag != QPDUNES_OK)
+			return statusFlag;
+		for (ii = 0; ii < nXK1; ++ii) {
+			for (jj = 0; jj < nXK; ++jj) {
+				if ( (y->data[2 * jj] <= qpData->options.equalityTolerance) &&
+					 (y->data[2 * jj + 1] <= qpData->options.equalityTolerance) )
+				{
+					CPE[ii * nXK + jj] = - xxMatTmp->data[ii * nXK + jj];
 				}
-				#endif
-			}
-			else {
-				if ( sum < 1.e2*qpData->options.equalityTolerance ) {	/* matrix not positive definite */
-					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				else {
+					CPE[ii * nXK + jj] = 0.;
 				}
 			}
+		}
+	}
 
-			accCholHessian(kk,0,jj,jj) = sqrt( sum );
+	/* leave workspace clean for the full block setup */
+	for (ii = 0; ii < qpDUNES_max( nXK * nXK, nXK1 * nXK1 ); ++ii) {
+		xxMatTmp->data[ii] = 0.;
+	}
 
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_computeStageProjections */
 
-			/* 3) write remainder of jj-th column (upwards! via transposed access: jj-th row, leftwards): */
-			/*  - this diagonal block */
-			for( ii=jj-1; ii>=0; --ii )
-			{
-				sum = accHessian(kk,0,jj,ii);	/* transposed access */
 
-				/* subtract rear part of this row times rear part of jj-th row */
-				/*  - diagonal block */
-				for( ll = jj+1; ll < _NX_; ++ll ) {
-					sum -= accCholHessian(kk,0,ll,ii) * accCholHessian(kk,0,ll,jj);		/* transposed access */
-				}
-				/*  - subdiagonal block */
-				if( kk < _NI_-1 ) {	/* for all block rows but the last one */
-					for( ll = 0; ll < _NX_; ++ll ) {
-						sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);	/* transposed access */
-					}
-				}
+/* ----------------------------------------------
+ * diagonal Newton Hessian block kk from the cached contributions
+ * E_{k+1} P_{k+1} E_{k+1}' and C_{k} P_{k} C_{k}'; returns false if
+ * one of them is not cached
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_getCachedNewtonHessianBlock(	qpData_t* const qpData,
+												xn2x_matrix_t* const hessian,
+												int_t kk
+												)
+{
+	int_t ii, jj;
+	int_t nXK1 = _NX(kk+1);
 
-				/* write transposed! (otherwise it's upper triangular matrix) */
-				accCholHessian(kk,0,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
-			}
-			/*  - following row's subdiagonal block */
-			if( kk > 0 ) {	/* for all block rows but the first one */
-				for( ii=_NX_-1; ii>=0; --ii )
-				{
-					sum = accHessian(kk,-1,jj,ii);	/* transposed access */
+	const real_t* EPE = qpData->intervals[kk+1]->projCache.curEntry;
+	const real_t* CPC;
 
-					/* subtract rear part of this row times rear part of jj-th row (only this block is non-zero) */
-					for( ll = jj+1; ll < _NX_; ++ll ) {
-						sum -= accCholHessian(kk,-1,ll,ii) * accCholHessian(kk,0,ll,jj);	/* transposed access */
-					}
+	if ( ( qpData->intervals[kk]->projCache.curEntry == 0 ) || ( EPE == 0 ) ) {
+		return QPDUNES_FALSE;
+	}
+	CPC = qpData->intervals[kk]->projCache.curEntry + _NX(kk) * (_NX(kk) + 1) / 2;
 
-					/* write transposed! (otherwise it's upper triangular matrix) */
-					accCholHessian(kk,-1,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
-				}
-			}
-		} /* next column */
-	} /* next block column */
+	for (ii = 0; ii < nXK1; ++ii) {
+		for (jj = 0; jj <= ii; ++jj) {
+			accHessian( kk, 0, ii, jj ) = EPE[ii * (ii + 1) / 2 + jj] + CPC[ii * (ii + 1) / 2 + jj];
+		}
+	}
+	qpData->regShift[kk] = 0.;
+	qpData->nwtnBlockUpdateCount[kk] = 0;
 
+	#ifdef __DEBUG__
+	if (qpData->options.printLevel >= 4) {
+		qpDUNES_printf("cached diagonal block %d of %d", kk, _NI_-1);
+	}
+	#endif
 
-	return QPDUNES_OK;
+	return QPDUNES_TRUE;
 }
-/*<<< END OF qpDUNES_factorizeNewtonHessianBottomUp */
-
+/*<<< END OF qpDUNES_getCachedNewtonHessianBlock */
 
 
 /* ----------------------------------------------
- * special backsolve for block tridiagonal Newton matrix
- * 
+ * sub-diagonal Newton Hessian block kk, -C_{k} P_{k} E_{k}', from
+ * the cached contributions of stage kk; returns false if not cached
+ *
  >>>>>>                                           */
-return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
-									xn_vector_t* const res,
-									const xn2x_matrix_t* const cholHessian, /**< lower triangular Newton Hessian factor */
-									const xn_vector_t* const gradient	)
+boolean_t qpDUNES_getCachedNewtonHessianSubDiagBlock(	qpData_t* const qpData,
+														xn2x_matrix_t* const hessian,
+														int_t kk
+														)
 {
-	int_t ii, jj, kk;
+	int_t ii, jj;
+	int_t nXK = _NX(kk);
+	int_t nXK1 = _NX(kk+1);
 
-	real_t sum;
+	const real_t* CPE;
 
-	/* solve L*x = g */
-	for (kk = 0; kk < _NI_; ++kk) /* go by block rows top down */
-	{
-		for (ii = 0; ii < _NX_; ++ii) /* go by in-block rows top down */
-		{
-			sum = gradient->data[kk * _NX_ + ii];
-			/* subtract all previously resolved unknowns ... */
-			if (kk > 0) { /* ... of corresponding subdiagonal block (if not first block row) */
-				for (jj = 0; jj < _NX_; ++jj) {
-					sum -= accCholHessian(kk,-1,ii,jj)* res->data[(kk-1)*_NX_+jj];
-				}
-			}
-			for (jj = 0; jj < ii; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,ii,jj)* res->data[kk*_NX_+jj];
-			}
+	if ( qpData->intervals[kk]->projCache.curEntry == 0 ) {
+		return QPDUNES_FALSE;
+	}
+	CPE = qpData->intervals[kk]->projCache.curEntry + nXK * (nXK + 1) / 2 + nXK1 * (nXK1 + 1) / 2;
 
-			/* divide by diagonal element */
-			#if defined(__USE_ASSERTS__)
-			if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
-				qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
-				return QPDUNES_ERR_DIVISION_BY_ZERO;
-			}
-			#endif
-			/* temporarily to try Wright1999 */
-			if (accCholHessian(kk,0,ii,ii)> qpData->options.QPDUNES_INFTY) {
-				res->data[kk*_NX_+ii] = 0.;
-			}
-			else {
-				res->data[kk*_NX_+ii] = sum / accCholHessian(kk,0,ii,ii);
-			}
+	for (ii = 0; ii < nXK1; ++ii) {
+		for (jj = 0; jj < nXK; ++jj) {
+			accHessian( kk, -1, ii, jj ) = CPE[ii * nXK + jj];
 		}
 	}
 
-	/* solve L^T*res = x */
-	for (kk = (_NI_ - 1); kk >= 0; --kk) /* go by block rows bottom up */
-	{
-		for (ii = (_NX_ - 1); ii >= 0; --ii) /* go by in-block rows top down */
-		{
-			sum = res->data[kk * _NX_ + ii]; /* intermediate result of first backsolve is stored in res */
-			/* subtract all previously resolved unknowns ... */
-			for (jj = ii + 1; jj < _NX_; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,jj,ii)* res->data[kk*_NX_+jj];
-			}
-			if (kk < _NI_ - 1) { /* ... of corresponding superdiagonal block, access via following row's subdiagonal block (if not first block row from bottom) */
-				for (jj = 0; jj < _NX_; ++jj) {
-					sum -= accCholHessian(kk+1,-1,jj,ii)* res->data[(kk+1)*_NX_+jj];
-				}
-			}
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_getCachedNewtonHessianSubDiagBlock */
 
-			/* divide by diagonal element */
-			#if defined(__USE_ASSERTS__)
-				if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
-					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
-					return QPDUNES_ERR_DIVISION_BY_ZERO;
-				}
-			#endif
-			res->data[kk * _NX_ + ii] = sum / accCholHessian(kk,0,ii,ii);
-		}
+
+/* ----------------------------------------------
+ * get the dual gradient at the current lambda; reuses the evaluation
+ * of the line search at the accepted step if available
+ *
+ >>>>>>                                           */
+return_t qpDUNES_getNewtonGradient(	qpData_t* const qpData
+									)
+{
+	real_t* tmp;
+
+	if (qpData->lsGradientIsValid == QPDUNES_TRUE) {
+		/* swap memory instead of copying */
+		tmp = qpData->gradient.data;
+		qpData->gradient.data = qpData->lsGradient.data;
+		qpData->lsGradient.data = tmp;
+		qpData->lsGradientIsValid = QPDUNES_FALSE;
+		return QPDUNES_OK;
 	}
 
-	return QPDUNES_OK;
+	return qpDUNES_computeNewtonGradient(qpData, &(qpData->gradient), &(qpData->xVecTmp));
 }
-/*<<< END OF qpDUNES_solveNewtonEquation */
+/*<<< END OF qpDUNES_getNewtonGradient */
 
 
 /* ----------------------------------------------
- * special backsolve for backwards factorized block tridiagonal Newton matrix
+ * ...
  *
- >>>>>>                                           */
-return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
-											xn_vector_t* const res,
-											const xn2x_matrix_t* const cholHessian, /**< lower triangular Newton Hessian factor */
-											const xn_vector_t* const gradient	)
-{
-	int_t ii, jj, kk;
+ *   Gradient blocks between two stages that did not move in the last
+ *   step are kept from the previous evaluation in gradient.
+ *
+ * >>>>>>                                           */
+return_t qpDUNES_computeNewtonGradient(qpData_t* const qpData, xn_vector_t* gradient,
+		x_vector_t* gradPiece) {
+	int_t kk, ii;
 
-	real_t sum;
+	interval_t** intervals = qpData->intervals;
 
-	/* solve L^T*x = g */
-	for (kk = (_NI_ - 1); kk >= 0; --kk) /* go by block rows bottom up */
-	{
-		for (ii = (_NX_ - 1); ii >= 0; --ii) /* go by in-block rows top down */
-		{
-			sum = gradient->data[kk * _NX_ + ii];
-			/* subtract all previously resolved unknowns ... */
-			for (jj = ii + 1; jj < _NX_; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,jj,ii)* res->data[kk*_NX_+jj]; /* transposed access */
-			}
-			if (kk < _NI_ - 1) { /* ... of corresponding superdiagonal block, access via following row's subdiagonal block (if not first block row from bottom) */
-				for (jj = 0; jj < _NX_; ++jj) {
-					sum -= accCholHessian(kk+1,-1,jj,ii)* res->data[(kk+1)*_NX_+jj];/* TODO: maybe change access pattern, start with superdiag block, so cholH access is more continuous*/
-				}
-			}
+	/* d/(d lambda_ii) for kk=0.._NI_-1; blocks are independent */
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(kk, ii) firstprivate(gradPiece) schedule(static)
+	#endif
+	for (kk = 0; kk < _NI_; ++kk) {
+		if ( (intervals[kk]->lambdaHasChanged == QPDUNES_FALSE) && (intervals[kk+1]->lambdaHasChanged == QPDUNES_FALSE) ) {
+			continue;
+		}
+		#ifdef __QPDUNES_PARALLEL__
+		gradPiece = &(intervals[kk]->xVecTmp);	/* stage workspace instead of the shared one */
+		#endif
 
-			/* divide by diagonal element */
-			#if defined(__USE_ASSERTS__)
-				if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
-					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
-					return QPDUNES_ERR_DIVISION_BY_ZERO;
-				}
-			#endif
-			res->data[kk * _NX_ + ii] = sum / accCholHessian(kk,0,ii,ii);
+		/* ( C_kk*z_kk^opt + c_kk ) - x_(kk+1)^opt */
+		multiplyCz(gradPiece, &(intervals[kk]->C), &(intervals[kk]->z), _NX(kk+1), intervals[kk]->nV);
+		addToVector(gradPiece, &(intervals[kk]->c), _NX(kk+1));
+
+		/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX(kk+1) ); */
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			gradPiece->data[ii] -= intervals[kk + 1]->z.data[ii];
+		}
+
+		/* write gradient part */
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			gradient->data[_XNOFF(kk) + ii] = gradPiece->data[ii];
 		}
 	}
+	return QPDUNES_OK;
+}
+/*<<< END OF computeNewtonGradient */
 
-	/* solve L*res = x */
-	for (kk = 0; kk < _NI_; ++kk) /* go by block rows top down */
-	{
-		for (ii = 0; ii < _NX_; ++ii) /* go by in-block rows top down */
-		{
-			sum = res->data[kk * _NX_ + ii]; /* intermediate result of first backsolve is stored in res */
-			/* subtract all previously resolved unknowns ... */
-			if (kk > 0) { /* ... of corresponding subdiagonal block (if not first block row) */
-				for (jj = 0; jj < _NX_; ++jj) {
-					sum -= accCholHessian(kk,-1,ii,jj)* res->data[(kk-1)*_NX_+jj];
+
+return_t qpDUNES_factorNewtonSystem( qpData_t* const qpData,
+								  	 boolean_t* const isHessianRegularized,
+								  	 int_t lastActSetChangeIdx
+								  	 )
+{
+	#ifdef __DEBUG__
+	int_t ii, kk;
+	real_t minDiagElem = qpData->options.QPDUNES_INFTY;
+	#endif
+
+	int_t firstActSetChangeIdx;
+	return_t statusFlag;
+
+	xn2x_matrix_t* hessian = &(qpData->hessian);
+	xn2x_factor_t* cholHessian = &(qpData->cholHessian);
+
+	/* Try to factorize Newton Hessian, to check if positive definite */
+	switch (qpData->options.nwtnHssnFacAlg) {
+		case QPDUNES_NH_FAC_BAND_FORWARD:
+			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, hessian, 0, _NI_-1, isHessianRegularized );
+			break;
+
+		case QPDUNES_NH_FAC_BAND_REVERSE:
+			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, lastActSetChangeIdx, 0, isHessianRegularized );
+			break;
+
+		case QPDUNES_NH_PCG_BLOCK_JACOBI:
+			statusFlag = qpDUNES_factorizeNewtonHessianBlockJacobi( qpData, cholHessian, hessian, isHessianRegularized );
+			break;
+
+		case QPDUNES_NH_FAC_BAND_TWISTED:
+		case QPDUNES_NH_FAC_BAND_AUTO:
+			for (firstActSetChangeIdx = 0; firstActSetChangeIdx < _NI_ + 1; ++firstActSetChangeIdx) {
+				if (qpData->intervals[firstActSetChangeIdx]->actSetHasChanged == QPDUNES_TRUE) {
+					break;
 				}
 			}
-			for (jj = 0; jj < ii; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,ii,jj)* res->data[kk*_NX_+jj];
+			if (qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_AUTO) {
+				qpDUNES_updateNewtonFactorStats( qpData, firstActSetChangeIdx, lastActSetChangeIdx );
 			}
+			statusFlag = qpDUNES_factorizeNewtonHessianTwisted( qpData, cholHessian, hessian, firstActSetChangeIdx, lastActSetChangeIdx, isHessianRegularized );
+			break;
 
-			/* divide by diagonal element */
-			#if defined(__USE_ASSERTS__)
-				if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
-					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
-					return QPDUNES_ERR_DIVISION_BY_ZERO;
+		default:
+			qpDUNES_printError(qpData, __FILE__, __LINE__, "Unknown Newton Hessian factorization algorithm.");
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	#ifdef __DEBUG__
+	/* check minimum diagonal element */
+	if (statusFlag == QPDUNES_OK) {
+		for (kk = 0; kk < _NI_; ++kk) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				if (minDiagElem > accCholHessian(kk, 0, ii, ii) ) {
+					minDiagElem = accCholHessian(kk, 0, ii, ii);
 				}
-			#endif
-			res->data[kk * _NX_ + ii] = sum / accCholHessian(kk,0,ii,ii);
+			}
+		}
+	}
+	if (qpData->options.printLevel >= 4) {
+		qpDUNES_printf( "Minimum NH diagonal element: % .5e", minDiagElem );
+	}
+	#endif
+
+	/* all regularization is done inside the factorization, a breakdown here is final */
+	if ( statusFlag == QPDUNES_ERR_DIVISION_BY_ZERO ) {
+		switch (qpData->options.regType) {
+			case QPDUNES_REG_LEVENBERG_MARQUARDT:
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Newton Hessian block could not be regularized with shifts up to %.1e.", qpData->options.regParamMax );
+			break;
+
+			case QPDUNES_REG_NORMALIZED_LEVENBERG_MARQUARDT :
+			qpDUNES_printError(qpData, __FILE__, __LINE__, "QPDUNES_REG_NORMALIZED_LEVENBERG_MARQUARDT is deprecated.");
+			break;
+
+			case QPDUNES_REG_SINGULAR_DIRECTIONS :
+			case QPDUNES_REG_UNCONSTRAINED_HESSIAN :
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Pivot modification of Newton Hessian failed. Regularization parameter %.1e too small?", qpData->regParam );
+			break;
+
+			case QPDUNES_REG_GRADIENT_STEP :
+			*isHessianRegularized = QPDUNES_TRUE;
+			break;
+
+			default:
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown regularization type.");
+			break;
 		}
+		return QPDUNES_ERR_DIVISION_BY_ZERO;
+	}
+	if ( statusFlag != QPDUNES_OK ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Factorization of Newton Hessian failed for unknown reason." );
+		return statusFlag;
 	}
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_solveNewtonEquationBottomUp */
+/*<<< END OF qpDUNES_factorNewtonSystem */
 
 
 /* ----------------------------------------------
- * special multiplication routine for Newton Hessian with a vector
+ * Levenberg-Marquardt shift of a single diagonal Newton Hessian
+ * block whose factorization broke down; the first shift is the
+ * current regularization parameter, every further breakdown of the
+ * same block multiplies it by the adaptation factor
  *
  >>>>>>                                           */
-return_t qpDUNES_multiplyNewtonHessianVector(	qpData_t* const qpData,
-												xn_vector_t* const res,
-												const xn2x_matrix_t* const hessian, /**< Newton Hessian */
-												const xn_vector_t* const vec	)
+return_t qpDUNES_regularizeNewtonHessianBlock(	qpData_t* const qpData,
+												xn2x_matrix_t* const hessian,
+												int_t kk
+												)
 {
-	int_t ii, jj, kk;
-
-
-	for (kk = 0; kk < _NI_; ++kk) 			/* go by block rows top down */
-	{
-		/* empty full result vector chunk beforehand, needed for cache-efficient transposed multiplication */
-		for (ii = 0; ii < _NX_; ++ii)
-		{
-			res->data[kk * _NX_ + ii] = 0.0;
-		}
+	int_t jj;
+	real_t shift;
+	real_t growth = qpDUNES_fmax( qpData->options.regParamAdaptationFactor, 2. );	/* has to grow to terminate */
 
-		/* write result */
-		for (ii = 0; ii < _NX_; ++ii) 		/* go by in-block rows top down */
-		{
-			if (kk > 0)
-			{
-				/* go through subdiagonal block by columns */
-				for (jj = 0; jj < _NX_; ++jj)
-				{
-					res->data[kk*_NX_ + ii] += accHessian(kk,-1,ii,jj) * vec->data[(kk-1)*_NX_ + jj];
-				}
-			}
+	shift = qpDUNES_fmax( qpData->regParam, growth * qpData->regShift[kk] );
+	if ( shift > qpDUNES_fmax( qpData->options.regParamMax, qpData->options.regParam ) ) {
+		return QPDUNES_ERR_DIVISION_BY_ZERO;
+	}
 
-			/* go through diagonal block by columns */
-			for (jj = 0; jj < _NX_; ++jj)
-			{
-				res->data[kk*_NX_ + ii] += accHessian(kk,0,ii,jj) * vec->data[kk*_NX_ + jj];
-			}
+	#ifdef __DEBUG__
+	if ( qpData->options.printLevel >= 3 ) {
+		qpDUNES_printf( "Regularized NH block %d with shift %.2e", kk, shift );
+	}
+	#endif
 
-			if (kk < _NI_-1)
-			{
-				/* go through superdiagonal block by columns; transposed access though */
-				for (jj = 0; jj < _NX_; ++jj)
-				{
-					/* by-column multiplication for higher cache efficiency in Newton Hessian (transposed access of Newton Hessian) */
-					res->data[kk*_NX_ + jj] += accHessian(kk+1,-1,ii,jj) * vec->data[(kk+1)*_NX_ + ii];
-				}
-			}
-		} 	/* end of in-block rows */
-	}		/* end of block rows */
+	/* block may still contain a shift from an earlier iteration */
+	for (jj = 0; jj < _NX(kk+1); ++jj) {
+		accHessian( kk, 0, jj, jj ) += shift - qpData->regShift[kk];
+	}
+	qpData->regShift[kk] = shift;
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_multiplyNewtonHessianVector */
-
+/*<<< END OF qpDUNES_regularizeNewtonHessianBlock */
 
 
 /* ----------------------------------------------
- * ...
- * 
+ * adapt the regularization parameter to the quality of a
+ * regularized step, measured as ratio of the actual dual objective
+ * gain to the gain predicted by the regularized quadratic model,
+ * alpha*(1-alpha/2)*gradient'*deltaLambda
+ *
  >>>>>>                                           */
-return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
-									xn_vector_t* const lambda,
-									xn_vector_t* const deltaLambdaFS,
-									uint_t* const itCntr,
-									real_t* const alpha,
-									real_t* const objValIncumbent,
-									boolean_t newtonHessianRegularized
+void qpDUNES_adaptRegularization(	qpData_t* const qpData,
+									boolean_t isHessianRegularized,
+									real_t alpha,
+									real_t objValGain
 									)
 {
-	return_t statusFlag;
-	
-	int_t kk;
+	real_t factor = qpData->options.regParamAdaptationFactor;
+	real_t predictedGain;
+	real_t ratio;
+
+	if ( ( ( qpData->options.regType != QPDUNES_REG_LEVENBERG_MARQUARDT ) &&
+		   ( qpData->options.regType != QPDUNES_REG_SINGULAR_DIRECTIONS ) &&
+		   ( qpData->options.regType != QPDUNES_REG_UNCONSTRAINED_HESSIAN ) ) ||
+		 ( isHessianRegularized == QPDUNES_FALSE ) || ( factor <= 1. ) )
+	{
+		return;
+	}
 
-	interval_t* interval;
-	
-	int_t nV = _NX_ * _NI_;
+	predictedGain = alpha * ( 1. - 0.5 * alpha ) * scalarProd( &(qpData->gradient), &(qpData->deltaLambda), _NXTTL_ );
+	ratio = objValGain / qpDUNES_fmax( predictedGain, qpData->options.QPDUNES_ZERO );
+	if ( ratio > 0.75 ) {		/* model is trustworthy, regularize less */
+		qpData->regParam = qpDUNES_fmax( qpData->regParam / factor, qpData->options.regParamMin );
+	}
+	else if ( ratio < 0.25 ) {	/* model overestimates the gain, damp singular directions more */
+		qpData->regParam = qpDUNES_fmin( qpData->regParam * factor, qpData->options.regParamMax );
+	}
+}
+/*<<< END OF qpDUNES_adaptRegularization */
 
-	real_t alphaMin = 0.;
-	real_t alphaMax = 1.;
-	real_t alphaASChange = qpData->options.QPDUNES_INFTY;
 
-	xn_vector_t* lambdaTry = &(qpData->xnVecTmp);
+/* ----------------------------------------------
+ * in-factorization modification of a too small pivot of the
+ * Newton Hessian factor; only the singular direction is touched,
+ * so L*L' = H + diag(delta) with delta logged in regDirections
+ *  - singular directions: pivot is raised to the regularization
+ *    parameter (sign of strongly negative pivots is dropped)
+ *  - unconstrained Hessian: pivot is raised to the curvature of
+ *    the dual function with all stage bounds inactive, an upper
+ *    bound on the actual curvature, which keeps the step short
+ *
+ >>>>>>                                           */
+return_t qpDUNES_modifyNewtonHessianPivot(	qpData_t* const qpData,
+											facReal_t* const pivot,
+											int_t kk,
+											int_t jj
+											)
+{
+	real_t sum = *pivot;
+	real_t newPivot;
+	real_t curvature;
 
-	*itCntr = 0;
+	switch ( qpData->options.regType ) {
+		case QPDUNES_REG_SINGULAR_DIRECTIONS:
+			newPivot = qpDUNES_fmax( fabs( sum ), qpData->regParam );
+			break;
 
-	/* compute minimum step size for active set change */
-	/* WARNING: THIS ONLY WORKS IF ALL INTERVALS ARE OF THE SAME TYPE */
-	if ( qpData->intervals[0]->qpSolverSpecification	== QPDUNES_STAGE_QP_SOLVER_CLIPPING )
-	{
-		alphaMin = qpData->options.QPDUNES_INFTY;
-	}
-	for ( kk = 0; kk < _NI_ + 1; ++kk )
-	{
-		if (qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING)
-		{
-			directQpSolver_getMinStepsize( qpData, qpData->intervals[kk], &alphaASChange );
-			if (alphaASChange < alphaMin) {
-				alphaMin = alphaASChange;
+		case QPDUNES_REG_UNCONSTRAINED_HESSIAN:
+			if ( qpDUNES_getUnconstrainedNewtonHessianDiag( qpData, &curvature, kk, jj ) != QPDUNES_OK ) {
+				curvature = 1.;		/* fall back to singular directions regularization */
 			}
-		}
-		/* TODO: compute minimum stepsize for qpOASES */
+			newPivot = qpDUNES_fmax( fabs( sum ), qpData->regParam * curvature );
+			break;
+
+		default:
+			return QPDUNES_ERR_DIVISION_BY_ZERO;
 	}
 
+	/* the adapted regularization parameter may have dropped below the breakdown tolerance */
+	newPivot = qpDUNES_fmax( newPivot, qpData->options.newtonHessDiagRegTolerance );
+	if ( !( newPivot >= qpData->options.newtonHessDiagRegTolerance ) ) {	/* NaN */
+		return QPDUNES_ERR_DIVISION_BY_ZERO;
+	}
+	*pivot = newPivot;
+	qpData->regDirections.data[_XNOFF(kk)+jj] = newPivot - sum;
 
-	/* take full step and leave */
-	if ( (alphaMin > 1. - qpData->options.equalityTolerance) && (newtonHessianRegularized == QPDUNES_FALSE) )
-	{
-		*alpha = 1.;
+	#ifdef __DEBUG__
+	if ( qpData->options.printLevel >= 3 ) {
+		qpDUNES_printf( "Regularized NH[k=%d,j=%d] = %.2e + %.2e", kk, jj, sum, newPivot - sum );
+	}
+	#endif
 
-		addVectorScaledVector(lambda, lambda, *alpha, deltaLambdaFS, nV); /* temporary; TODO: move out to mother function */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			/* update primal, dual, and internal QP solver variables */
-			switch (interval->qpSolverSpecification) {
-			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
-				directQpSolver_doStep(qpData, interval,
-						&(interval->qpSolverClipping.dz), *alpha,
-						&(interval->qpSolverClipping.zUnconstrained),
-						&(interval->z), &(interval->y), &(interval->q),
-						&(interval->p));
-				break;
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_modifyNewtonHessianPivot */
+
+
+/* ----------------------------------------------
+ * diagonal element jj of Newton Hessian block kk with all stage
+ * bounds inactive, [C_k H_k^-1 C_k' + E H_{k+1}^-1 E']_jj
+ *
+ >>>>>>                                           */
+return_t qpDUNES_getUnconstrainedNewtonHessianDiag(	qpData_t* const qpData,
+													real_t* const diagElem,
+													int_t kk,
+													int_t jj
+													)
+{
+	int_t ii;
+	return_t statusFlag;
+	real_t quadForm;
+
+	interval_t* interval = qpData->intervals[kk];
+	interval_t* intervalK1 = qpData->intervals[kk+1];
+	z_vector_t* vecTmp = &(qpData->zVecTmp);
+
+	/* C_k H_k^-1 C_k' part, row jj of C_k */
+	for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+		vecTmp->data[ii] = interval->C.data[jj * interval->nV + ii];
+	}
+	statusFlag = multiplyVectorInvMatrixVector( qpData, diagElem, (matrix_t*)&(interval->cholH), (vector_t*)vecTmp, (vector_t*)&(interval->zVecTmp), interval->nV );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+
+	/* E H_{k+1}^-1 E' part, unit vector jj */
+	for (ii = 0; ii < (int_t)intervalK1->nV; ++ii) {
+		vecTmp->data[ii] = 0.;
+	}
+	vecTmp->data[jj] = 1.;
+	statusFlag = multiplyVectorInvMatrixVector( qpData, &quadForm, (matrix_t*)&(intervalK1->cholH), (vector_t*)vecTmp, (vector_t*)&(intervalK1->zVecTmp), intervalK1->nV );
+	*diagElem += quadForm;
+
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_getUnconstrainedNewtonHessianDiag */
+
+
+/* ----------------------------------------------
+ * Special block tridiagonal Cholesky for special storage format of Newton matrix
+ * 
+ >>>>>>                                           */
+return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
+									  xn2x_factor_t* const cholHessian,
+									  xn2x_matrix_t* const hessian,
+									  int_t blockIdxStart,					/**< first block column to be factorized, usually 0 */
+									  int_t blockIdxEnd,					/**< last block column to be factorized, usually nI-1 */
+									  boolean_t* isHessianRegularized
+									  )
+{
+	int_t jj, ii, kk, ll;
+	facReal_t sum;
+
+	/* TEMPORARY*/
+	real_t colMax;
+	real_t colSum;
+	/* END TEMPORARY*/
+
+	/* go by block columns */
+	for (kk = blockIdxStart; kk <= blockIdxEnd; ++kk) {
+		/* go by in-block columns */
+		for (jj = 0; jj < _NX(kk+1); ++jj) {
+			/* 1) compute diagonal element: ii == jj */
+			/* take diagonal element of original */
+			sum = accHessian(kk,0,jj,jj);
+
+			/* subtract squared forepart of corresponding row: */
+			/*  - this diagonal block */
+			for( ll = 0; ll < jj; ++ll ) {
+				sum -= accCholHessian(kk,0,jj,ll) * accCholHessian(kk,0,jj,ll);
+			}
+			/*  - this row's subdiagonal block */
+			if( kk > 0 ) { /* for all block columns but the first one */
+				for( ll = 0; ll < _NX(kk); ++ll ) {
+					sum -= accCholHessian(kk,-1,jj,ll) * accCholHessian(kk,-1,jj,ll);
+				}
+			}
+			
+
+			/* 2) check for too small diagonal elements */
+			qpData->regDirections.data[_XNOFF(kk)+jj] = 0.;
+			if ( sum < qpData->options.newtonHessDiagRegTolerance ) {	/* matrix not positive definite */
+				if ( qpData->options.regType == QPDUNES_REG_LEVENBERG_MARQUARDT ) {
+					/* shift only this block and restart its factorization; earlier blocks stay valid */
+					if ( qpDUNES_regularizeNewtonHessianBlock( qpData, hessian, kk ) != QPDUNES_OK ) {
+						return QPDUNES_ERR_DIVISION_BY_ZERO;
+					}
+					*isHessianRegularized = QPDUNES_TRUE;
+					jj = -1;
+					continue;
+				}
+				/* modify the pivot in the singular direction only, no refactorization needed */
+				if ( qpDUNES_modifyNewtonHessianPivot( qpData, &sum, kk, jj ) != QPDUNES_OK ) {
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+				*isHessianRegularized = QPDUNES_TRUE;
+			}
+			accCholHessian(kk,0,jj,jj) = sqrt( sum );
+			
+			/* TEMPORARY*/
+			colMax = 0.;
+			colSum = 0.;
+			/* END TEMPORARY*/
+
+			/* 3) write remainder of jj-th column: */		/* TODO: think about how we can avoid this column-wise access and postpone until the respective element is needed */
+			/*  - this diagonal block */
+			for( ii=(jj+1); ii<_NX(kk+1); ++ii )
+			{
+				sum = accHessian(kk,0,ii,jj);
+				
+				/* subtract forepart of this row times forepart of jj-th row */
+				/*  - diagonal block */
+				for( ll = 0; ll < jj; ++ll ) {	
+					sum -= accCholHessian(kk,0,ii,ll) * accCholHessian(kk,0,jj,ll);
+				}
+				/*  - subdiagonal block */
+				if( kk > 0 ) {	/* for all block columns but the first one */
+					for( ll = 0; ll < _NX(kk); ++ll ) {
+						sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
+					}
+				}
+				
+				/* TEMPORARY */
+				if (colMax<fabs(sum)) colMax =fabs(sum);
+				colSum += fabs(accHessian(kk,0,ii,jj));
+				/* END TEMPORARY */
+
+				accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+			}
+			/*  - following row's subdiagonal block */
+			if( kk < _NI_-1 ) {	/* for all block columns but the last one */
+				for( ii=0; ii<_NX(kk+2); ++ii )
+				{
+					sum = accHessian(kk+1,-1,ii,jj);
+					
+					/* subtract forepart of this row times forepart of jj-th row (only this block is non-zero) */
+					for( ll = 0; ll < jj; ++ll ) {	
+						sum -= accCholHessian(kk+1,-1,ii,ll) * accCholHessian(kk,0,jj,ll);
+					}
+					
+					/* TEMPORARY */
+					if (colMax<fabs(sum)) colMax =fabs(sum);
+					colSum += fabs(accHessian(kk+1,-1,ii,jj));
+					/* END TEMPORARY */
+
+					accCholHessian(kk+1,-1,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+				}
+			}
+		} /* next column */
+		} /* next block column */
+
+/*	qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, isHessianRegularized );*/
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessian */
+
+/* ----------------------------------------------
+ * Bottom-up block-tridiagonal Cholesky for special storage format of Newton matrix
+ *
+ >>>>>>                                           */
+return_t qpDUNES_factorizeNewtonHessianBottomUp( qpData_t* const qpData,
+											  xn2x_factor_t* const cholHessian,
+											  xn2x_matrix_t* const hessian,
+											  int_t lastActSetChangeIdx, 			/**< index from where the reverse factorization is restarted */
+											  int_t blockIdxEnd,					/**< index of the last block column to be factorized, usually 0 */
+											  boolean_t* isHessianRegularized
+											  )
+{
+	int_t jj, ii, kk, ll;
+	facReal_t sum;
+
+	int_t blockIdxStart = (lastActSetChangeIdx>=0)  ?  qpDUNES_min(lastActSetChangeIdx, _NI_-1)  :  -1;
+/*	int_t blockIdxStart = _NI_-1; */
+
+	#ifdef __DEBUG__
+	if (qpData->options.printLevel >= 3) {
+		qpDUNES_printf( "Restarting reverse Cholesky factorization at block %d of %d", blockIdxStart, _NI_-1 );
+	}
+	#endif
+
+	/* go by block columns */
+	for (kk = blockIdxStart; kk >= blockIdxEnd; --kk) {
+		/* go by in-block columns */
+		for (jj = _NX(kk+1) - 1; jj >= 0; --jj) {
+			/* 1) compute diagonal element: ii == jj */
+			/* take diagonal element of original */
+			sum = accHessian(kk,0,jj,jj);
+
+			/* subtract squared rearpart of corresponding row (transposed access, therefore rest of column): */
+			/*  - this diagonal block */
+			for( ll = jj+1; ll < _NX(kk+1); ++ll ) {
+				/* TODO: get rid of transposed access...maybe start to save Hessian also in upper triangular format */
+				sum -= accCholHessian(kk,0,ll,jj) * accCholHessian(kk,0,ll,jj); /* transposed access */
+			}
+			/*  - this row's subdiagonal block */
+			if( kk < _NI_-1 ) { /* for all block columns but the last one */
+				for( ll = 0; ll < _NX(kk+2); ++ll ) {
+					sum -= accCholHessian(kk+1,-1,ll,jj) * accCholHessian(kk+1,-1,ll,jj);	/* transposed access */
+				}
+			}
+
+
+			/* 2) check for too small diagonal elements */
+			qpData->regDirections.data[_XNOFF(kk)+jj] = 0.;
+			if ( sum < qpData->options.newtonHessDiagRegTolerance ) {
+				switch ( qpData->options.regType ) {
+					case QPDUNES_REG_LEVENBERG_MARQUARDT:
+						/* shift only this block and restart its factorization; later blocks stay valid */
+						if ( qpDUNES_regularizeNewtonHessianBlock( qpData, hessian, kk ) != QPDUNES_OK ) {
+							return QPDUNES_ERR_DIVISION_BY_ZERO;
+						}
+						*isHessianRegularized = QPDUNES_TRUE;
+						jj = _NX(kk+1);
+						continue;
+
+					case QPDUNES_REG_SINGULAR_DIRECTIONS:
+					case QPDUNES_REG_UNCONSTRAINED_HESSIAN:
+						/* modify the pivot in the singular direction only, no refactorization needed */
+						if ( qpDUNES_modifyNewtonHessianPivot( qpData, &sum, kk, jj ) != QPDUNES_OK ) {
+							return QPDUNES_ERR_DIVISION_BY_ZERO;
+						}
+						*isHessianRegularized = QPDUNES_TRUE;
+						break;
+
+					default:
+						if ( sum < 1.e2*qpData->options.equalityTolerance ) {	/* matrix not positive definite */
+							return QPDUNES_ERR_DIVISION_BY_ZERO;
+						}
+						break;
+				}
+			}
+
+			accCholHessian(kk,0,jj,jj) = sqrt( sum );
+
+
+			/* 3) write remainder of jj-th column (upwards! via transposed access: jj-th row, leftwards): */
+			/*  - this diagonal block */
+			for( ii=jj-1; ii>=0; --ii )
+			{
+				sum = accHessian(kk,0,jj,ii);	/* transposed access */
+
+				/* subtract rear part of this row times rear part of jj-th row */
+				/*  - diagonal block */
+				for( ll = jj+1; ll < _NX(kk+1); ++ll ) {
+					sum -= accCholHessian(kk,0,ll,ii) * accCholHessian(kk,0,ll,jj);		/* transposed access */
+				}
+				/*  - subdiagonal block */
+				if( kk < _NI_-1 ) {	/* for all block rows but the last one */
+					for( ll = 0; ll < _NX(kk+2); ++ll ) {
+						sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);	/* transposed access */
+					}
+				}
+
+				/* write transposed! (otherwise it's upper triangular matrix) */
+				accCholHessian(kk,0,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
+			}
+			/*  - following row's subdiagonal block */
+			if( kk > 0 ) {	/* for all block rows but the first one */
+				for( ii=_NX(kk)-1; ii>=0; --ii )
+				{
+					sum = accHessian(kk,-1,jj,ii);	/* transposed access */
+
+					/* subtract rear part of this row times rear part of jj-th row (only this block is non-zero) */
+					for( ll = jj+1; ll < _NX(kk+1); ++ll ) {
+						sum -= accCholHessian(kk,-1,ll,ii) * accCholHessian(kk,0,ll,jj);	/* transposed access */
+					}
+
+					/* write transposed! (otherwise it's upper triangular matrix) */
+					accCholHessian(kk,-1,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
+				}
+			}
+		} /* next column */
+	} /* next block column */
+
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessianBottomUp */
+
+
+
+/* ----------------------------------------------
+ * twisted block tridiagonal Cholesky: block columns above the twist
+ * block t are factorized forward, those below in reverse, so that
+ *   M_tt - L_{t,t-1} L_{t,t-1}' - L_{t+1,t}' L_{t+1,t} = L_tt L_tt'
+ * remains for the twist block itself
+ *
+ * Forward block columns before the first and reverse block columns
+ * after the last stage with active set change are kept from the
+ * previous factorization; the twist moves into the window of changed
+ * stages, so only that window is refactorized. Any twist inside
+ * the refactorized range costs the same now; in automatic mode it is
+ * placed where it is expected to be cheapest for later iterations
+ *
+ >>>>>>                                           */
+return_t qpDUNES_factorizeNewtonHessianTwisted(	qpData_t* const qpData,
+												xn2x_factor_t* const cholHessian,
+												xn2x_matrix_t* const hessian,
+												int_t firstActSetChangeIdx,		/**< first stage with active set change */
+												int_t lastActSetChangeIdx,		/**< last stage with active set change, -1 if none */
+												boolean_t* isHessianRegularized
+												)
+{
+	int_t ii, jj, kk, ll;
+	int_t blockIdxStart, blockIdxEnd;
+	facReal_t sum;
+	return_t statusFlag;
+
+	int_t twistIdx = qpData->nwtnFacTwistIdx;
+
+	if (lastActSetChangeIdx < 0) {
+		return QPDUNES_OK;		/* factor is up to date */
+	}
+
+	/* valid forward block columns end before the first changed diagonal block, valid reverse ones start after the last */
+	blockIdxStart = qpDUNES_max( qpDUNES_min( firstActSetChangeIdx - 1, twistIdx ), 0 );
+	blockIdxEnd = qpDUNES_min( qpDUNES_max( lastActSetChangeIdx, twistIdx ), _NI_-1 );
+	if (qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_AUTO) {
+		twistIdx = qpDUNES_chooseNewtonFactorTwist( qpData, blockIdxStart, blockIdxEnd );
+	}
+	else {
+		twistIdx = qpDUNES_max( qpDUNES_min( twistIdx, qpDUNES_min( lastActSetChangeIdx, _NI_-1 ) ), qpDUNES_max( firstActSetChangeIdx - 1, 0 ) );
+	}
+	qpData->nwtnFacTwistIdx = twistIdx;
+
+	#ifdef __DEBUG__
+	if (qpData->options.printLevel >= 3) {
+		qpDUNES_printf( "Twisted Cholesky factorization of block columns %d to %d, twist at %d", blockIdxStart, blockIdxEnd, twistIdx );
+	}
+	#endif
+
+	/* 1) forward part, writes L_{t,t-1} last */
+	if (twistIdx > blockIdxStart) {
+		statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, hessian, blockIdxStart, twistIdx-1, isHessianRegularized );
+		if (statusFlag != QPDUNES_OK) {
+			return statusFlag;
+		}
+	}
+
+	/* 2) reverse part, writes L_{t+1,t} last */
+	if (twistIdx < blockIdxEnd) {
+		statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, blockIdxEnd, twistIdx+1, isHessianRegularized );
+		if (statusFlag != QPDUNES_OK) {
+			return statusFlag;
+		}
+	}
+
+	/* 3) twist block, Schur complement of both parts */
+	kk = twistIdx;
+	for (jj = 0; jj < _NX(kk+1); ++jj) {
+		for (ii = jj; ii < _NX(kk+1); ++ii) {
+			sum = accHessian(kk,0,ii,jj);
+
+			/*  - forward part, this row's subdiagonal block */
+			if (kk > 0) {
+				for (ll = 0; ll < _NX(kk); ++ll) {
+					sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
+				}
+			}
+			/*  - reverse part, following row's subdiagonal block (transposed access) */
+			if (kk < _NI_-1) {
+				for (ll = 0; ll < _NX(kk+2); ++ll) {
+					sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);
+				}
+			}
+			/*  - this diagonal block */
+			for (ll = 0; ll < jj; ++ll) {
+				sum -= accCholHessian(kk,0,ii,ll) * accCholHessian(kk,0,jj,ll);
+			}
+
+			if (ii > jj) {
+				accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+				continue;
+			}
+
+			/* check for too small diagonal elements */
+			qpData->regDirections.data[_XNOFF(kk)+jj] = 0.;
+			if ( sum < qpData->options.newtonHessDiagRegTolerance ) {
+				if ( qpData->options.regType == QPDUNES_REG_LEVENBERG_MARQUARDT ) {
+					/* shift only the twist block and restart its factorization */
+					if ( qpDUNES_regularizeNewtonHessianBlock( qpData, hessian, kk ) != QPDUNES_OK ) {
+						return QPDUNES_ERR_DIVISION_BY_ZERO;
+					}
+					*isHessianRegularized = QPDUNES_TRUE;
+					jj = -1;
+					break;
+				}
+				if ( qpDUNES_modifyNewtonHessianPivot( qpData, &sum, kk, jj ) != QPDUNES_OK ) {
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+				*isHessianRegularized = QPDUNES_TRUE;
+			}
+			accCholHessian(kk,0,jj,jj) = sqrt( sum );
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessianTwisted */
+
+
+/* ----------------------------------------------
+ * record the window of block columns invalidated by the current
+ * active set change in the decayed change frequencies
+ *
+ >>>>>>                                           */
+void qpDUNES_updateNewtonFactorStats(	qpData_t* const qpData,
+										int_t firstActSetChangeIdx,
+										int_t lastActSetChangeIdx
+										)
+{
+	int_t kk;
+	const real_t decay = 0.9;		/* weight of the history */
+
+	if (lastActSetChangeIdx < 0) {
+		return;
+	}
+
+	for (kk = 0; kk < _NI_; ++kk) {
+		qpData->nwtnFacFirstChangeFreq[kk] *= decay;
+		qpData->nwtnFacLastChangeFreq[kk] *= decay;
+	}
+	qpData->nwtnFacFirstChangeFreq[ qpDUNES_max( firstActSetChangeIdx - 1, 0 ) ] += 1.;
+	qpData->nwtnFacLastChangeFreq[ qpDUNES_min( lastActSetChangeIdx, _NI_-1 ) ] += 1.;
+}
+/*<<< END OF qpDUNES_updateNewtonFactorStats */
+
+
+/* ----------------------------------------------
+ * choose the twist block within blockIdxStart..blockIdxEnd that
+ * minimizes the expected number of block columns to refactorize
+ * after the next active set change, max(b,t) - min(a,t) + 1 for a
+ * changed window [a,b]; moving the twist from t to t+1 adds a column
+ * if b <= t and saves one if a > t, so the optimum is the first t with
+ *   P(b <= t) >= P(a > t)
+ * The reverse factorization is the special case of changes close to
+ * the first stage, the forward one of changes close to the last stage
+ *
+ >>>>>>                                           */
+int_t qpDUNES_chooseNewtonFactorTwist(	qpData_t* const qpData,
+										int_t blockIdxStart,
+										int_t blockIdxEnd
+										)
+{
+	int_t kk;
+	real_t freqLastUpToK = 0.;
+	real_t freqFirstAfterK = 0.;
+
+	for (kk = 0; kk < _NI_; ++kk) {
+		freqFirstAfterK += qpData->nwtnFacFirstChangeFreq[kk];
+	}
+
+	for (kk = 0; kk < blockIdxEnd; ++kk) {
+		freqLastUpToK += qpData->nwtnFacLastChangeFreq[kk];
+		freqFirstAfterK -= qpData->nwtnFacFirstChangeFreq[kk];
+		if ( (kk >= blockIdxStart) && (freqLastUpToK >= freqFirstAfterK) ) {
+			break;
+		}
+	}
+
+	#ifdef __DEBUG__
+	if (qpData->options.printLevel >= 3) {
+		qpDUNES_printf( "Twist of Newton Hessian factorization placed at block %d", kk );
+	}
+	#endif
+
+	return kk;
+}
+/*<<< END OF qpDUNES_chooseNewtonFactorTwist */
+
+
+/* ----------------------------------------------
+ * Cholesky factorization of the diagonal Newton Hessian blocks
+ * only, used as block-Jacobi preconditioner of the matrix-free
+ * Newton solver; singular blocks are regularized as in the band
+ * factorizations
+ *
+ >>>>>>                                           */
+return_t qpDUNES_factorizeNewtonHessianBlockJacobi(	qpData_t* const qpData,
+													xn2x_factor_t* const cholHessian,
+													xn2x_matrix_t* const hessian,
+													boolean_t* isHessianRegularized
+													)
+{
+	int_t ii, jj, kk, ll;
+	facReal_t sum;
+
+	/* Newton Hessian-vector products are formed from the clipping stage data */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (qpData->intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Matrix-free Newton solver is only supported with clipping stage QPs." );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+	}
+
+	for (kk = 0; kk < _NI_; ++kk) {
+		for (jj = 0; jj < _NX(kk+1); ++jj) {
+			/* 1) diagonal element */
+			sum = accHessian(kk,0,jj,jj);
+			for( ll = 0; ll < jj; ++ll ) {
+				sum -= accCholHessian(kk,0,jj,ll) * accCholHessian(kk,0,jj,ll);
+			}
+
+			/* 2) check for too small diagonal elements; singular directions of the coupled
+			 *    Newton Hessian need not show up in single pivots here, hence all regularization
+			 *    types but gradient steps are realized as Levenberg-Marquardt block shifts */
+			qpData->regDirections.data[_XNOFF(kk)+jj] = 0.;
+			if ( sum < qpData->options.newtonHessDiagRegTolerance ) {
+				if ( ( qpData->options.regType == QPDUNES_REG_GRADIENT_STEP ) ||
+					 ( qpDUNES_regularizeNewtonHessianBlock( qpData, hessian, kk ) != QPDUNES_OK ) )
+				{
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+				*isHessianRegularized = QPDUNES_TRUE;
+				jj = -1;
+				continue;
+			}
+			accCholHessian(kk,0,jj,jj) = sqrt( sum );
+
+			/* 3) remainder of jj-th column within the block */
+			for( ii = jj+1; ii < _NX(kk+1); ++ii ) {
+				sum = accHessian(kk,0,ii,jj);
+				for( ll = 0; ll < jj; ++ll ) {
+					sum -= accCholHessian(kk,0,ii,ll) * accCholHessian(kk,0,jj,ll);
+				}
+				accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+			}
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessianBlockJacobi */
+
+
+/* ----------------------------------------------
+ * special backsolve for block tridiagonal Newton matrix
+ * 
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
+									xn_vector_t* const res,
+									const xn2x_factor_t* const cholHessian, /**< lower triangular Newton Hessian factor */
+									const xn_vector_t* const gradient	)
+{
+	int_t ii, jj, kk;
+
+	real_t sum;
+
+	/* solve L*x = g */
+	for (kk = 0; kk < _NI_; ++kk) /* go by block rows top down */
+	{
+		for (ii = 0; ii < _NX(kk+1); ++ii) /* go by in-block rows top down */
+		{
+			sum = gradient->data[_XNOFF(kk) + ii];
+			/* subtract all previously resolved unknowns ... */
+			if (kk > 0) { /* ... of corresponding subdiagonal block (if not first block row) */
+				for (jj = 0; jj < _NX(kk); ++jj) {
+					sum -= accCholHessian(kk,-1,ii,jj)* res->data[_XNOFF(kk-1)+jj];
+				}
+			}
+			for (jj = 0; jj < ii; ++jj) { /* ... of corresponding diagonal block */
+				sum -= accCholHessian(kk,0,ii,jj)* res->data[_XNOFF(kk)+jj];
+			}
+
+			/* divide by diagonal element */
+			#if defined(__USE_ASSERTS__)
+			if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
+				qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
+				return QPDUNES_ERR_DIVISION_BY_ZERO;
+			}
+			#endif
+			/* temporarily to try Wright1999 */
+			if (accCholHessian(kk,0,ii,ii)> qpData->options.QPDUNES_INFTY) {
+				res->data[_XNOFF(kk)+ii] = 0.;
+			}
+			else {
+				res->data[_XNOFF(kk)+ii] = sum / accCholHessian(kk,0,ii,ii);
+			}
+		}
+	}
+
+	/* solve L^T*res = x */
+	for (kk = (_NI_ - 1); kk >= 0; --kk) /* go by block rows bottom up */
+	{
+		for (ii = (_NX(kk+1) - 1); ii >= 0; --ii) /* go by in-block rows top down */
+		{
+			sum = res->data[_XNOFF(kk) + ii]; /* intermediate result of first backsolve is stored in res */
+			/* subtract all previously resolved unknowns ... */
+			for (jj = ii + 1; jj < _NX(kk+1); ++jj) { /* ... of corresponding diagonal block */
+				sum -= accCholHessian(kk,0,jj,ii)* res->data[_XNOFF(kk)+jj];
+			}
+			if (kk < _NI_ - 1) { /* ... of corresponding superdiagonal block, access via following row's subdiagonal block (if not first block row from bottom) */
+				for (jj = 0; jj < _NX(kk+2); ++jj) {
+					sum -= accCholHessian(kk+1,-1,jj,ii)* res->data[_XNOFF(kk+1)+jj];
+				}
+			}
+
+			/* divide by diagonal element */
+			#if defined(__USE_ASSERTS__)
+				if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
+					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+			#endif
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveNewtonEquation */
+
+
+/* ----------------------------------------------
+ * special backsolve for backwards factorized block tridiagonal Newton matrix
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
+											xn_vector_t* const res,
+											const xn2x_factor_t* const cholHessian, /**< lower triangular Newton Hessian factor */
+											const xn_vector_t* const gradient	)
+{
+	int_t ii, jj, kk;
+
+	real_t sum;
+
+	/* solve L^T*x = g */
+	for (kk = (_NI_ - 1); kk >= 0; --kk) /* go by block rows bottom up */
+	{
+		for (ii = (_NX(kk+1) - 1); ii >= 0; --ii) /* go by in-block rows top down */
+		{
+			sum = gradient->data[_XNOFF(kk) + ii];
+			/* subtract all previously resolved unknowns ... */
+			for (jj = ii + 1; jj < _NX(kk+1); ++jj) { /* ... of corresponding diagonal block */
+				sum -= accCholHessian(kk,0,jj,ii)* res->data[_XNOFF(kk)+jj]; /* transposed access */
+			}
+			if (kk < _NI_ - 1) { /* ... of corresponding superdiagonal block, access via following row's subdiagonal block (if not first block row from bottom) */
+				for (jj = 0; jj < _NX(kk+2); ++jj) {
+					sum -= accCholHessian(kk+1,-1,jj,ii)* res->data[_XNOFF(kk+1)+jj];/* TODO: maybe change access pattern, start with superdiag block, so cholH access is more continuous*/
+				}
+			}
+
+			/* divide by diagonal element */
+			#if defined(__USE_ASSERTS__)
+				if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
+					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+			#endif
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	/* solve L*res = x */
+	for (kk = 0; kk < _NI_; ++kk) /* go by block rows top down */
+	{
+		for (ii = 0; ii < _NX(kk+1); ++ii) /* go by in-block rows top down */
+		{
+			sum = res->data[_XNOFF(kk) + ii]; /* intermediate result of first backsolve is stored in res */
+			/* subtract all previously resolved unknowns ... */
+			if (kk > 0) { /* ... of corresponding subdiagonal block (if not first block row) */
+				for (jj = 0; jj < _NX(kk); ++jj) {
+					sum -= accCholHessian(kk,-1,ii,jj)* res->data[_XNOFF(kk-1)+jj];
+				}
+			}
+			for (jj = 0; jj < ii; ++jj) { /* ... of corresponding diagonal block */
+				sum -= accCholHessian(kk,0,ii,jj)* res->data[_XNOFF(kk)+jj];
+			}
+
+			/* divide by diagonal element */
+			#if defined(__USE_ASSERTS__)
+				if ( fabs( accCholHessian(kk,0,ii,ii) ) < qpData->options.QPDUNES_ZERO * fabs( sum ) ) {
+					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveDenseL.\nsum = %.3e, diag = %.3e\nRank-deficient Matrix?", sum, accCholHessian(kk,0,ii,ii) );
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+			#endif
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveNewtonEquationBottomUp */
+
+
+/* ----------------------------------------------
+ * backsolve with the twisted Newton Hessian factor: eliminate
+ * towards the twist block from both ends, solve with the twist
+ * block and substitute back outwards
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonEquationTwisted(	qpData_t* const qpData,
+											xn_vector_t* const res,
+											const xn2x_factor_t* const cholHessian, /**< twisted Newton Hessian factor */
+											const xn_vector_t* const gradient	)
+{
+	int_t ii, jj, kk;
+	int_t twistIdx = qpData->nwtnFacTwistIdx;
+
+	real_t sum;
+
+	/* 1) solve L*x = g for the forward part, top down */
+	for (kk = 0; kk < twistIdx; ++kk) {
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			sum = gradient->data[_XNOFF(kk) + ii];
+			if (kk > 0) {
+				for (jj = 0; jj < _NX(kk); ++jj) {
+					sum -= accCholHessian(kk,-1,ii,jj) * res->data[_XNOFF(kk-1)+jj];
+				}
+			}
+			for (jj = 0; jj < ii; ++jj) {
+				sum -= accCholHessian(kk,0,ii,jj) * res->data[_XNOFF(kk)+jj];
+			}
+			res->data[_XNOFF(kk)+ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	/* 2) solve L^T*x = g for the reverse part, bottom up */
+	for (kk = _NI_ - 1; kk > twistIdx; --kk) {
+		for (ii = _NX(kk+1) - 1; ii >= 0; --ii) {
+			sum = gradient->data[_XNOFF(kk) + ii];
+			for (jj = ii + 1; jj < _NX(kk+1); ++jj) {
+				sum -= accCholHessian(kk,0,jj,ii) * res->data[_XNOFF(kk)+jj];	/* transposed access */
+			}
+			if (kk < _NI_ - 1) {
+				for (jj = 0; jj < _NX(kk+2); ++jj) {
+					sum -= accCholHessian(kk+1,-1,jj,ii) * res->data[_XNOFF(kk+1)+jj];
+				}
+			}
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	/* 3) twist block: L_tt*L_tt'*x_t = g_t - L_{t,t-1}*x_{t-1} - L_{t+1,t}'*x_{t+1} */
+	kk = twistIdx;
+	for (ii = 0; ii < _NX(kk+1); ++ii) {
+		sum = gradient->data[_XNOFF(kk) + ii];
+		if (kk > 0) {
+			for (jj = 0; jj < _NX(kk); ++jj) {
+				sum -= accCholHessian(kk,-1,ii,jj) * res->data[_XNOFF(kk-1)+jj];
+			}
+		}
+		if (kk < _NI_ - 1) {
+			for (jj = 0; jj < _NX(kk+2); ++jj) {
+				sum -= accCholHessian(kk+1,-1,jj,ii) * res->data[_XNOFF(kk+1)+jj];
+			}
+		}
+		for (jj = 0; jj < ii; ++jj) {
+			sum -= accCholHessian(kk,0,ii,jj) * res->data[_XNOFF(kk)+jj];
+		}
+		res->data[_XNOFF(kk)+ii] = sum / accCholHessian(kk,0,ii,ii);
+	}
+	for (ii = _NX(kk+1) - 1; ii >= 0; --ii) {
+		sum = res->data[_XNOFF(kk) + ii];
+		for (jj = ii + 1; jj < _NX(kk+1); ++jj) {
+			sum -= accCholHessian(kk,0,jj,ii) * res->data[_XNOFF(kk)+jj];
+		}
+		res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+	}
+
+	/* 4) solve L^T*res = x for the forward part, from the twist upwards */
+	for (kk = twistIdx - 1; kk >= 0; --kk) {
+		for (ii = _NX(kk+1) - 1; ii >= 0; --ii) {
+			sum = res->data[_XNOFF(kk) + ii];
+			for (jj = ii + 1; jj < _NX(kk+1); ++jj) {
+				sum -= accCholHessian(kk,0,jj,ii) * res->data[_XNOFF(kk)+jj];
+			}
+			for (jj = 0; jj < _NX(kk+2); ++jj) {	/* block row kk+1 exists up to the twist */
+				sum -= accCholHessian(kk+1,-1,jj,ii) * res->data[_XNOFF(kk+1)+jj];
+			}
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	/* 5) solve L*res = x for the reverse part, from the twist downwards */
+	for (kk = twistIdx + 1; kk < _NI_; ++kk) {
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			sum = res->data[_XNOFF(kk) + ii];
+			for (jj = 0; jj < _NX(kk); ++jj) {
+				sum -= accCholHessian(kk,-1,ii,jj) * res->data[_XNOFF(kk-1)+jj];
+			}
+			for (jj = 0; jj < ii; ++jj) {
+				sum -= accCholHessian(kk,0,ii,jj) * res->data[_XNOFF(kk)+jj];
+			}
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveNewtonEquationTwisted */
+
+
+/* ----------------------------------------------
+ * backsolve with the block-Jacobi preconditioner, i.e., with the
+ * factors of the diagonal Newton Hessian blocks
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonEquationBlockJacobi(	qpData_t* const qpData,
+												xn_vector_t* const res,
+												const xn2x_factor_t* const cholHessian, /**< factors of the diagonal Newton Hessian blocks */
+												const xn_vector_t* const gradient	)
+{
+	int_t ii, jj, kk;
+
+	real_t sum;
+
+	for (kk = 0; kk < _NI_; ++kk) /* blocks are independent */
+	{
+		/* solve L_kk*x = g_kk */
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			sum = gradient->data[_XNOFF(kk) + ii];
+			for (jj = 0; jj < ii; ++jj) {
+				sum -= accCholHessian(kk,0,ii,jj) * res->data[_XNOFF(kk)+jj];
+			}
+			res->data[_XNOFF(kk)+ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+
+		/* solve L_kk^T*res = x */
+		for (ii = (_NX(kk+1) - 1); ii >= 0; --ii) {
+			sum = res->data[_XNOFF(kk) + ii];
+			for (jj = ii + 1; jj < _NX(kk+1); ++jj) {
+				sum -= accCholHessian(kk,0,jj,ii) * res->data[_XNOFF(kk)+jj];
+			}
+			res->data[_XNOFF(kk) + ii] = sum / accCholHessian(kk,0,ii,ii);
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveNewtonEquationBlockJacobi */
+
+
+/* ----------------------------------------------
+ * backsolve with the current Newton Hessian factor
+ *
+ >>>>>>                                           */
+return_t qpDUNES_backsolveNewtonFactor(	qpData_t* const qpData,
+										xn_vector_t* const res,
+										const xn_vector_t* const rhs
+										)
+{
+	switch (qpData->options.nwtnHssnFacAlg) {
+		case QPDUNES_NH_FAC_BAND_FORWARD:
+			return qpDUNES_solveNewtonEquation( qpData, res, &(qpData->cholHessian), rhs );
+
+		case QPDUNES_NH_FAC_BAND_REVERSE:
+			return qpDUNES_solveNewtonEquationBottomUp( qpData, res, &(qpData->cholHessian), rhs );
+
+		case QPDUNES_NH_PCG_BLOCK_JACOBI:
+			return qpDUNES_solveNewtonEquationBlockJacobi( qpData, res, &(qpData->cholHessian), rhs );
+
+		case QPDUNES_NH_FAC_BAND_TWISTED:
+		case QPDUNES_NH_FAC_BAND_AUTO:
+			return qpDUNES_solveNewtonEquationTwisted( qpData, res, &(qpData->cholHessian), rhs );
+
+		default:
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown Newton Hessian factorization algorithm. Cannot do backsolve." );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+}
+/*<<< END OF qpDUNES_backsolveNewtonFactor */
+
+
+/* ----------------------------------------------
+ * solve the Newton system with the current factor, followed by
+ * refinement iterations driven by the residual of the real_t
+ * Newton Hessian; pivot modifications of the factor are left out of
+ * the residual, so that the factor only acts as preconditioner and
+ * pivots raised by single precision roundoff are refined away;
+ * the refinement is done as conjugate gradient iterations
+ * preconditioned with the factor, which, unlike plain iterative
+ * refinement, does not diverge if a mixed precision factor lost
+ * the weakest directions of an ill-conditioned Newton Hessian
+ *
+ * With the matrix-free Newton solver the same iterations, started
+ * from zero, solve the Newton system up to the inexact Newton
+ * forcing term min(eta,|rhs|); they are truncated at directions of
+ * vanishing curvature, so the result is always an ascent direction;
+ * for other right hand sides (isNewtonStep false) they solve the
+ * system without block shifts up to the refinement tolerance
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonSystem(	qpData_t* const qpData,
+									xn_vector_t* const res,
+									const xn_vector_t* const rhs,
+									boolean_t isNewtonStep
+									)
+{
+	int_t ii, kk;
+	int_t maxNumIter;
+	return_t statusFlag;
+
+	real_t rhsNorm, resTol;
+	real_t rz, rzNew, pq, stepSize;
+
+	xn_vector_t* r = &(qpData->xnVecTmp3);
+	xn_vector_t* z = &(qpData->xnVecTmp4);
+	xn_vector_t* p = &(qpData->xnVecTmp5);
+	xn_vector_t* q = &(qpData->xnVecTmp6);
+
+	rhsNorm = vectorNorm( rhs, _NXTTL_ );
+	if ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_PCG_BLOCK_JACOBI ) {
+		maxNumIter = qpData->options.maxNumNewtonCGIterations;
+		if ( isNewtonStep ) {
+			if ( maxNumIter < 1 ) {
+				maxNumIter = 1;		/* a single iteration gives a scaled block-Jacobi step */
+			}
+			resTol = qpDUNES_fmin( qpData->options.nwtnCGForcingTolerance, rhsNorm ) * rhsNorm;
+		}
+		else {
+			if ( maxNumIter < _NXTTL_ ) {
+				maxNumIter = _NXTTL_;
+			}
+			resTol = 1.e2 * qpData->options.equalityTolerance * rhsNorm;
+		}
+
+		/* start from zero, the block-Jacobi step itself can be badly scaled in regularized directions */
+		for (ii = 0; ii < _NXTTL_; ++ii) {
+			res->data[ii] = 0.;
+			r->data[ii] = rhs->data[ii];
+		}
+	}
+	else {
+		maxNumIter = qpData->options.maxNumNewtonRefinementIterations;
+		resTol = 1.e2 * qpData->options.equalityTolerance * rhsNorm;
+
+		statusFlag = qpDUNES_backsolveNewtonFactor( qpData, res, rhs );
+		if ( ( statusFlag != QPDUNES_OK ) || ( maxNumIter <= 0 ) ) {
+			return statusFlag;
+		}
+
+		/* residual of the real_t system */
+		statusFlag = qpDUNES_multiplyNewtonHessianVector( qpData, r, &(qpData->hessian), res );
+		for (ii = 0; ii < _NXTTL_; ++ii) {
+			r->data[ii] = rhs->data[ii] - r->data[ii];
+		}
+		if ( ( statusFlag != QPDUNES_OK ) || ( vectorNorm( r, _NXTTL_ ) <= resTol ) ) {
+			return statusFlag;
+		}
+	}
+	statusFlag = qpDUNES_backsolveNewtonFactor( qpData, z, r );
+	qpDUNES_copyVector( p, z, _NXTTL_ );
+	rz = scalarProd( r, z, _NXTTL_ );
+
+	for (kk = 0; kk < maxNumIter; ++kk) {
+		if ( statusFlag != QPDUNES_OK ) {
+			return statusFlag;
+		}
+		if ( ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_PCG_BLOCK_JACOBI ) && ( isNewtonStep ) ) {
+			statusFlag = qpDUNES_multiplyRegularizedNewtonHessianVector( qpData, q, p );
+		}
+		else if ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_PCG_BLOCK_JACOBI ) {
+			statusFlag = qpDUNES_multiplyNewtonHessianVectorMatrixFree( qpData, q, p );
+		}
+		else {
+			statusFlag = qpDUNES_multiplyNewtonHessianVector( qpData, q, &(qpData->hessian), p );
+		}
+		pq = scalarProd( p, q, _NXTTL_ );
+		if ( ( statusFlag != QPDUNES_OK ) || ( pq <= qpData->options.newtonHessDiagRegTolerance * scalarProd( p, p, _NXTTL_ ) ) ) {
+			/* (numerically) singular direction, keep the last iterate, or the preconditioned gradient */
+			if ( ( kk == 0 ) && ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_PCG_BLOCK_JACOBI ) ) {
+				for (ii = 0; ii < _NXTTL_; ++ii) {
+					res->data[ii] += p->data[ii];
+				}
+			}
+			break;
+		}
+		stepSize = rz / pq;
+		for (ii = 0; ii < _NXTTL_; ++ii) {
+			res->data[ii] += stepSize * p->data[ii];
+			r->data[ii] -= stepSize * q->data[ii];
+		}
+		if ( vectorNorm( r, _NXTTL_ ) <= resTol ) {
+			break;
+		}
+
+		statusFlag = qpDUNES_backsolveNewtonFactor( qpData, z, r );
+		rzNew = scalarProd( r, z, _NXTTL_ );
+		for (ii = 0; ii < _NXTTL_; ++ii) {
+			p->data[ii] = z->data[ii] + ( rzNew / rz ) * p->data[ii];
+		}
+		rz = rzNew;
+	}
+
+	#ifdef __DEBUG__
+	if ( qpData->options.printLevel >= 3 ) {
+		qpDUNES_printf( "Newton system solved with %d CG iterations", kk );
+	}
+	#endif
+
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_solveNewtonSystem */
+
+
+/* ----------------------------------------------
+ * special multiplication routine for Newton Hessian with a vector
+ *
+ >>>>>>                                           */
+return_t qpDUNES_multiplyNewtonHessianVector(	qpData_t* const qpData,
+												xn_vector_t* const res,
+												const xn2x_matrix_t* const hessian, /**< Newton Hessian */
+												const xn_vector_t* const vec	)
+{
+	int_t ii, jj, kk;
+
+
+	for (kk = 0; kk < _NI_; ++kk) 			/* go by block rows top down */
+	{
+		/* empty full result vector chunk beforehand, needed for cache-efficient transposed multiplication */
+		for (ii = 0; ii < _NX(kk+1); ++ii)
+		{
+			res->data[_XNOFF(kk) + ii] = 0.0;
+		}
+
+		/* write result */
+		for (ii = 0; ii < _NX(kk+1); ++ii) 		/* go by in-block rows top down */
+		{
+			if (kk > 0)
+			{
+				/* go through subdiagonal block by columns */
+				for (jj = 0; jj < _NX(kk); ++jj)
+				{
+					res->data[_XNOFF(kk) + ii] += accHessian(kk,-1,ii,jj) * vec->data[_XNOFF(kk-1) + jj];
+				}
+			}
+
+			/* go through diagonal block by columns; packed lower triangle, upper part by transposed access */
+			for (jj = 0; jj <= ii; ++jj)
+			{
+				res->data[_XNOFF(kk) + ii] += accHessian(kk,0,ii,jj) * vec->data[_XNOFF(kk) + jj];
+			}
+			for (jj = ii + 1; jj < _NX(kk+1); ++jj)
+			{
+				res->data[_XNOFF(kk) + ii] += accHessian(kk,0,jj,ii) * vec->data[_XNOFF(kk) + jj];
+			}
+		} 	/* end of in-block rows */
+
+		if (kk < _NI_-1)
+		{
+			/* go through superdiagonal block by columns; transposed access though */
+			for (ii = 0; ii < _NX(kk+2); ++ii)
+			{
+				for (jj = 0; jj < _NX(kk+1); ++jj)
+				{
+					/* by-column multiplication for higher cache efficiency in Newton Hessian (transposed access of Newton Hessian) */
+					res->data[_XNOFF(kk) + jj] += accHessian(kk+1,-1,ii,jj) * vec->data[_XNOFF(kk+1) + ii];
+				}
+			}
+		}
+	}		/* end of block rows */
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_multiplyNewtonHessianVector */
+
+
+/* ----------------------------------------------
+ * Newton Hessian-vector product without the Newton Hessian: with
+ * the projected stage Hessian inverses P_k of the clipping stage
+ * QPs,
+ *   w_k = P_k ( C_k' v_k - E_k' v_{k-1} ),
+ *   res_k = C_k w_k - E_{k+1} w_{k+1},
+ * which costs O(nX*nV) per stage instead of O(nX^2*nV) for forming
+ * the Newton Hessian blocks
+ *
+ >>>>>>                                           */
+return_t qpDUNES_multiplyNewtonHessianVectorMatrixFree(	qpData_t* const qpData,
+														xn_vector_t* const res,
+														const xn_vector_t* const vec	)
+{
+	int_t ii, kk;
+	return_t statusFlag;
+
+	interval_t* interval;
+	x_vector_t* xVecTmp = &(qpData->xVecTmp);
+	z_vector_t* zVecTmp = &(qpData->zVecTmp);
+
+	/* 1) stage responses w_k, stored in the stage workspace */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+
+		if (kk < _NI_) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				xVecTmp->data[ii] = vec->data[_XNOFF(kk) + ii];
+			}
+			multiplyCTy( zVecTmp, &(interval->C), xVecTmp, _NX(kk+1), interval->nV );
+		}
+		else {
+			for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+				zVecTmp->data[ii] = 0.;
+			}
+		}
+		if (kk > 0) {
+			for (ii = 0; ii < _NX(kk); ++ii) {
+				zVecTmp->data[ii] -= vec->data[_XNOFF(kk-1) + ii];
+			}
+		}
+
+		/* project on the variables with inactive bounds */
+		for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+			if ( ( interval->y.data[2 * ii] > qpData->options.equalityTolerance ) ||
+				 ( interval->y.data[2 * ii + 1] > qpData->options.equalityTolerance ) )
+			{
+				zVecTmp->data[ii] = 0.;
+			}
+		}
+		statusFlag = multiplyInvHz( qpData, &(interval->zVecTmp), clippingQpSolver_getNewtonHessianFactor( interval ), zVecTmp, interval->nV );
+		if (statusFlag != QPDUNES_OK) {
+			return statusFlag;
+		}
+		for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+			if ( ( interval->y.data[2 * ii] > qpData->options.equalityTolerance ) ||
+				 ( interval->y.data[2 * ii + 1] > qpData->options.equalityTolerance ) )
+			{
+				interval->zVecTmp.data[ii] = 0.;
+			}
+		}
+	}
+
+	/* 2) coupling residual response */
+	for (kk = 0; kk < _NI_; ++kk) {
+		multiplyCz( xVecTmp, &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp), _NX(kk+1), qpData->intervals[kk]->nV );
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			res->data[_XNOFF(kk) + ii] = xVecTmp->data[ii] - qpData->intervals[kk+1]->zVecTmp.data[ii];
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_multiplyNewtonHessianVectorMatrixFree */
+
+
+/* ----------------------------------------------
+ * product of the regularized Newton Hessian, i.e., including block
+ * shifts and pivot modifications of the current factor, with a vector
+ *
+ >>>>>>                                           */
+return_t qpDUNES_multiplyRegularizedNewtonHessianVector(	qpData_t* const qpData,
+															xn_vector_t* const res,
+															const xn_vector_t* const vec	)
+{
+	int_t ii, kk;
+	return_t statusFlag;
+
+	if ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_PCG_BLOCK_JACOBI ) {
+		statusFlag = qpDUNES_multiplyNewtonHessianVectorMatrixFree( qpData, res, vec );
+		/* block shifts are only contained in the assembled diagonal blocks */
+		for (kk = 0; kk < _NI_; ++kk) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				res->data[_XNOFF(kk) + ii] += qpData->regShift[kk] * vec->data[_XNOFF(kk) + ii];
+			}
+		}
+	}
+	else {
+		statusFlag = qpDUNES_multiplyNewtonHessianVector( qpData, res, &(qpData->hessian), vec );
+	}
+
+	for (ii = 0; ii < _NXTTL_; ++ii) {
+		res->data[ii] += qpData->regDirections.data[ii] * vec->data[ii];
+	}
+
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_multiplyRegularizedNewtonHessianVector */
+
+
+
+/* ----------------------------------------------
+ * ...
+ * 
+ >>>>>>                                           */
+return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
+									xn_vector_t* const lambda,
+									xn_vector_t* const deltaLambdaFS,
+									uint_t* const itCntr,
+									real_t* const alpha,
+									real_t* const objValIncumbent,
+									boolean_t newtonHessianRegularized
+									)
+{
+	return_t statusFlag;
+	
+	int_t kk;
+
+	interval_t* interval;
+	
+	int_t nV = _NXTTL_;
+
+	real_t alphaMin = 0.;
+	real_t alphaMax = 1.;
+	real_t alphaASChange = qpData->options.QPDUNES_INFTY;
+
+	xn_vector_t* lambdaTry = &(qpData->xnVecTmp);
+
+	*itCntr = 0;
+	qpData->lsGradientIsValid = QPDUNES_FALSE;
+
+	/* compute minimum step size for active set change */
+	/* WARNING: THIS ONLY WORKS IF ALL INTERVALS ARE OF THE SAME TYPE */
+	if ( qpData->intervals[0]->qpSolverSpecification	== QPDUNES_STAGE_QP_SOLVER_CLIPPING )
+	{
+		alphaMin = qpData->options.QPDUNES_INFTY;
+	}
+	for ( kk = 0; kk < _NI_ + 1; ++kk )
+	{
+		if ( (qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING) &&
+			 (qpData->intervals[kk]->lambdaHasChanged == QPDUNES_TRUE) )
+		{
+			directQpSolver_getMinStepsize( qpData, qpData->intervals[kk], &alphaASChange );
+			if (alphaASChange < alphaMin) {
+				alphaMin = alphaASChange;
+			}
+		}
+		/* TODO: compute minimum stepsize for qpOASES */
+	}
+
+
+	/* take full step and leave */
+	if ( (alphaMin > 1. - qpData->options.equalityTolerance) && (newtonHessianRegularized == QPDUNES_FALSE) )
+	{
+		*alpha = 1.;
+
+		addVectorScaledVector(lambda, lambda, *alpha, deltaLambdaFS, nV); /* temporary; TODO: move out to mother function */
+		for (kk = 0; kk < _NI_ + 1; ++kk) {
+			interval = qpData->intervals[kk];
+			if (interval->lambdaHasChanged == QPDUNES_FALSE) {
+				continue;
+			}
+			/* update primal, dual, and internal QP solver variables */
+			switch (interval->qpSolverSpecification) {
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				directQpSolver_doStep(qpData, interval,
+						&(interval->qpSolverClipping.dz), *alpha,
+						&(interval->qpSolverClipping.zUnconstrained),
+						&(interval->z), &(interval->y), &(interval->q),
+						&(interval->p));
+				break;
 
 			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
 				#ifndef __SIMPLE_BOUNDS_ONLY__
@@ -1473,681 +3014,1248 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 					return QPDUNES_ERR_INVALID_ARGUMENT;
 				#endif /* __SIMPLE_BOUNDS_ONLY__ */
 
-			default:
-				qpDUNES_printError(qpData, __FILE__, __LINE__,
-						"Stage QP solver undefined! Bailing out...");
-				return QPDUNES_ERR_UNKNOWN_ERROR;
+			default:
+				qpDUNES_printError(qpData, __FILE__, __LINE__,
+						"Stage QP solver undefined! Bailing out...");
+				return QPDUNES_ERR_UNKNOWN_ERROR;
+			}
+		}
+		*objValIncumbent = qpDUNES_updateObjectiveValue(qpData);
+		return QPDUNES_OK;
+	}
+
+
+	/* do a line search */
+	switch (qpData->options.lsType) {
+	case QPDUNES_LS_BACKTRACKING_LS:
+		statusFlag = qpDUNES_backTrackingLineSearch( qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent );
+		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) {
+			return statusFlag;
+		}
+		break;
+
+	case QPDUNES_LS_BACKTRACKING_LS_WITH_AS_CHANGE:
+		statusFlag = qpDUNES_backTrackingLineSearch(qpData, alpha, itCntr,
+				deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent);
+		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) {
+			return statusFlag;
+		}
+		/* check for active set change: we need at least one AS change to get new Hessian information in next step */
+		if ((alphaMin < 1. - qpData->options.equalityTolerance)
+				&& (*alpha < alphaMin)) {
+			*alpha = alphaMin;
+		}
+		break;
+
+	case QPDUNES_LS_GOLDEN_SECTION_LS:
+		/* TODO: add zi and dz at some point after finishing line search!!! */
+		statusFlag = qpDUNES_goldenSectionIntervalSearch(qpData, alpha, itCntr, lambda, deltaLambdaFS, lambdaTry, nV, alphaMin, alphaMax);
+		break;
+
+	case QPDUNES_LS_GRADIENT_BISECTION_LS:
+		statusFlag = qpDUNES_bisectionIntervalSearch(qpData, alpha, itCntr,
+				deltaLambdaFS, lambdaTry, nV, alphaMin, alphaMax);
+		break;
+
+	case QPDUNES_LS_ACCELERATED_GRADIENT_BISECTION_LS: /* first backtracking line search, then gradient bisection search */
+		statusFlag = qpDUNES_backTrackingLineSearch(qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent);
+		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) { /* handle backtracking line search errors */
+			return statusFlag;
+		}
+		alphaMax = qpDUNES_fmin(alphaMax, (*alpha) / qpData->options.lineSearchReductionFactor); /* take last alpha that did not yet lead to ascent */
+		statusFlag = qpDUNES_bisectionIntervalSearch( qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, alphaMin, alphaMax );
+		break;
+
+	case QPDUNES_LS_GRID_LS:
+		statusFlag = qpDUNES_gridSearch( qpData, alpha, itCntr, objValIncumbent, alphaMin, alphaMax );
+		break;
+
+	case QPDUNES_LS_ACCELERATED_GRID_LS: /* backtracking line search as starter to reduce search interval, then grid search */
+		statusFlag = qpDUNES_backTrackingLineSearch( qpData, alpha, itCntr,	deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent );
+		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) { /* handle backtracking line search errors */
+			return statusFlag;
+		}
+		alphaMax = qpDUNES_fmin(alphaMax, (*alpha) / qpData->options.lineSearchReductionFactor); /* take last alpha that did not yet lead to ascent */
+
+		statusFlag = qpDUNES_gridSearch( qpData, alpha, itCntr, objValIncumbent, alphaMin, alphaMax );
+		break;
+
+	default:
+		statusFlag = QPDUNES_ERR_UNKNOWN_LS_TYPE;
+		break;
+	}
+
+	/* UPDATE VARIABLES */
+	/* lambda */
+	addScaledVector(lambda, *alpha, deltaLambdaFS, nV);
+	/* stage QP variables */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+		if (interval->lambdaHasChanged == QPDUNES_FALSE) {
+			continue;
+		}
+		/* TODO: this might have already been done in line search; do not redo */
+		/* update primal, dual, and internal QP solver variables */
+		switch (interval->qpSolverSpecification) {
+		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+			directQpSolver_doStep(qpData, interval,
+					&(interval->qpSolverClipping.dz), *alpha,
+					&(interval->qpSolverClipping.zUnconstrained),
+					&(interval->z), &(interval->y), &(interval->q),
+					&(interval->p));
+			break;
+
+		case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+			#ifndef __SIMPLE_BOUNDS_ONLY__
+				qpOASES_doStep(qpData, interval->qpSolverQpoases.qpoasesObject,
+						interval, *alpha, &(interval->z), &(interval->y),
+						&(interval->q), &(interval->p));
+				break;
+			#else
+				qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
+				return QPDUNES_ERR_INVALID_ARGUMENT;
+			#endif /* __SIMPLE_BOUNDS_ONLY__ */
+
+		default:
+			qpDUNES_printError(qpData, __FILE__, __LINE__,
+					"Stage QP solver undefined! Bailing out...");
+			return QPDUNES_ERR_UNKNOWN_ERROR;
+		}
+	}
+	*objValIncumbent = qpDUNES_updateObjectiveValue(qpData);
+
+	/* return */
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_determineStepLength */
+
+
+/* ----------------------------------------------
+ * ...
+ *
+ >>>>>>                                           */
+return_t qpDUNES_backTrackingLineSearch(	qpData_t* const qpData,
+										real_t* const alpha,
+										uint_t* const itCntr,
+										const xn_vector_t* const deltaLambdaFS,
+										xn_vector_t* const lambdaTry,
+										int_t nV,
+										real_t alphaMin,
+										real_t alphaMax,
+										real_t const objValIncumbent
+										)
+{
+	real_t objVal;
+
+	real_t minimumProgress = qpData->options.lineSearchMinRelProgress * fabs(objValIncumbent) + qpData->options.lineSearchMinAbsProgress;
+	real_t normDeltaLambda = vectorNorm( deltaLambdaFS, nV );
+
+	*alpha = alphaMax;
+
+	/** perform line search */
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchIterations; ++(*itCntr) )
+	{
+		/* get objective value */
+		objVal = qpDUNES_computeParametricObjectiveValue(qpData, *alpha);
+
+		/* check for progress */
+		if (objVal > objValIncumbent + minimumProgress) {
+			return QPDUNES_OK;
+		}
+		else { /* try smaller step size */
+			*alpha = (*alpha) * qpData->options.lineSearchReductionFactor;
+		}
+
+		/* ensure minimum step size */
+		if (normDeltaLambda * (*alpha - alphaMin) < qpData->options.equalityTolerance) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Backtracking line search: Deceeded minimum step size.\n        Itertation %d\n        alpha = %.3e\n        alphaMin = %.3e\n        normDeltaLambda = %.3e\n        minimumProgress = %.3e\n        last objVal = %.12e\n        objValIncumbet = %.12e", *itCntr, *alpha, alphaMin, normDeltaLambda, minimumProgress, objVal, objValIncumbent );
+			*alpha = alphaMin;
+			return QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE;
+		}
+	}
+
+	if ( qpData->options.printLevel >= 3 ) {
+		qpDUNES_printf("Leaving backtracking line search due to iteration limit, with alpha = %.3e. ObjVal = %.3e, incumbent objVal = %.3e", *alpha, objVal, objValIncumbent );
+	}
+	qpDUNES_printWarning( qpData, __FILE__, __LINE__, "Backtracking line search: Maximum number of iterations reached" );
+	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+}
+/*<<< END OF qpDUNES_backTrackingLineSearch */
+
+
+/* ----------------------------------------------
+ * ...
+ *
+ >>>>>>                                           */
+return_t qpDUNES_reductionLineSearchWithASChange(	qpData_t* const qpData,
+													real_t* const alpha,
+													uint_t* const itCntr,
+													xn_vector_t* const lambda,
+													const xn_vector_t* const deltaLambdaFS,
+													xn_vector_t* const lambdaTry,
+													int_t nV, real_t alphaMin, real_t alphaMax,
+													real_t const objValIncumbent)
+{
+	real_t minimumProgress;
+	real_t objVal;
+
+	int_t nChgdConstr;
+
+	assert(1 == 0);
+	printf("qpDUNES_reductionLineSearchWithASChange not fixed yet!");
+
+	minimumProgress = qpData->options.lineSearchMinRelProgress
+			* fabs(objValIncumbent) + qpData->options.lineSearchMinAbsProgress;
+
+	/** perform bisection */
+	/* We know that objVal(alphaMax) < objValIncumbent, and objVal(alphaMin) > objValIncumbent
+	 * We also know that alphaMax induces AS changes, while alphaMin does not induce AS changes
+	 */
+	for ( /*continuous itCntr*/;
+			(*itCntr) < qpData->options.maxNumLineSearchRefinementIterations;
+			++(*itCntr)) {
+		*alpha = 0.5 * (alphaMin + alphaMax);
+		addVectorScaledVector(lambdaTry, lambda, *alpha, deltaLambdaFS, nV);
+		qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+		objVal = qpDUNES_computeObjectiveValue(qpData);
+
+		if (objVal < objValIncumbent + minimumProgress) { /* no progress */
+			alphaMax = (*alpha);
+		} else { /* we make progress at current candidate */
+			qpDUNES_printf(	"qpDUNES_reductionLineSearchWithASChange() currently not usable" );
+			assert(1 == 0);
+			if (nChgdConstr <= 0) { /* no active set changes */
+				alphaMin = (*alpha);
+			} else { /* both progress and AS changes */
+				return QPDUNES_OK;
+			}
+		}
+	}
+
+	qpDUNES_printError(qpData, __FILE__, __LINE__,
+			"Backtracking line search: Maximum number of iterations reached");
+	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+}
+/*<<< END OF qpDUNES_backTrackingLineSearch */
+
+
+/* ----------------------------------------------
+ * golden section interval reduction search on interval ]alphaMin,alphaMax[
+ * WARNING: currently no direct check for full steps implemented
+ *
+ >>>>>>                                           */
+return_t qpDUNES_goldenSectionIntervalSearch(	qpData_t* const qpData,
+											real_t* const alpha,
+											uint_t* const itCntr,
+											xn_vector_t* const lambda,
+											const xn_vector_t* const deltaLambdaFS,
+											xn_vector_t* const lambdaTry,
+											int_t nV,
+											real_t alphaMin,
+											real_t alphaMax	)
+{
+	real_t objValLL, objValL, objValR, objValRR;
+	real_t aLL, aL, aR, aRR;
+	real_t alphaCheckedLast;
+
+	real_t goldSec = 0.6180339887; /**< golden section ratio for interval line search (sqrt(5)-1)/2 */
+	
+	assert(1 == 0);
+	printf("qpDUNES_goldenSectionIntervalSearch not fixed yet!");
+
+	aLL = alphaMin;
+	addVectorScaledVector(lambdaTry, lambda, aLL, deltaLambdaFS, nV);
+	qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+	objValLL = qpDUNES_computeObjectiveValue(qpData);
+
+	aRR = alphaMax;
+	addVectorScaledVector(lambdaTry, lambda, aRR, deltaLambdaFS, nV);
+	qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+	objValRR = qpDUNES_computeObjectiveValue(qpData);
+
+	/** (1) ensure that L, R have bigger objective Values than LL and RR, respectively */
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
+		aL = aRR - goldSec * (aRR);
+		addVectorScaledVector(lambdaTry, lambda, aL, deltaLambdaFS, nV);
+		qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+		objValL = qpDUNES_computeObjectiveValue(qpData);
+
+		if (objValLL > objValL) { /* minimum has to lie on left-most interval */
+			aRR = aL;
+			objValRR = objValL;
+			continue;
+		} else {
+			break;
+		}
+	}
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
+		aR = aLL + goldSec * (aRR - aLL);
+		addVectorScaledVector(lambdaTry, lambda, aR, deltaLambdaFS, nV);
+		qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+		objValR = qpDUNES_computeObjectiveValue(qpData);
+
+		if (objValRR > objValR) { /* minimum has to lie on right-most interval */
+			aLL = aR;
+			objValLL = objValR;
+			continue;
+		} else {
+			break;
+		}
+	}
+	alphaCheckedLast = aR;
+
+	/** (2) regular golden section interval search */
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
+		/* check for stationarity */
+		if ( (2 * objValL - objValR - objValLL <= 2 * qpData->options.lineSearchStationarityTolerance)
+			 || (2 * objValR - objValL - objValRR <= 2 * qpData->options.lineSearchStationarityTolerance))
+		{
+			/* use last computed a in case of stationarity for consistent lambda and alpha.
+			 * This can lead to a slightly worse IS performance than always taking the minimum,
+			 * but is easier to handle in terms of memory management, etc.
+			 */
+			*alpha = alphaCheckedLast;
+			return QPDUNES_OK;
+		}
+
+		/* remove one interval */
+		if (objValL >= objValR) { /* throw out right interval */
+			aRR = aR;
+			aR = aL;
+			objValRR = objValR;
+			objValR = objValL;
+
+			aL = aRR - goldSec * (aRR - aLL);
+			addVectorScaledVector(lambdaTry, lambda, aL, deltaLambdaFS, nV);
+			qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+			alphaCheckedLast = aL;
+			objValL = qpDUNES_computeObjectiveValue(qpData);
+		} else { /* throw out left interval */
+			aLL = aL;
+			aL = aR;
+			objValLL = objValL;
+			objValL = objValR;
+
+			aR = aLL + goldSec * (aRR - aLL);
+			addVectorScaledVector(lambdaTry, lambda, aR, deltaLambdaFS, nV);
+			qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
+			alphaCheckedLast = aR;
+			objValR = qpDUNES_computeObjectiveValue(qpData);
+		}
+	}
+
+	*alpha = alphaCheckedLast;
+	qpDUNES_printError(qpData, __FILE__, __LINE__,
+			"Golden section interval search: Maximum number of iterations reached");
+	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+}
+/*<<< END OF qpDUNES_goldenSectionIntervalSearch */
+
+
+/* ----------------------------------------------
+ * ...
+ *
+ >>>>>>                                           */
+return_t qpDUNES_bisectionIntervalSearch(	qpData_t* const qpData,
+										real_t* const alpha,
+										uint_t* const itCntr,
+										const xn_vector_t* const deltaLambdaFS,
+										xn_vector_t* const lambdaTry,
+										int_t nV,
+										real_t alphaMin,
+										real_t alphaMax
+										)
+{
+	return_t statusFlag;
+
+	real_t alphaC = 1.0;
+	real_t alphaGradientTry = -1.;	/* step size gradientTry was last evaluated at */
+
+	real_t alphaSlope;
+	real_t slopeNormalization = qpDUNES_fmin( 1., vectorNorm((vector_t*)deltaLambdaFS,nV) ); 	/* demand more stationarity for smaller steps */
+
+
+	/* todo: get memory passed on from determine step length */
+	/* gradient at accepted step is reused in the next Newton iteration, see qpDUNES_getNewtonGradient */
+	xn_vector_t* gradientTry = &(qpData->lsGradient);
+
+	/* TODO: take line search iterations and maxNumLineSearchRefinementIterations together! */
+	/** (1) check if full step is stationary or even still ascent direction */
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
+		/* trial primal solution, gradient and slope for alpha guess */
+		statusFlag = qpDUNES_evaluateTrialPoint( qpData, alphaMax, deltaLambdaFS, gradientTry, 0, &alphaSlope );
+		if (statusFlag != QPDUNES_OK) {
+			*alpha = alphaMin;
+			return statusFlag;
+		}
+		alphaGradientTry = alphaMax;
+
+		/* take full step if stationary */
+		if (fabs(alphaSlope / slopeNormalization) <= qpData->options.lineSearchStationarityTolerance)
+		{
+			*alpha = alphaMax;
+			qpData->lsGradientIsValid = QPDUNES_TRUE;
+			return QPDUNES_OK;
+		}
+
+		/* go into normal interval search if full step leads to descent */
+		if (alphaSlope / slopeNormalization < 0.) {
+			break;
+		}
+
+		/* increase step size otherwise (full step still leads to ascent) */
+		alphaMin = alphaMax;
+		alphaMax *= qpData->options.lineSearchIncreaseFactor;
+
+		/* break if maximum step size reached */
+		if (alphaMax > qpData->options.lineSearchMaxStepSize) {
+			*alpha = alphaMin;
+			if ( qpData->options.printLevel >= 3 ) {
+				qpDUNES_printWarning(qpData, __FILE__, __LINE__, "(info) Bisection interval search: Maximum step size reached");
+			}
+			if ( qpData->options.printLevel >= 3 ) {
+				qpDUNES_printf("Alpha = %.15e taken prior to stationarity, alphaSlope = %.15e, normalization = %.15e", *alpha, alphaSlope, slopeNormalization );
+			}
+			qpData->lsGradientIsValid = (*alpha == alphaGradientTry) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			return QPDUNES_ERR_EXCEEDED_MAX_LINESEARCH_STEPSIZE;
+		}
+	}
+
+
+	/** (2) regular bisection interval search */
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr) ) {
+		alphaC = 0.5 * (alphaMin + alphaMax);
+
+		/* trial primal solution, gradient and slope for alpha guess */
+		statusFlag = qpDUNES_evaluateTrialPoint( qpData, alphaC, deltaLambdaFS, gradientTry, 0, &alphaSlope );
+		if (statusFlag != QPDUNES_OK) {
+			*alpha = alphaMin;
+			return statusFlag;
+		}
+		alphaGradientTry = alphaC;
+
+		/* check for stationarity in search direction */
+		if ( fabs(alphaSlope / slopeNormalization) <= qpData->options.lineSearchStationarityTolerance ) {
+			if ( qpData->options.printLevel >= 3 ) {
+				qpDUNES_printf("AlphaC = %.5e is stationary, alphaSlope = %.3e, normalization = %.3e", alphaC, alphaSlope, slopeNormalization );
+			}
+			*alpha = alphaC;
+			qpData->lsGradientIsValid = QPDUNES_TRUE;
+			return QPDUNES_OK;
+		}
+		else {
+			/* half interval */
+			if (alphaSlope > 0) { /* ascent right of gradient */
+				alphaMin = alphaC; /* throw out left interval */
+			}
+			else { /* ascent left of gradient */
+				alphaMax = alphaC; /* throw out right interval */
 			}
 		}
-		*objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
-		return QPDUNES_OK;
 	}
 
+	#ifdef __DEBUG__
+	if( qpData->options.printLevel >= 3 ) {
+		qpDUNES_printf( "Bisection interval search: itCntr = %d, last alpha: %.3e", *itCntr, alphaC );
+	}
+	#endif
+	qpDUNES_printWarning( qpData, __FILE__, __LINE__,	"Bisection interval search: Maximum number of iterations reached!" );
+	*alpha = alphaC;
+	qpData->lsGradientIsValid = (*alpha == alphaGradientTry) ? QPDUNES_TRUE : QPDUNES_FALSE;
 
-	/* do a line search */
-	switch (qpData->options.lsType) {
-	case QPDUNES_LS_BACKTRACKING_LS:
-		statusFlag = qpDUNES_backTrackingLineSearch( qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent );
-		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) {
-			return statusFlag;
-		}
-		break;
+	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+}
+/*<<< END OF qpDUNES_bisectionIntervalSearch */
 
-	case QPDUNES_LS_BACKTRACKING_LS_WITH_AS_CHANGE:
-		statusFlag = qpDUNES_backTrackingLineSearch(qpData, alpha, itCntr,
-				deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent);
-		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) {
-			return statusFlag;
-		}
-		/* check for active set change: we need at least one AS change to get new Hessian information in next step */
-		if ((alphaMin < 1. - qpData->options.equalityTolerance)
-				&& (*alpha < alphaMin)) {
-			*alpha = alphaMin;
-		}
-		break;
 
-	case QPDUNES_LS_GOLDEN_SECTION_LS:
-		/* TODO: add zi and dz at some point after finishing line search!!! */
-		statusFlag = qpDUNES_goldenSectionIntervalSearch(qpData, alpha, itCntr, lambda, deltaLambdaFS, lambdaTry, nV, alphaMin, alphaMax);
-		break;
+/* ----------------------------------------------
+ * grid search on [alphaMin,alphaMax]; all grid points are evaluated
+ * in one sweep over the horizon (several sweeps if the number of grid
+ * points was increased beyond the allocated lsGridSize after setup)
+ *
+ >>>>>>                                           */
+return_t qpDUNES_gridSearch( qpData_t* const qpData, 
+							 real_t* const alpha,
+							 uint_t* const itCntr, 
+							 real_t* const objValIncumbent, 
+							 real_t alphaMin,
+							 real_t alphaMax) 
+{
+	int_t aa, kk;
+	int_t nAlpha;
 
-	case QPDUNES_LS_GRADIENT_BISECTION_LS:
-		statusFlag = qpDUNES_bisectionIntervalSearch(qpData, alpha, itCntr,
-				deltaLambdaFS, lambdaTry, nV, alphaMin, alphaMax);
-		break;
+	return_t statusFlag;
 
-	case QPDUNES_LS_ACCELERATED_GRADIENT_BISECTION_LS: /* first backtracking line search, then gradient bisection search */
-		statusFlag = qpDUNES_backTrackingLineSearch(qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent);
-		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) { /* handle backtracking line search errors */
-			return statusFlag;
-		}
-		alphaMax = qpDUNES_fmin(alphaMax, (*alpha) / qpData->options.lineSearchReductionFactor); /* take last alpha that did not yet lead to ascent */
-		statusFlag = qpDUNES_bisectionIntervalSearch( qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, alphaMin, alphaMax );
-		break;
+	int_t nGridPoints = qpData->options.lineSearchNbrGridPoints;
 
-	case QPDUNES_LS_GRID_LS:
-		statusFlag = qpDUNES_gridSearch( qpData, alpha, itCntr, objValIncumbent, alphaMin, alphaMax );
-		break;
+	for (kk = 0; kk < nGridPoints; kk += nAlpha) {
+		nAlpha = qpDUNES_min( qpData->lsGridSize, nGridPoints - kk );
+		for (aa = 0; aa < nAlpha; ++aa) {
+			qpData->lsGridAlpha[aa] = alphaMin + (kk + aa) * (alphaMax - alphaMin) / (nGridPoints - 1);
+		}
 
-	case QPDUNES_LS_ACCELERATED_GRID_LS: /* backtracking line search as starter to reduce search interval, then grid search */
-		statusFlag = qpDUNES_backTrackingLineSearch( qpData, alpha, itCntr,	deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent );
-		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) { /* handle backtracking line search errors */
+		statusFlag = qpDUNES_computeGridObjectiveValues( qpData, nAlpha, qpData->lsGridAlpha, qpData->lsGridObjVal );
+		if (statusFlag != QPDUNES_OK) {
 			return statusFlag;
 		}
-		alphaMax = qpDUNES_fmin(alphaMax, (*alpha) / qpData->options.lineSearchReductionFactor); /* take last alpha that did not yet lead to ascent */
-
-		statusFlag = qpDUNES_gridSearch( qpData, alpha, itCntr, objValIncumbent, alphaMin, alphaMax );
-		break;
 
-	default:
-		statusFlag = QPDUNES_ERR_UNKNOWN_LS_TYPE;
-		break;
+		for (aa = 0; aa < nAlpha; ++aa) {
+			if (qpData->lsGridObjVal[aa] > *objValIncumbent) {
+				*objValIncumbent = qpData->lsGridObjVal[aa];
+				*alpha = qpData->lsGridAlpha[aa];
+			}
+		}
 	}
+	*itCntr += nGridPoints;
 
-	/* UPDATE VARIABLES */
-	/* lambda */
-	addScaledVector(lambda, *alpha, deltaLambdaFS, nV);
-	/* stage QP variables */
-	for (kk = 0; kk < _NI_ + 1; ++kk) {
-		interval = qpData->intervals[kk];
-		/* TODO: this might have already been done in line search; do not redo */
-		/* update primal, dual, and internal QP solver variables */
-		switch (interval->qpSolverSpecification) {
-		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
-			directQpSolver_doStep(qpData, interval,
-					&(interval->qpSolverClipping.dz), *alpha,
-					&(interval->qpSolverClipping.zUnconstrained),
-					&(interval->z), &(interval->y), &(interval->q),
-					&(interval->p));
-			break;
 
-		case QPDUNES_STAGE_QP_SOLVER_QPOASES:
-			#ifndef __SIMPLE_BOUNDS_ONLY__
-				qpOASES_doStep(qpData, interval->qpSolverQpoases.qpoasesObject,
-						interval, *alpha, &(interval->z), &(interval->y),
-						&(interval->q), &(interval->p));
-				break;
-			#else
-				qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
-				return QPDUNES_ERR_INVALID_ARGUMENT;
-			#endif /* __SIMPLE_BOUNDS_ONLY__ */
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_gridSearch */
 
-		default:
-			qpDUNES_printError(qpData, __FILE__, __LINE__,
-					"Stage QP solver undefined! Bailing out...");
-			return QPDUNES_ERR_UNKNOWN_ERROR;
+
+/* ----------------------------------------------
+ * certificate based infeasibility check
+ *
+ *   The coupling constraints are infeasible if a direction r exists with
+ *     min_{z_k in stage boxes} sum_k r_k.T*( C_k*z_k + c_k - x_{k+1} ) > 0,
+ *   i.e., the dual function grows without bound along r. Every stage
+ *   feasible point then violates the coupling by at least this bound
+ *   divided by ||r||_inf (in 1-norm); the problem is declared infeasible
+ *   if that exceeds the stationarity tolerance. Candidate directions are
+ *   the current Newton step and the multiplier iterate itself, which
+ *   aligns with the unbounded ray as lambda diverges.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_infeasibilityCheck(	qpData_t* qpData
+										)
+{
+	int_t kk;
+
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (qpData->intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
+			qpDUNES_printWarning(qpData, __FILE__, __LINE__, "Infeasibility check is only supported with clipping stage QPs. Skipping.");
+			return QPDUNES_OK;
 		}
 	}
-	*objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
 
-	/* return */
-	return statusFlag;
+	if ( (qpDUNES_getCouplingViolationBound(qpData, &(qpData->deltaLambda)) > qpData->options.stationarityTolerance) ||
+		 (qpDUNES_getCouplingViolationBound(qpData, &(qpData->lambda)) > qpData->options.stationarityTolerance) )
+	{
+		return QPDUNES_ERROR_STAGE_COUPLING_INFEASIBLE;
+	}
+
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_determineStepLength */
+/*<<< END OF qpDUNES_infeasibilityCheck */
 
 
 /* ----------------------------------------------
- * ...
+ * lower bound on the coupling constraint violation (1-norm) of any
+ * stage feasible point, obtained from direction dir; non-positive if
+ * dir is no certificate of infeasibility
  *
  >>>>>>                                           */
-return_t qpDUNES_backTrackingLineSearch(	qpData_t* const qpData,
-										real_t* const alpha,
-										uint_t* const itCntr,
-										const xn_vector_t* const deltaLambdaFS,
-										xn_vector_t* const lambdaTry,
-										int_t nV,
-										real_t alphaMin,
-										real_t alphaMax,
-										real_t const objValIncumbent
-										)
+real_t qpDUNES_getCouplingViolationBound(	qpData_t* const qpData,
+											const xn_vector_t* const dir
+											)
 {
-	real_t objVal;
+	int_t ii, kk;
+	interval_t* interval;
 
-	real_t minimumProgress = qpData->options.lineSearchMinRelProgress * fabs(objValIncumbent) + qpData->options.lineSearchMinAbsProgress;
-	real_t normDeltaLambda = vectorNorm( deltaLambdaFS, nV );
+	real_t dirNorm = 0.;
+	real_t minResidual = 0.;	/* min_z dir.T*residual(z) over stage boxes */
 
-	*alpha = alphaMax;
+	for (ii = 0; ii < _NXTTL_; ++ii) {
+		dirNorm = qpDUNES_fmax( dirNorm, fabs(dir->data[ii]) );
+	}
+	if (dirNorm <= qpData->options.QPDUNES_ZERO) {
+		return 0.;
+	}
 
-	/** perform line search */
-	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchIterations; ++(*itCntr) )
-	{
-		/* get objective value */
-		objVal = qpDUNES_computeParametricObjectiveValue(qpData, *alpha);
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
 
-		/* check for progress */
-		if (objVal > objValIncumbent + minimumProgress) {
-			return QPDUNES_OK;
+		/* linear coefficient of stage variables: C_k.T*dir_k - [dir_{k-1}; 0] */
+		if (kk < _NI_) {
+			qpDUNES_copyArray(interval->xVecTmp.data, &(dir->data[_XNOFF(kk)]), _NX(kk+1));
+			multiplyCTy(&(interval->zVecTmp), &(interval->C), &(interval->xVecTmp), _NX(kk+1), interval->nV);
+			minResidual += scalarProd(&(interval->xVecTmp), &(interval->c), _NX(kk+1));
 		}
-		else { /* try smaller step size */
-			*alpha = (*alpha) * qpData->options.lineSearchReductionFactor;
+		else {
+			qpDUNES_setupZeroVector(&(interval->zVecTmp), interval->nV);
+		}
+		if (kk > 0) {
+			for (ii = 0; ii < (int_t)interval->nX; ++ii) {
+				interval->zVecTmp.data[ii] -= dir->data[_XNOFF(kk - 1) + ii];
+			}
 		}
 
-		/* ensure minimum step size */
-		if (normDeltaLambda * (*alpha - alphaMin) < qpData->options.equalityTolerance) {
-			qpDUNES_printError( qpData, __FILE__, __LINE__, "Backtracking line search: Deceeded minimum step size.\n        Itertation %d\n        alpha = %.3e\n        alphaMin = %.3e\n        normDeltaLambda = %.3e\n        minimumProgress = %.3e\n        last objVal = %.12e\n        objValIncumbet = %.12e", *itCntr, *alpha, alphaMin, normDeltaLambda, minimumProgress, objVal, objValIncumbent );
-			*alpha = alphaMin;
-			return QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE;
+		/* minimize over box, separable */
+		for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+			if ( (interval->softL1.data != 0) &&
+				 ((interval->softL1.data[ii] > 0.) || (interval->softL2.data[ii] > 0.)) )
+			{
+				/* soft bounds do not restrict the primal variable */
+				minResidual -= fabs(interval->zVecTmp.data[ii]) * qpData->options.QPDUNES_INFTY;
+				continue;
+			}
+			if (interval->zVecTmp.data[ii] > 0.) {
+				minResidual += interval->zVecTmp.data[ii] * interval->zLow.data[ii];
+			}
+			else {
+				minResidual += interval->zVecTmp.data[ii] * interval->zUpp.data[ii];
+			}
 		}
 	}
 
-	if ( qpData->options.printLevel >= 3 ) {
-		qpDUNES_printf("Leaving backtracking line search due to iteration limit, with alpha = %.3e. ObjVal = %.3e, incumbent objVal = %.3e", *alpha, objVal, objValIncumbent );
+	return minResidual / dirNorm;
+}
+/*<<< END OF qpDUNES_getCouplingViolationBound */
+
+
+/* ----------------------------------------------
+ * ...
+ * 
+ >>>>>>                                           */
+void qpDUNES_getPrimalSol(const qpData_t* const qpData, real_t* const z) {
+	int_t ii, kk;
+	int_t nZoffset = 0;
+
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		qpDUNES_copyArray(&(z[nZoffset]), qpData->intervals[kk]->z.data,
+				qpData->intervals[kk]->nV);
+		/* undo variable scaling */
+		if (qpData->intervals[kk]->scaling.data != 0) {
+			for (ii = 0; ii < (int_t)qpData->intervals[kk]->nV; ++ii) {
+				z[nZoffset + ii] *= qpData->intervals[kk]->scaling.data[ii];
+			}
+		}
+		nZoffset += qpData->intervals[kk]->nV;
 	}
-	qpDUNES_printWarning( qpData, __FILE__, __LINE__, "Backtracking line search: Maximum number of iterations reached" );
-	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+
+	return;
 }
-/*<<< END OF qpDUNES_backTrackingLineSearch */
+/*<<< END OF qpDUNES_getPrimalSol */
 
+// 
+// /* ----------------------------------------------
+//  * ...
+//  *
+//  >>>>>>                                           */
+// void qpDUNES_getDualSol(const qpData_t* const qpData, real_t* const lambda,
+// 		real_t* const y) {
+// 
+// 	qpDUNES_printWarning( qpData, __FILE__, __LINE__, "getDualSol currently not working" );	/* TODO: fix getDualSol */
+// 
+// 	return;
+// }
+// /*<<< END OF qpDUNES_getDualSol */
 
 /* ----------------------------------------------
  * ...
  *
  >>>>>>                                           */
-return_t qpDUNES_reductionLineSearchWithASChange(	qpData_t* const qpData,
-													real_t* const alpha,
-													uint_t* const itCntr,
-													xn_vector_t* const lambda,
-													const xn_vector_t* const deltaLambdaFS,
-													xn_vector_t* const lambdaTry,
-													int_t nV, real_t alphaMin, real_t alphaMax,
-													real_t const objValIncumbent)
-{
-	real_t minimumProgress;
-	real_t objVal;
-
-	int_t nChgdConstr;
+return_t qpDUNES_getDualSol(const qpData_t* const qpData, real_t* const lambda, real_t* const y) {
+	int_t kk, ii;
 
-	assert(1 == 0);
-	printf("qpDUNES_reductionLineSearchWithASChange not fixed yet!");
+	int_t nStageMult;
+	int_t nDOffset = 0;
+	const interval_t* interval;
+	real_t violation;
+	
+	qpDUNES_printWarning( qpData, __FILE__, __LINE__, "getDualSol is highly experimental. Expect incorrect multiplers." );
 
-	minimumProgress = qpData->options.lineSearchMinRelProgress
-			* fabs(objValIncumbent) + qpData->options.lineSearchMinAbsProgress;
+	/* get lambda */
+	qpDUNES_copyArray( lambda, qpData->lambda.data, _NXTTL_ );
+	for( kk=0; kk<_NI_; ++kk ) {
+		if ( qpData->intervals[kk+1]->scaling.data != 0 ) {		/* undo scaling of the coupling rows */
+			for ( ii=0; ii<_NX(kk+1); ++ii ) {
+				lambda[_XNOFF(kk)+ii] /= qpData->intervals[kk+1]->scaling.data[ii];
+			}
+		}
+	}
 
-	/** perform bisection */
-	/* We know that objVal(alphaMax) < objValIncumbent, and objVal(alphaMin) > objValIncumbent
-	 * We also know that alphaMax induces AS changes, while alphaMin does not induce AS changes
-	 */
-	for ( /*continuous itCntr*/;
-			(*itCntr) < qpData->options.maxNumLineSearchRefinementIterations;
-			++(*itCntr)) {
-		*alpha = 0.5 * (alphaMin + alphaMax);
-		addVectorScaledVector(lambdaTry, lambda, *alpha, deltaLambdaFS, nV);
-		qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-		objVal = qpDUNES_computeObjectiveValue(qpData);
+	/* get y */
+	for( kk=0; kk<_NI_+1; ++kk ) {
+		nStageMult = 2* (qpData->intervals[kk]->nV + qpData->intervals[kk]->nD);
+		switch (qpData->intervals[kk]->qpSolverSpecification)	{
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				/* we still have to clean the multipliers */
+				for ( ii=0; ii<nStageMult; ++ii )	{
+					y[nDOffset+ii] = (qpData->intervals[kk]->y.data[ii] > 0)  ?  qpData->intervals[kk]->y.data[ii]  :  0.0;
+				}
+				/* penalized soft bounds carry the penalty gradient softL1 + softL2*violation */
+				interval = qpData->intervals[kk];
+				if ( interval->softL1.data != 0 ) {
+					for ( ii=0; ii<(int_t)interval->nV; ++ii ) {
+						if ( ( interval->softL1.data[ii] <= 0. ) && ( interval->softL2.data[ii] <= 0. ) )	continue;
+						violation = interval->zLow.data[ii] - interval->z.data[ii];
+						if ( violation > 0. ) {
+							y[nDOffset+2*ii] = interval->softL1.data[ii] + interval->softL2.data[ii] * violation;
+						}
+						violation = interval->z.data[ii] - interval->zUpp.data[ii];
+						if ( violation > 0. ) {
+							y[nDOffset+2*ii+1] = interval->softL1.data[ii] + interval->softL2.data[ii] * violation;
+						}
+					}
+				}
+				break;
 
-		if (objVal < objValIncumbent + minimumProgress) { /* no progress */
-			alphaMax = (*alpha);
-		} else { /* we make progress at current candidate */
-			qpDUNES_printf(	"qpDUNES_reductionLineSearchWithASChange() currently not usable" );
-			assert(1 == 0);
-			if (nChgdConstr <= 0) { /* no active set changes */
-				alphaMin = (*alpha);
-			} else { /* both progress and AS changes */
-				return QPDUNES_OK;
+			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+				qpDUNES_copyArray( &(y[nDOffset]), qpData->intervals[kk]->y.data, nStageMult );
+				break;
+
+			default:
+				qpDUNES_printError( qpData, __FILE__, __LINE__,	"Stage QP %d solver undefined! Bailing out...", kk );
+				return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+		/* bound multipliers refer to scaled variables; general constraints are not scaled */
+		if ( qpData->intervals[kk]->scaling.data != 0 ) {
+			for ( ii=0; ii<(int_t)qpData->intervals[kk]->nV; ++ii ) {
+				y[nDOffset+2*ii] /= qpData->intervals[kk]->scaling.data[ii];
+				y[nDOffset+2*ii+1] /= qpData->intervals[kk]->scaling.data[ii];
 			}
 		}
+		nDOffset += nStageMult;
 	}
-
-	qpDUNES_printError(qpData, __FILE__, __LINE__,
-			"Backtracking line search: Maximum number of iterations reached");
-	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_backTrackingLineSearch */
+/*<<< END OF qpDUNES_getDualSol */
 
 
 /* ----------------------------------------------
- * golden section interval reduction search on interval ]alphaMin,alphaMax[
- * WARNING: currently no direct check for full steps implemented
+ * make Newton Hessian factor consistent with the current active set
+ *
+ * qpDUNES_solve terminates on a zero gradient before the Newton
+ * Hessian is rebuilt, so the factor corresponds to the active set
+ * before the last step; only blocks of changed stages are rebuilt
  *
  >>>>>>                                           */
-return_t qpDUNES_goldenSectionIntervalSearch(	qpData_t* const qpData,
-											real_t* const alpha,
-											uint_t* const itCntr,
-											xn_vector_t* const lambda,
-											const xn_vector_t* const deltaLambdaFS,
-											xn_vector_t* const lambdaTry,
-											int_t nV,
-											real_t alphaMin,
-											real_t alphaMax	)
+return_t qpDUNES_refreshNewtonFactor(	qpData_t* const qpData
+										)
 {
-	real_t objValLL, objValL, objValR, objValRR;
-	real_t aLL, aL, aR, aRR;
-	real_t alphaCheckedLast;
-
-	real_t goldSec = 0.6180339887; /**< golden section ratio for interval line search (sqrt(5)-1)/2 */
-	
-	assert(1 == 0);
-	printf("qpDUNES_goldenSectionIntervalSearch not fixed yet!");
-
-	aLL = alphaMin;
-	addVectorScaledVector(lambdaTry, lambda, aLL, deltaLambdaFS, nV);
-	qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-	objValLL = qpDUNES_computeObjectiveValue(qpData);
-
-	aRR = alphaMax;
-	addVectorScaledVector(lambdaTry, lambda, aRR, deltaLambdaFS, nV);
-	qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-	objValRR = qpDUNES_computeObjectiveValue(qpData);
+	int_t kk;
+	int_t lastActSetChangeIdx = -1;
+	boolean_t isHessianRegularized = QPDUNES_FALSE;
 
-	/** (1) ensure that L, R have bigger objective Values than LL and RR, respectively */
-	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
-		aL = aRR - goldSec * (aRR);
-		addVectorScaledVector(lambdaTry, lambda, aL, deltaLambdaFS, nV);
-		qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-		objValL = qpDUNES_computeObjectiveValue(qpData);
+	return_t statusFlag;
 
-		if (objValLL > objValL) { /* minimum has to lie on left-most interval */
-			aRR = aL;
-			objValRR = objValL;
-			continue;
-		} else {
-			break;
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (qpData->intervals[kk]->actSetHasChanged == QPDUNES_TRUE) {
+			lastActSetChangeIdx = kk;
 		}
 	}
-	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
-		aR = aLL + goldSec * (aRR - aLL);
-		addVectorScaledVector(lambdaTry, lambda, aR, deltaLambdaFS, nV);
-		qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-		objValR = qpDUNES_computeObjectiveValue(qpData);
-
-		if (objValRR > objValR) { /* minimum has to lie on right-most interval */
-			aLL = aR;
-			objValLL = objValR;
-			continue;
-		} else {
-			break;
-		}
+	if (lastActSetChangeIdx < 0) {
+		return QPDUNES_OK;		/* factor is up to date */
 	}
-	alphaCheckedLast = aR;
-
-	/** (2) regular golden section interval search */
-	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
-		/* check for stationarity */
-		if ( (2 * objValL - objValR - objValLL <= 2 * qpData->options.lineSearchStationarityTolerance)
-			 || (2 * objValR - objValL - objValRR <= 2 * qpData->options.lineSearchStationarityTolerance))
-		{
-			/* use last computed a in case of stationarity for consistent lambda and alpha.
-			 * This can lead to a slightly worse IS performance than always taking the minimum,
-			 * but is easier to handle in terms of memory management, etc.
-			 */
-			*alpha = alphaCheckedLast;
-			return QPDUNES_OK;
-		}
-
-		/* remove one interval */
-		if (objValL >= objValR) { /* throw out right interval */
-			aRR = aR;
-			aR = aL;
-			objValRR = objValR;
-			objValR = objValL;
 
-			aL = aRR - goldSec * (aRR - aLL);
-			addVectorScaledVector(lambdaTry, lambda, aL, deltaLambdaFS, nV);
-			qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-			alphaCheckedLast = aL;
-			objValL = qpDUNES_computeObjectiveValue(qpData);
-		} else { /* throw out left interval */
-			aLL = aL;
-			aL = aR;
-			objValLL = objValL;
-			objValL = objValR;
+	statusFlag = qpDUNES_setupNewtonHessian(qpData);
+	if (statusFlag != QPDUNES_OK) {
+		qpDUNES_printError(qpData, __FILE__, __LINE__, "Setup of Newton Hessian failed.");
+		return statusFlag;
+	}
+	statusFlag = qpDUNES_factorNewtonSystem(qpData, &isHessianRegularized, lastActSetChangeIdx);
+	if (statusFlag != QPDUNES_OK) {
+		qpDUNES_printError(qpData, __FILE__, __LINE__, "Factorization of Newton Equation failed.");
+		return statusFlag;
+	}
 
-			aR = aLL + goldSec * (aRR - aLL);
-			addVectorScaledVector(lambdaTry, lambda, aR, deltaLambdaFS, nV);
-			qpDUNES_solveAllLocalQPs(qpData, lambdaTry);
-			alphaCheckedLast = aR;
-			objValR = qpDUNES_computeObjectiveValue(qpData);
-		}
+	/* active set of the new factorization was saved during Hessian setup */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		qpData->intervals[kk]->actSetHasChanged = QPDUNES_FALSE;
 	}
 
-	*alpha = alphaCheckedLast;
-	qpDUNES_printError(qpData, __FILE__, __LINE__,
-			"Golden section interval search: Maximum number of iterations reached");
-	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_goldenSectionIntervalSearch */
+/*<<< END OF qpDUNES_refreshNewtonFactor */
 
 
 /* ----------------------------------------------
- * ...
+ * directional sensitivity of the solution w.r.t. the embedded
+ * initial value x0 and the dynamics offsets c_k (tangential predictor)
+ *
+ * for a fixed active set the Newton gradient G(lambda,x0,c) vanishes
+ * at the solution and dG/dlambda = -M, hence
+ *   M * dLambda = C_0 * E0 * dx0 + dc,
+ * which is solved with the existing Newton Hessian factor; E0 selects
+ * the states of stage 0 that are fixed at their bounds
  *
  >>>>>>                                           */
-return_t qpDUNES_bisectionIntervalSearch(	qpData_t* const qpData,
-										real_t* const alpha,
-										uint_t* const itCntr,
-										const xn_vector_t* const deltaLambdaFS,
-										xn_vector_t* const lambdaTry,
-										int_t nV,
-										real_t alphaMin,
-										real_t alphaMax
-										)
+return_t qpDUNES_getSensitivity(	qpData_t* const qpData,
+									const real_t* const dx0,		/**< initial value direction (nX), may be 0 */
+									const real_t* const dc,			/**< dynamics offset direction (nI*nX), may be 0 */
+									real_t* const dLambda,			/**< dual sensitivity (nI*nX) */
+									real_t* const dz				/**< primal sensitivity (nI*nZ+nX), may be 0 */
+									)
 {
-	int_t kk, ii;
-	interval_t* interval;
-
-	z_vector_t* zTry;
-	
-	real_t alphaC = 1.0;
+	int_t ii, kk;
+	int_t nZoffset = 0;
 
-	real_t alphaSlope;
-	real_t slopeNormalization = qpDUNES_fmin( 1., vectorNorm((vector_t*)deltaLambdaFS,nV) ); 	/* demand more stationarity for smaller steps */
+	xn_vector_t* rhs = &(qpData->xnVecTmp);
+	xn_vector_t* dLambdaVec = &(qpData->xnVecTmp2);
+	z_vector_t* dzStage = &(qpData->zVecTmp);
 
+	interval_t* interval;
+	boolean_t isActive;
 
-	/* todo: get memory passed on from determine step length */
-	xn_vector_t* gradientTry = &(qpData->xnVecTmp2);
-	/* todo: no need to recompute gradient in next Newton iteration! */
+	return_t statusFlag;
 
-	/* TODO: take line search iterations and maxNumLineSearchRefinementIterations together! */
-	/** (1) check if full step is stationary or even still ascent direction */
-	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
-		/* update z locally according to alpha guess */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			zTry = &(interval->zVecTmp);
-			/* get primal variables for trial step length */
-			addVectorScaledVector(zTry,	&(interval->qpSolverClipping.zUnconstrained), alphaMax,	&(interval->qpSolverClipping.dz), interval->nV);
-			directQpSolver_saturateVector(qpData, zTry, &(interval->y), &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV);
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if (qpData->intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
+			qpDUNES_printError(qpData, __FILE__, __LINE__, "Sensitivities are only supported for clipping stage QPs (stage %d).", kk);
+			return QPDUNES_ERR_INVALID_ARGUMENT;
 		}
+	}
 
-		/* manual gradient computation; TODO: use function, but watch out with z, dz, zTry, etc. */
-		for (kk = 0; kk < _NI_; ++kk) {
-			/* ( A_kk*x_kk^opt + B_kk*u_kk^opt + c_kk ) - x_(kk+1)^opt */
-			multiplyCz( qpData, &(qpData->xVecTmp), &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp) );
-			addToVector(&(qpData->xVecTmp), &(qpData->intervals[kk]->c), _NX_); /* TODO: avoid using global memory!!! */
-
-			/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX_ ); */
-			for (ii = 0; ii < _NX_; ++ii) {
-				qpData->xVecTmp.data[ii] -=	qpData->intervals[kk + 1]->zVecTmp.data[ii];
-			}
+	/** (1) make sure Newton Hessian factor matches the active set at the solution */
+	statusFlag = qpDUNES_refreshNewtonFactor(qpData);
+	if (statusFlag != QPDUNES_OK) {
+		return statusFlag;
+	}
 
-			/* write gradient part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				gradientTry->data[kk * _NX_ + ii] = qpData->xVecTmp.data[ii];
-			}
+	/** (2) right hand side: parametric derivative of the Newton gradient (in scaled variables) */
+	for (ii = 0; ii < _NXTTL_; ++ii) {
+		rhs->data[ii] = (dc != 0) ? dc[ii] : 0.;
+	}
+	qpDUNES_scaleLambda(qpData, rhs, QPDUNES_TRUE);		/* dc enters like c */
+	if (dx0 != 0) {
+		interval = qpData->intervals[0];
+		for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+			dzStage->data[ii] = 0.;
 		}
-		alphaSlope = scalarProd(gradientTry, deltaLambdaFS, nV);
-
-		/* take full step if stationary */
-		if (fabs(alphaSlope / slopeNormalization) <= qpData->options.lineSearchStationarityTolerance)
-		{
-			*alpha = alphaMax;
-			return QPDUNES_OK;
+		for (ii = 0; ii < (int_t)interval->nX; ++ii) {
+			if ((interval->y.data[2 * ii] >= qpData->options.equalityTolerance) ||		/* fixed to lb_x */
+				(interval->y.data[2 * ii + 1] >= qpData->options.equalityTolerance))	/* fixed to ub_x */
+			{
+				dzStage->data[ii] = (interval->scaling.data != 0) ? dx0[ii] / interval->scaling.data[ii] : dx0[ii];
+			}
 		}
-
-		/* go into normal interval search if full step leads to descent */
-		if (alphaSlope / slopeNormalization < 0.) {
-			break;
+		multiplyCz(&(interval->xVecTmp), &(interval->C), dzStage, _NX(1), interval->nV);
+		for (ii = 0; ii < _NX(1); ++ii) {
+			rhs->data[ii] += interval->xVecTmp.data[ii];
 		}
+	}
 
-		/* increase step size otherwise (full step still leads to ascent) */
-		alphaMin = alphaMax;
-		alphaMax *= qpData->options.lineSearchIncreaseFactor;
-
-		/* break if maximum step size reached */
-		if (alphaMax > qpData->options.lineSearchMaxStepSize) {
-			*alpha = alphaMin;
-			if ( qpData->options.printLevel >= 3 ) {
-				qpDUNES_printWarning(qpData, __FILE__, __LINE__, "(info) Bisection interval search: Maximum step size reached");
-			}
-			if ( qpData->options.printLevel >= 3 ) {
-				qpDUNES_printf("Alpha = %.15e taken prior to stationarity, alphaSlope = %.15e, normalization = %.15e", *alpha, alphaSlope, slopeNormalization );
+	/** (3) dual sensitivity: backsolve with existing factor */
+	statusFlag = qpDUNES_solveNewtonSystem(qpData, dLambdaVec, rhs, QPDUNES_FALSE);
+	if (statusFlag != QPDUNES_OK) {
+		qpDUNES_printError(qpData, __FILE__, __LINE__, "Backsolve for sensitivities failed.");
+		return statusFlag;
+	}
+	qpDUNES_copyArray(dLambda, dLambdaVec->data, _NXTTL_);
+	for (kk = 0; kk < _NI_; ++kk) {
+		if (qpData->intervals[kk+1]->scaling.data != 0) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				dLambda[_XNOFF(kk) + ii] /= qpData->intervals[kk+1]->scaling.data[ii];
 			}
-			return QPDUNES_ERR_EXCEEDED_MAX_LINESEARCH_STEPSIZE;
 		}
 	}
 
+	if (dz == 0) {
+		return QPDUNES_OK;
+	}
 
-	/** (2) regular bisection interval search */
-	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr) ) {
-		alphaC = 0.5 * (alphaMin + alphaMax);
+	/** (4) primal sensitivity: dz_k = -P_k ( C_k.T*dLambda_k - [dLambda_{k-1}; 0] ) on free variables */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
 
-		/* update z locally according to alpha guess */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			zTry = &(interval->zVecTmp);
-			/* get primal variables for trial step length */
-			addVectorScaledVector( zTry, &(interval->qpSolverClipping.zUnconstrained), alphaC, &(interval->qpSolverClipping.dz), interval->nV );
-			directQpSolver_saturateVector( qpData, zTry, &(interval->y), &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV );
+		/* first order term direction */
+		if (kk < _NI_) {
+			qpDUNES_copyArray(interval->xVecTmp.data, &(dLambdaVec->data[_XNOFF(kk)]), _NX(kk+1));
+			multiplyCTy(&(interval->zVecTmp), &(interval->C), &(interval->xVecTmp), _NX(kk+1), interval->nV);
 		}
-
-		/* manual gradient computation; TODO: use function, but watch out with z, dz, zTry, etc. */
-		for (kk = 0; kk < _NI_; ++kk) {
-			/* ( A_kk*x_kk^opt + B_kk*u_kk^opt + c_kk ) - x_(kk+1)^opt */
-			multiplyCz( qpData, &(qpData->xVecTmp), &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp) );
-			addToVector( &(qpData->xVecTmp), &(qpData->intervals[kk]->c), _NX_ );
-
-			/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX_ ); */
-			for (ii = 0; ii < _NX_; ++ii) {
-				qpData->xVecTmp.data[ii] -= qpData->intervals[kk + 1]->zVecTmp.data[ii];
-			}
-
-			/* write gradient part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				gradientTry->data[kk * _NX_ + ii] = qpData->xVecTmp.data[ii];
-			}
+		else {
+			qpDUNES_setupZeroVector(&(interval->zVecTmp), interval->nV);
 		}
-		alphaSlope = scalarProd(gradientTry, deltaLambdaFS, nV);
-
-		/* check for stationarity in search direction */
-		if ( fabs(alphaSlope / slopeNormalization) <= qpData->options.lineSearchStationarityTolerance ) {
-			if ( qpData->options.printLevel >= 3 ) {
-				qpDUNES_printf("AlphaC = %.5e is stationary, alphaSlope = %.3e, normalization = %.3e", alphaC, alphaSlope, slopeNormalization );
+		if (kk > 0) {
+			for (ii = 0; ii < (int_t)interval->nX; ++ii) {
+				interval->zVecTmp.data[ii] -= dLambdaVec->data[_XNOFF(kk - 1) + ii];
 			}
-			*alpha = alphaC;
-			return QPDUNES_OK;
 		}
-		else {
-			/* half interval */
-			if (alphaSlope > 0) { /* ascent right of gradient */
-				alphaMin = alphaC; /* throw out left interval */
+		statusFlag = multiplyInvHz(qpData, dzStage, clippingQpSolver_getNewtonHessianFactor(interval), &(interval->zVecTmp), interval->nV);
+		if (statusFlag != QPDUNES_OK) {
+			return statusFlag;
+		}
+
+		/* variables at their bounds only move with the embedded initial value */
+		for (ii = 0; ii < (int_t)interval->nV; ++ii) {
+			isActive = ((interval->y.data[2 * ii] >= qpData->options.equalityTolerance) ||
+						(interval->y.data[2 * ii + 1] >= qpData->options.equalityTolerance)) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			if (isActive == QPDUNES_FALSE) {
+				dz[nZoffset + ii] = (interval->scaling.data != 0) ? -dzStage->data[ii] * interval->scaling.data[ii] : -dzStage->data[ii];
 			}
-			else { /* ascent left of gradient */
-				alphaMax = alphaC; /* throw out right interval */
+			else {
+				dz[nZoffset + ii] = ((kk == 0) && (ii < (int_t)interval->nX) && (dx0 != 0)) ? dx0[ii] : 0.;
 			}
 		}
+		nZoffset += interval->nV;
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_getSensitivity */
+
+
+/* ----------------------------------------------
+ * full sensitivity w.r.t. the embedded initial value x0;
+ * row jj of the results holds the derivative w.r.t. x0[jj]
+ *
+ >>>>>>                                           */
+return_t qpDUNES_getSensitivityMatrixX0(	qpData_t* const qpData,
+											real_t* const dLambdaDx0,		/**< nX_0 x nXttl, transposed Jacobian */
+											real_t* const dzDx0				/**< nX_0 x (sum of all nV_k), transposed Jacobian, may be 0 */
+											)
+{
+	int_t ii, jj, kk;
+	int_t nZttl = 0;
+
+	real_t* unitVec = qpData->intervals[_NI_]->xVecTmp.data;	/* the shared workspace is overwritten by Newton Hessian products and setup */
+
+	return_t statusFlag;
+
+	/* refactor once up front, backsolves below reuse the factor */
+	statusFlag = qpDUNES_refreshNewtonFactor(qpData);
+	if (statusFlag != QPDUNES_OK) {
+		return statusFlag;
 	}
 
-	#ifdef __DEBUG__
-	if( qpData->options.printLevel >= 3 ) {
-		qpDUNES_printf( "Bisection interval search: itCntr = %d, last alpha: %.3e", *itCntr, alphaC );
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		nZttl += qpData->intervals[kk]->nV;
 	}
-	#endif
-	qpDUNES_printWarning( qpData, __FILE__, __LINE__,	"Bisection interval search: Maximum number of iterations reached!" );
-	*alpha = alphaC;
 
-	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+	for (ii = 0; ii < _NX(0); ++ii) {
+		unitVec[ii] = 0.;
+	}
+	for (jj = 0; jj < _NX(0); ++jj) {
+		unitVec[jj] = 1.;
+		statusFlag = qpDUNES_getSensitivity( qpData, unitVec, 0,
+											 &(dLambdaDx0[jj * _NXTTL_]),
+											 (dzDx0 != 0) ? &(dzDx0[jj * nZttl]) : 0 );
+		unitVec[jj] = 0.;
+		if (statusFlag != QPDUNES_OK) {
+			return statusFlag;
+		}
+	}
+
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_bisectionIntervalSearch */
+/*<<< END OF qpDUNES_getSensitivityMatrixX0 */
 
 
 /* ----------------------------------------------
  * ...
  *
  >>>>>>                                           */
-return_t qpDUNES_gridSearch( qpData_t* const qpData, 
-							 real_t* const alpha,
-							 uint_t* const itCntr, 
-							 real_t* const objValIncumbent, 
-							 real_t alphaMin,
-							 real_t alphaMax) 
+real_t qpDUNES_computeObjectiveValue(qpData_t* const qpData) {
+	int_t kk;
+	interval_t* interval;
+
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(kk, interval) schedule(static)
+	#endif
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+
+		/* quadratic objective part */
+		interval->optObjVal = 0.5
+				* multiplyzHz(qpData, &(interval->H), &(interval->z),
+						interval->nV);
+		/* linear objective part */
+		interval->optObjVal += scalarProd(&(interval->q), &(interval->z),
+				interval->nV);
+		/* constant objective part */
+		interval->optObjVal += interval->p;
+		/* soft bound penalties */
+		interval->optObjVal += clippingQpSolver_getSoftPenalty(interval);
+	}
+
+	return qpDUNES_sumStageObjectiveValues(qpData);
+}
+/*<<< END OF qpDUNES_computeObjectiveValue */
+
+
+/* ----------------------------------------------
+ * objective value after a step; only stages that moved are re-evaluated
+ *
+ >>>>>>                                           */
+real_t qpDUNES_updateObjectiveValue(	qpData_t* const qpData
+										)
 {
 	int_t kk;
+	interval_t* interval;
 
-	real_t alphaTry;
-	real_t objValTry;
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(kk, interval) schedule(static)
+	#endif
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
 
-	/* todo: maybe do more efficiently for a parallelized version by passing grid directly to QP nodes */
-	for (kk = 0; kk < qpData->options.lineSearchNbrGridPoints; ++kk) {
-		alphaTry = alphaMin
-				+ kk * (alphaMax - alphaMin)
-						/ (qpData->options.lineSearchNbrGridPoints - 1);
-		objValTry = qpDUNES_computeParametricObjectiveValue(qpData, alphaTry);
-		if (objValTry > *objValIncumbent) {
-			*objValIncumbent = objValTry;
-			*alpha = alphaTry;
+		if (interval->lambdaHasChanged == QPDUNES_TRUE) {
+			interval->optObjVal = 0.5 * multiplyzHz(qpData, &(interval->H), &(interval->z), interval->nV);
+			interval->optObjVal += scalarProd(&(interval->q), &(interval->z), interval->nV);
+			interval->optObjVal += interval->p;
+			interval->optObjVal += clippingQpSolver_getSoftPenalty(interval);
 		}
 	}
-	*itCntr += qpData->options.lineSearchNbrGridPoints;
-
 
-	return QPDUNES_OK;
+	return qpDUNES_sumStageObjectiveValues(qpData);
 }
-/*<<< END OF qpDUNES_gridSearch */
+/*<<< END OF qpDUNES_updateObjectiveValue */
 
 
 /* ----------------------------------------------
- * ...
- * 
+ * sum of the stage objective values in a fixed tree over the
+ * stages; bit-identical for any number of threads
+ *
  >>>>>>                                           */
-void qpDUNES_getPrimalSol(const qpData_t* const qpData, real_t* const z) {
+real_t qpDUNES_sumStageObjectiveValues(	qpData_t* const qpData
+										)
+{
 	int_t kk;
 
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
-		qpDUNES_copyArray(&(z[kk * _NZ_]), qpData->intervals[kk]->z.data,
-				qpData->intervals[kk]->nV);
+		qpData->stageReductionTmp[kk] = qpData->intervals[kk]->optObjVal;
 	}
 
-	return;
+	return treeSum( qpData->stageReductionTmp, _NI_ + 1 );
 }
-/*<<< END OF qpDUNES_getPrimalSol */
+/*<<< END OF qpDUNES_sumStageObjectiveValues */
 
-// 
-// /* ----------------------------------------------
-//  * ...
-//  *
-//  >>>>>>                                           */
-// void qpDUNES_getDualSol(const qpData_t* const qpData, real_t* const lambda,
-// 		real_t* const y) {
-// 
-// 	qpDUNES_printWarning( qpData, __FILE__, __LINE__, "getDualSol currently not working" );	/* TODO: fix getDualSol */
-// 
-// 	return;
-// }
-// /*<<< END OF qpDUNES_getDualSol */
 
 /* ----------------------------------------------
- * ...
+ * evaluate the line search trial point lambda + alpha*deltaLambdaFS
+ *
+ *   Every moving stage is visited once: the fused stage kernel yields
+ *   the trial primal solution (stored in interval->z), its bound gaps
+ *   and the stage objective, and, if a gradient is requested, C*z + c
+ *   is formed right after while z is still in cache. A short second
+ *   sweep over the coupling blocks completes the gradient pieces and
+ *   their slope contributions gradient_k.T*deltaLambda_k.
+ *   Stage sums use fixed-order tree reductions; gradientTry and slope
+ *   may be 0 if only the objective is needed, objVal if only the
+ *   gradient is needed.
  *
  >>>>>>                                           */
-return_t qpDUNES_getDualSol(const qpData_t* const qpData, real_t* const lambda, real_t* const y) {
-	int_t kk, ii;
+return_t qpDUNES_evaluateTrialPoint(	qpData_t* const qpData,
+										real_t alpha,
+										const xn_vector_t* const deltaLambdaFS,
+										xn_vector_t* const gradientTry,
+										real_t* const objVal,
+										real_t* const slope
+										)
+{
+	int_t ii, kk;
 
-	int_t nStageMult;
-	int_t nDOffset = 0;
-	
-	qpDUNES_printWarning( qpData, __FILE__, __LINE__, "getDualSol is highly experimental. Expect incorrect multiplers." );
+	real_t* gradPiece;
+	real_t slopePiece;
 
-	/* get lambda */
-	qpDUNES_copyArray( lambda, qpData->lambda.data, _NI_*_NX_ );
+	return_t statusFlag = QPDUNES_OK;
 
-	/* get y */
-	for( kk=0; kk<_NI_+1; ++kk ) {
-		nStageMult = 2* (qpData->intervals[kk]->nV + qpData->intervals[kk]->nD);
-		switch (qpData->intervals[kk]->qpSolverSpecification)	{
+	interval_t* interval;
+
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(kk, interval) schedule(static)
+	#endif
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+
+		/* stages that do not move along the step keep solution and objective */
+		if (interval->lambdaHasChanged == QPDUNES_TRUE) {
+			switch (interval->qpSolverSpecification) {
 			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
-				/* we still have to clean the multipliers */
-				for ( ii=0; ii<nStageMult; ++ii )	{
-					y[nDOffset+ii] = (qpData->intervals[kk]->y.data[ii] > 0)  ?  qpData->intervals[kk]->y.data[ii]  :  0.0;
+				if ( clippingQpSolver_evaluateTrialPoint( qpData, interval, alpha, &(interval->z), &(interval->y), &(interval->optObjVal) ) != QPDUNES_OK ) {
+					statusFlag = QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+					continue;
 				}
 				break;
 
 			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
-				qpDUNES_copyArray( &(y[nDOffset]), qpData->intervals[kk]->y.data, nStageMult );
-				break;
+				#ifndef __SIMPLE_BOUNDS_ONLY__
+				{
+					z_vector_t* qTry = &(interval->zVecTmp);
+					real_t pTry;
+
+					qpOASES_doStep( qpData, interval->qpSolverQpoases.qpoasesObject,	interval, alpha, &(interval->z), &(interval->y), qTry, &pTry );
+					interval->optObjVal = 0.5 * multiplyzHz(qpData, &(interval->H), &(interval->z),	interval->nV);
+					interval->optObjVal += scalarProd(qTry, &(interval->z), interval->nV);
+					interval->optObjVal += pTry;
+					break;
+				}
+				#else
+					qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
+					statusFlag = QPDUNES_ERR_INVALID_ARGUMENT;
+					continue;
+				#endif /* __SIMPLE_BOUNDS_ONLY__ */
 
 			default:
-				qpDUNES_printError( qpData, __FILE__, __LINE__,	"Stage QP %d solver undefined! Bailing out...", kk );
-				return QPDUNES_ERR_INVALID_ARGUMENT;
+				qpDUNES_printError(qpData, __FILE__, __LINE__,	"Stage QP solver undefined! Bailing out...");
+				statusFlag = QPDUNES_ERR_UNKNOWN_ERROR;
+				continue;
+			}
+		}
+
+		/* ( A_kk*x_kk + B_kk*u_kk + c_kk ) of the trial point, if any of the coupled stages moves */
+		if ( (gradientTry != 0) && (kk < _NI_) &&
+			 ( (interval->lambdaHasChanged == QPDUNES_TRUE) || (qpData->intervals[kk+1]->lambdaHasChanged == QPDUNES_TRUE) ) )
+		{
+			multiplyCz( &(interval->xVecTmp), &(interval->C), &(interval->z), _NX(kk+1), interval->nV );
+			addToVector( &(interval->xVecTmp), &(interval->c), _NX(kk+1) );
 		}
-		nDOffset += nStageMult;
 	}
-	return QPDUNES_OK;
-}
-/*<<< END OF qpDUNES_getDualSol */
 
+	/* no return from within the (parallel) stage loop */
+	if (statusFlag != QPDUNES_OK) {
+		return statusFlag;
+	}
 
-/* ----------------------------------------------
- * ...
- *
- >>>>>>                                           */
-real_t qpDUNES_computeObjectiveValue(qpData_t* const qpData) {
-	int_t kk;
-	interval_t* interval;
+	if (objVal != 0) {
+		*objVal = qpDUNES_sumStageObjectiveValues(qpData);
+	}
 
-	real_t objVal = 0.;
+	if (gradientTry == 0) {
+		return QPDUNES_OK;
+	}
 
-	for (kk = 0; kk < _NI_ + 1; ++kk) {
-		interval = qpData->intervals[kk];
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(kk, ii, gradPiece, slopePiece) schedule(static)
+	#endif
+	for (kk = 0; kk < _NI_; ++kk) {
+		gradPiece = &(gradientTry->data[_XNOFF(kk)]);
 
-		/* quadratic objective part */
-		interval->optObjVal = 0.5
-				* multiplyzHz(qpData, &(interval->H), &(interval->z),
-						interval->nV);
-		/* linear objective part */
-		interval->optObjVal += scalarProd(&(interval->q), &(interval->z),
-				interval->nV);
-		/* constant objective part */
-		interval->optObjVal += interval->p;
+		/* gradient block between two resting stages equals the current gradient */
+		if ( (qpData->intervals[kk]->lambdaHasChanged == QPDUNES_FALSE) && (qpData->intervals[kk+1]->lambdaHasChanged == QPDUNES_FALSE) ) {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				gradPiece[ii] = qpData->gradient.data[_XNOFF(kk) + ii];
+			}
+		}
+		else {
+			for (ii = 0; ii < _NX(kk+1); ++ii) {
+				gradPiece[ii] = qpData->intervals[kk]->xVecTmp.data[ii] - qpData->intervals[kk+1]->z.data[ii];
+			}
+		}
 
-		/* sum up */
-		objVal += interval->optObjVal;
+		slopePiece = 0.;
+		for (ii = 0; ii < _NX(kk+1); ++ii) {
+			slopePiece += gradPiece[ii] * deltaLambdaFS->data[_XNOFF(kk) + ii];
+		}
+		qpData->stageReductionTmp[kk] = slopePiece;
 	}
+	*slope = treeSum( qpData->stageReductionTmp, _NI_ );
 
-	return objVal;
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_computeObjectiveValue */
+/*<<< END OF qpDUNES_evaluateTrialPoint */
 
 
 /* ----------------------------------------------
- * ...
+ * dual objective values at lambda + alphas[aa]*deltaLambdaFS for
+ * nAlpha <= lsGridSize step sizes in one sweep over the horizon
+ *
+ *   Stage objectives are collected grid point major, so each grid
+ *   point is summed with the same fixed-order tree reduction as a
+ *   single trial point; results equal nAlpha calls of
+ *   qpDUNES_computeParametricObjectiveValue. Unlike the latter, no
+ *   trial primal solution is left in the stages.
  *
  >>>>>>                                           */
-real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
-												const real_t alpha
+return_t qpDUNES_computeGridObjectiveValues(	qpData_t* const qpData,
+												int_t nAlpha,
+												const real_t* const alphas,
+												real_t* const objVals
 												)
 {
-	int_t kk;
-	
-	z_vector_t* qTry;
-	real_t pTry;
+	int_t aa, kk;
 
-	real_t objVal = 0.;
+	real_t* stageObjVals;
+
+	return_t statusFlag = QPDUNES_OK;
 
 	interval_t* interval;
 
-	/* TODO: move to own function in direct QP solver, a la getObjVal( qpData, interval, alpha ) */
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(kk, aa, interval, stageObjVals) schedule(static)
+	#endif
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
 		interval = qpData->intervals[kk];
-		qTry = &(interval->zVecTmp);
-
-		/* get primal variables for trial step length */
-		switch (interval->qpSolverSpecification) {
-		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
-			directQpSolver_doStep( qpData, interval, &(interval->qpSolverClipping.dz), alpha, &(interval->z ), &(interval->z), &(interval->y), qTry, &pTry );
-			break;
+		stageObjVals = &(qpData->lsGridTmp[4 * kk * qpData->lsGridSize]);
 
-		case QPDUNES_STAGE_QP_SOLVER_QPOASES:
-			#ifndef __SIMPLE_BOUNDS_ONLY__
-				qpOASES_doStep( qpData, interval->qpSolverQpoases.qpoasesObject,	interval, alpha, &(interval->z), &(interval->y), qTry, &pTry );
+		/* objective of stages that do not move along the step is constant */
+		if (interval->lambdaHasChanged == QPDUNES_FALSE) {
+			for (aa = 0; aa < nAlpha; ++aa) {
+				stageObjVals[aa] = interval->optObjVal;
+			}
+		}
+		else {
+			switch (interval->qpSolverSpecification) {
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				if ( clippingQpSolver_evaluateTrialPoints( qpData, interval, nAlpha, alphas, stageObjVals, &(stageObjVals[nAlpha]) ) != QPDUNES_OK ) {
+					statusFlag = QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+					continue;
+				}
 				break;
-			#else
-				qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
-				return QPDUNES_ERR_INVALID_ARGUMENT;
-			#endif /* __SIMPLE_BOUNDS_ONLY__ */
 
-		default:
-			qpDUNES_printError(qpData, __FILE__, __LINE__,	"Stage QP solver undefined! Bailing out...");
-			return QPDUNES_ERR_UNKNOWN_ERROR;
+			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+				#ifndef __SIMPLE_BOUNDS_ONLY__
+				{
+					z_vector_t* qTry = &(interval->zVecTmp);
+					real_t pTry;
+
+					for (aa = 0; aa < nAlpha; ++aa) {
+						qpOASES_doStep( qpData, interval->qpSolverQpoases.qpoasesObject,	interval, alphas[aa], &(interval->z), &(interval->y), qTry, &pTry );
+						stageObjVals[aa] = 0.5 * multiplyzHz(qpData, &(interval->H), &(interval->z),	interval->nV);
+						stageObjVals[aa] += scalarProd(qTry, &(interval->z), interval->nV);
+						stageObjVals[aa] += pTry;
+					}
+					break;
+				}
+				#else
+					qpDUNES_printError( qpData, __FILE__, __LINE__, "The flag '__SIMPLE_BOUNDS_ONLY__' was set at compile time.\n          Hence, no QPs with dense Hessian or affine constraints are supported." );
+					statusFlag = QPDUNES_ERR_INVALID_ARGUMENT;
+					continue;
+				#endif /* __SIMPLE_BOUNDS_ONLY__ */
+
+			default:
+				qpDUNES_printError(qpData, __FILE__, __LINE__,	"Stage QP solver undefined! Bailing out...");
+				statusFlag = QPDUNES_ERR_UNKNOWN_ERROR;
+				continue;
+			}
 		}
 
-		/* quadratic objective part */
-		interval->optObjVal = 0.5 * multiplyzHz(qpData, &(interval->H), &(interval->z),	interval->nV);
-		/* linear objective part */
-		interval->optObjVal += scalarProd(qTry, &(interval->z), interval->nV);
-		/* constant objective part */
-		interval->optObjVal += pTry;
+		for (aa = 0; aa < nAlpha; ++aa) {
+			qpData->lsGridStageObjVal[aa * (_NI_ + 1) + kk] = stageObjVals[aa];
+		}
+	}
+
+	/* no return from within the (parallel) stage loop */
+	if (statusFlag != QPDUNES_OK) {
+		return statusFlag;
+	}
+
+	for (aa = 0; aa < nAlpha; ++aa) {
+		objVals[aa] = treeSum( &(qpData->lsGridStageObjVal[aa * (_NI_ + 1)]), _NI_ + 1 );
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_computeGridObjectiveValues */
+
+
+/* ----------------------------------------------
+ * dual objective value at lambda + alpha*deltaLambdaFS; leaves the
+ * trial primal solution in the moving stages
+ *
+ >>>>>>                                           */
+real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
+												const real_t alpha
+												)
+{
+	real_t objVal;
 
-		objVal += interval->optObjVal;
+	return_t statusFlag = qpDUNES_evaluateTrialPoint( qpData, alpha, 0, 0, &objVal, 0 );
+
+	if (statusFlag != QPDUNES_OK) {
+		return statusFlag;
 	}
 
 	return objVal;
@@ -2159,15 +4267,19 @@ real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
  * Get number of active local constraints
  *
  *   Note: this overwrites AS (TODO: is this qpData->ieqStatus?)
+ *   and the packed active set of each interval
  *
  >>>>>>                                           */
 uint_t qpDUNES_getActSet( const qpData_t* const qpData,
 				       int_t * const * const actSetStatus) {
 	uint_t ii = 0;
-	uint_t kk = 0;
+	int_t kk = 0;
 
 	uint_t nActConstr = 0;
 
+	actSetWord_t* bits;
+	actSetWord_t status;
+
 	/* temporary hack to make sure newton hessian is refactorized even with qpOASES: */
 	static int counter = 0;
 
@@ -2177,23 +4289,32 @@ uint_t qpDUNES_getActSet( const qpData_t* const qpData,
 	}
 	#endif
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		bits = qpData->intervals[kk]->actSet.bits;
+		for (ii = 0; ii < (uint_t)qpData->intervals[kk]->actSet.nWords; ++ii ) {
+			bits[ii] = 0;
+		}
 		if (qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
 			for (ii = 0; ii < _ND(kk) + _NV(kk); ++ii ) {
 				/* TODO: make this quick hack clean for general multiplier usage...! */
 				/* go through multipliers in pairs by two */
 				if ( qpData->intervals[kk]->y.data[2*ii] > qpData->options.equalityTolerance ) { /* lower bound active */
 					actSetStatus[kk][ii] = -1;
+					status = 1;
 					++nActConstr;
 				}
 				else {
 					if ( qpData->intervals[kk]->y.data[2*ii+1] > qpData->options.equalityTolerance ) { /* upper bound active */
 						actSetStatus[kk][ii] = 1;
+						status = 2;
 						++nActConstr;
 					}
 					else {		/* no constraint bound active */
 						actSetStatus[kk][ii] = 0;
+						/* penalized region of a soft bound changes the curvature seen by the Newton Hessian */
+						status = ( (ii < _NV(kk)) && (clippingQpSolver_isSoftActive( qpData->intervals[kk], ii ) == QPDUNES_TRUE) ) ? 3 : 0;
 					}
 				}
+				bits[ii / QPDUNES_ACTSET_CONSTR_PER_WORD] |= status << ( 2 * (ii % QPDUNES_ACTSET_CONSTR_PER_WORD) );
 				#ifdef __DEBUG__
 				if (qpData->options.printLevel >= 4) {
 					if( actSetStatus[kk][ii] != 0 ) {
@@ -2227,33 +4348,55 @@ uint_t qpDUNES_getActSet( const qpData_t* const qpData,
 
 
 /* ----------------------------------------------
- * Get number of differences between two active sets
- * TODO: do this based on alpha, no need for actually comparing active sets !!
+ * Get number of differences between the current active set and the one
+ * the Newton Hessian blocks were last set up for
+ *
+ *   Bitsets are compared word-wise; a constraint changed if any of its
+ *   two status bits differs. Stages not solved by clipping are always
+ *   treated as changed, since their active set is not tracked.
  *
  >>>>>>                                           */
 uint_t qpDUNES_compareActSets( const qpData_t* const qpData,
-							const int_t * const * const newActSetStatus,
-							const int_t * const * const oldActSetStatus,
 							int_t * const lastActSetChangeIdx) {
-	uint_t ii, kk;
+	int_t ii, kk;
 	uint_t nChgdConstr = 0;
+	uint_t nChgdStage;
+
+	actSet_t* actSet;
+	actSetWord_t diff;
+	const actSetWord_t lowBitMask = ~((actSetWord_t)0) / 3;	/* 0101...01 */
 
 	*lastActSetChangeIdx = -1;
 
 	for (kk = 0; kk < _NI_+1; ++kk) {
-		qpData->intervals[kk]->actSetHasChanged = QPDUNES_FALSE;
-		for (ii = 0; ii < _ND(kk)+_NV(kk); ++ii ) {
+		actSet = &(qpData->intervals[kk]->actSet);
+		nChgdStage = 0;
+		if (qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING) {
 			/* TODO: maybe include check whether lb = ub? Is a jump from lb to ub (or even to inactive, though unlikely) in this case really an active set change? */
-			if( newActSetStatus[kk][ii] != oldActSetStatus[kk][ii] ) {
-				++nChgdConstr;
-				qpData->intervals[kk]->actSetHasChanged = QPDUNES_TRUE;
-				*lastActSetChangeIdx = kk;
-				#ifdef __DEBUG__
-				if (qpData->options.printLevel >= 4) {
-					qpDUNES_printf( "AS change in [%d,%d]: %+d => %+d", kk, ii,oldActSetStatus[kk][ii], newActSetStatus[kk][ii] );
-				}
-				#endif
+			for (ii = 0; ii < actSet->nWords; ++ii) {
+				diff = actSet->bits[ii] ^ actSet->prevBits[ii];
+				nChgdStage += qpDUNES_popcount( (diff | (diff >> 1)) & lowBitMask );
+			}
+		}
+		else {
+			nChgdStage = _ND(kk) + _NV(kk);
+		}
+		if ( actSet->prevBitsAreValid == QPDUNES_FALSE ) {	/* data changed, even if the active set did not */
+			nChgdStage = qpDUNES_max( nChgdStage, 1 );
+		}
+
+		if (nChgdStage > 0) {
+			nChgdConstr += nChgdStage;
+			qpData->intervals[kk]->actSetHasChanged = QPDUNES_TRUE;
+			*lastActSetChangeIdx = kk;
+			#ifdef __DEBUG__
+			if (qpData->options.printLevel >= 4) {
+				qpDUNES_printf( "AS change in stage %d: %d constraints", kk, nChgdStage );
 			}
+			#endif
+		}
+		else {
+			qpData->intervals[kk]->actSetHasChanged = QPDUNES_FALSE;
 		}
 	}
 
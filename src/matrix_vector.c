@@ -149,24 +149,32 @@ return_t multiplyBu(	qpData_t* const qpData,
  * Matrix-vector product res = C*z
  * 
  >>>>>                                            */
-return_t multiplyCz(	qpData_t* const qpData,
-						x_vector_t* const res,
+return_t multiplyCz(	x_vector_t* const res,
 						const xz_matrix_t* const C,
 /*						const xx_matrix_t* const A,*/
 /*						const xu_matrix_t* const B,*/
-						const z_vector_t* const z 	)
+						const z_vector_t* const z,
+						const int_t nXK1,
+						const int_t nV 	)
 {
-	/** only dense multiplication */
 	int_t ii, jj;
 	real_t* _C = C->data;
 	real_t* _z = z->data;
 	real_t* _res = res->data;
 	
-	for( ii = 0; ii < _NX_; ++ii )
+	if ( C->sparsityType == QPDUNES_SPARSE ) {
+		return multiplyMatrixVectorSparse( _res, &(C->sparse), _z, nXK1, nV );
+	}
+	if ( C->structure.type != QPDUNES_STRUCTURE_GENERAL ) {
+		return multiplyCzStructured( res, C, z, nXK1, nV );
+	}
+	
+	/** dense multiplication */
+	for( ii = 0; ii < nXK1; ++ii )
 	{
 		real_t foo = 0.0;
-		real_t* _Crow = _C + ii * _NZ_;
-		for( jj = 0; jj < _NZ_; ++jj )
+		real_t* _Crow = _C + ii * nV;
+		for( jj = 0; jj < nV; ++jj )
 			foo += _Crow[ jj ] * _z[ jj ];
 		
 		_res[ ii ] = foo;
@@ -181,28 +189,36 @@ return_t multiplyCz(	qpData_t* const qpData,
  * Matrix-vector product z = C.T*y
  * 
  >>>>>                                            */
-return_t multiplyCTy(	qpData_t* const qpData,
-						z_vector_t* const res,
+return_t multiplyCTy(	z_vector_t* const res,
 						const xz_matrix_t* const C,
 /*						const xx_matrix_t* const A,*/
 /*						const xu_matrix_t* const B,*/
-						const x_vector_t* const y 	)
+						const x_vector_t* const y,
+						const int_t nXK1,
+						const int_t nV 	)
 {
-	/** only dense multiplication */
 	int_t ii, jj;
 	real_t* _C = C->data;
 	real_t* _y = y->data;
 	real_t* _res = res->data;
 	
+	if ( C->sparsityType == QPDUNES_SPARSE ) {
+		return multiplyMatrixTVectorSparse( _res, &(C->sparse), _y, nV );
+	}
+	if ( C->structure.type != QPDUNES_STRUCTURE_GENERAL ) {
+		return multiplyCTyStructured( res, C, y, nXK1, nV );
+	}
+	
+	/** dense multiplication */
 	/* change multiplication order for more efficient memory access */
-	for( jj = 0; jj < _NZ_; ++jj )
+	for( jj = 0; jj < nV; ++jj )
 		_res[ jj ] = 0.0;
 	
-	for( ii = 0; ii < _NX_; ++ii )
+	for( ii = 0; ii < nXK1; ++ii )
 	{
 		real_t foo = _y[ ii ];
-		real_t* _Crow = _C + ii * _NZ_;
-		for( jj = 0; jj < _NZ_; ++jj )
+		real_t* _Crow = _C + ii * nV;
+		for( jj = 0; jj < nV; ++jj )
 			_res[ jj ] += _Crow[ jj ] * foo;
 	}
 	
@@ -211,6 +227,110 @@ return_t multiplyCTy(	qpData_t* const qpData,
 /*<<< END OF multiplyCTy */
 
 
+/* ----------------------------------------------
+ * Matrix-vector product res = C*z for dense C
+ * whose A part has banded, block-diagonal or
+ * integrator chain structure
+ * 
+ >>>>>                                            */
+return_t multiplyCzStructured(	x_vector_t* const res,
+								const xz_matrix_t* const C,
+								const z_vector_t* const z,
+								const int_t nXK1,
+								const int_t nV 	)
+{
+	int_t ii, jj;
+	int_t jBegin, jEnd;
+	real_t* _C = C->data;
+	real_t* _z = z->data;
+	real_t* _res = res->data;
+	
+	for( ii = 0; ii < nXK1; ++ii )
+	{
+		real_t foo;
+		real_t* _Crow = _C + ii * nV;
+		
+		/* A part: only columns that may hold nonzeros */
+		if ( C->structure.type == QPDUNES_STRUCTURE_INTEGRATOR_CHAIN ) {
+			/* unit diagonal needs no multiplication */
+			foo = _z[ ii ];
+			if ( ii+1 < nXK1 )
+				foo += _Crow[ ii+1 ] * _z[ ii+1 ];
+		}
+		else {
+			foo = 0.0;
+			qpDUNES_getStructureRowRange( &(C->structure), ii, nXK1, &jBegin, &jEnd );
+			for( jj = jBegin; jj < jEnd; ++jj )
+				foo += _Crow[ jj ] * _z[ jj ];
+		}
+		
+		/* B part */
+		for( jj = nXK1; jj < nV; ++jj )
+			foo += _Crow[ jj ] * _z[ jj ];
+		
+		_res[ ii ] = foo;
+	}
+	
+	return QPDUNES_OK;
+}
+/*<<< END OF multiplyCzStructured */
+
+
+/* ----------------------------------------------
+ * Matrix-vector product z = C.T*y for dense C
+ * whose A part has banded, block-diagonal or
+ * integrator chain structure
+ * 
+ >>>>>                                            */
+return_t multiplyCTyStructured(	z_vector_t* const res,
+								const xz_matrix_t* const C,
+								const x_vector_t* const y,
+								const int_t nXK1,
+								const int_t nV 	)
+{
+	int_t ii, jj;
+	int_t iBegin, iEnd;
+	real_t* _C = C->data;
+	real_t* _y = y->data;
+	real_t* _res = res->data;
+	
+	/* A part: only rows that may hold nonzeros */
+	for( jj = 0; jj < nXK1; ++jj )
+	{
+		real_t foo;
+		
+		if ( C->structure.type == QPDUNES_STRUCTURE_INTEGRATOR_CHAIN ) {
+			/* unit diagonal needs no multiplication */
+			foo = ( jj > 0 ) ? _C[ (jj-1) * nV + jj ] * _y[ jj-1 ] : 0.0;
+			foo += _y[ jj ];
+		}
+		else {
+			foo = 0.0;
+			qpDUNES_getStructureColumnRange( &(C->structure), jj, nXK1, &iBegin, &iEnd );
+			for( ii = iBegin; ii < iEnd; ++ii )
+				foo += _C[ ii * nV + jj ] * _y[ ii ];
+		}
+		
+		_res[ jj ] = foo;
+	}
+	
+	/* B part, row-wise for more efficient memory access */
+	for( jj = nXK1; jj < nV; ++jj )
+		_res[ jj ] = 0.0;
+	
+	for( ii = 0; ii < nXK1; ++ii )
+	{
+		real_t foo = _y[ ii ];
+		real_t* _Crow = _C + ii * nV;
+		for( jj = nXK1; jj < nV; ++jj )
+			_res[ jj ] += _Crow[ jj ] * foo;
+	}
+	
+	return QPDUNES_OK;
+}
+/*<<< END OF multiplyCTyStructured */
+
+
 /* ----------------------------------------------
  * Matrix times inverse matrix product res = A * Q^-1
  *
@@ -219,10 +339,14 @@ return_t multiplyCTy(	qpData_t* const qpData,
 return_t multiplyAInvQ(	qpData_t* const qpData,
 						xx_matrix_t* const res,
 						const xx_matrix_t* const C,
-						const xx_matrix_t* const cholH
+						const xx_matrix_t* const cholH,
+						const int_t nXK1,
+						const int_t nX,
+						const int_t nV
 						)
 {
-	int_t ii,jj;
+	int_t ii,jj,kk;
+	int_t jBegin, jEnd;
 
 	res->sparsityType = QPDUNES_DENSE;
 
@@ -237,14 +361,39 @@ return_t multiplyAInvQ(	qpData_t* const qpData,
 
 		/* cholH diagonal */
 		case QPDUNES_DIAGONAL	:
+			if ( ( C->sparsityType == QPDUNES_DENSE ) && ( C->structure.type != QPDUNES_STRUCTURE_GENERAL ) ) {
+				/* scale only the structurally nonzero part of A */
+				for( ii=0; ii<nXK1*nX; ++ii ) {
+					res->data[ii] = 0.;
+				}
+				for( ii=0; ii<nXK1; ++ii ) {
+					qpDUNES_getStructureRowRange( &(C->structure), ii, nX, &jBegin, &jEnd );
+					for( jj=jBegin; jj<jEnd; ++jj ) {
+						res->data[ii*nX+jj] = accC(ii,jj) / cholH->data[jj];
+					}
+				}
+				break;
+			}
+			if ( C->sparsityType == QPDUNES_SPARSE ) {
+				/* scale only the stored nonzeros of the A part */
+				for( ii=0; ii<nXK1*nX; ++ii ) {
+					res->data[ii] = 0.;
+				}
+				for( jj=0; jj<nX; ++jj ) {
+					for( kk=C->sparse.colPtr[jj]; kk<C->sparse.colPtr[jj+1]; ++kk ) {
+						res->data[C->sparse.rowIdx[kk]*nX+jj] = C->sparse.val[kk] / cholH->data[jj];
+					}
+				}
+				break;
+			}
 			/* scale A part of C column-wise */
-			for( ii=0; ii<_NX_; ++ii )	{
-				for( jj=0; jj<_NX_; ++jj ) {
+			for( ii=0; ii<nXK1; ++ii )	{
+				for( jj=0; jj<nX; ++jj ) {
 					#ifdef __DEBUG__
 					if ( fabs( cholH->data[ii] ) >= qpData->options.QPDUNES_ZERO * fabs( accC(ii,jj) ) ) {
 					#endif
 						/* cholH is the actual matrix in diagonal case */
-						res->data[ii*_NX_+jj] = accC(ii,jj) / cholH->data[jj];
+						res->data[ii*nX+jj] = accC(ii,jj) / cholH->data[jj];
 					#ifdef __DEBUG__
 					}
 					else {
@@ -259,9 +408,9 @@ return_t multiplyAInvQ(	qpData_t* const qpData,
 		/* cholH identity */
 		case QPDUNES_IDENTITY	:
 			/* copy A block */
-			for( ii=0; ii < _NX_; ++ii ) {
-				for( jj=0; jj < _NX_; ++jj ) {
-					res->data[ii*_NX_+jj] = accC(ii,jj);
+			for( ii=0; ii < nXK1; ++ii ) {
+				for( jj=0; jj < nX; ++jj ) {
+					res->data[ii*nX+jj] = accC(ii,jj);
 				}
 			}
 			break;
@@ -338,18 +487,88 @@ return_t addCInvHCT(	qpData_t* const qpData,
 						const d2_vector_t* const y,
 						xx_matrix_t* const xxMatTmp,
 						ux_matrix_t* const uxMatTmp,
-						zx_matrix_t* const zxMatTmp
+						zx_matrix_t* const zxMatTmp,
+						const int_t nXK1,
+						const int_t nV
 						)
 {
+	if ( ( C->sparsityType == QPDUNES_DENSE ) && ( C->structure.type != QPDUNES_STRUCTURE_GENERAL ) &&
+		 ( ( cholH->sparsityType == QPDUNES_DIAGONAL ) || ( cholH->sparsityType == QPDUNES_IDENTITY ) ) )
+	{
+		return addCInvHCTStructured( qpData, res, cholH, C, y, nXK1, nV );
+	}
+
 	/* TODO: summarize to one function */
 	return addMultiplyMatrixInvMatrixMatrixT(qpData, res, cholH, C, y->data,
-			zxMatTmp, &(qpData->xVecTmp), _NX_, _NZ_);
+			zxMatTmp, &(qpData->xVecTmp), nXK1, nV);
 
 	return QPDUNES_OK;
 }
 /*<<< END OF addCInvHC */
 
 
+/* ----------------------------------------------
+ * res += C * H^-1 * C.T over free variables, for
+ * diagonal H and structured A part of dense C;
+ * the backsolve H^-1 * C.T is done only on the
+ * structurally nonzero part of each column
+ * 
+ * >>>>>>                                           */
+return_t addCInvHCTStructured(	qpData_t* const qpData,
+								xx_matrix_t* const res,
+								const vv_matrix_t* const cholH,
+								const xz_matrix_t* const C,
+								const d2_vector_t* const y,
+								const int_t nXK1,
+								const int_t nV
+								)
+{
+	int_t ii, jj, ll;
+	int_t iBegin, iEnd;
+	real_t invHC;
+
+	qpDUNES_makeMatrixDense( res, nXK1, nXK1 );
+
+	/* dyadic product of every free column of C, restricted to its nonzero rows */
+	for( ll = 0; ll < nV; ++ll ) {
+		/* only add columns of variables with inactive bounds */
+		if ( ( y->data[2 * ll] > qpData->options.equalityTolerance ) ||		/* lower bound active */
+			 ( y->data[2 * ll + 1] > qpData->options.equalityTolerance ) )	/* upper bound active */
+		{
+			continue;
+		}
+
+		if ( ll < nXK1 ) {
+			qpDUNES_getStructureColumnRange( &(C->structure), ll, nXK1, &iBegin, &iEnd );
+		}
+		else {	/* B part is dense */
+			iBegin = 0;
+			iEnd = nXK1;
+		}
+
+		for( jj = iBegin; jj < iEnd; ++jj ) {
+			if ( cholH->sparsityType == QPDUNES_DIAGONAL ) {
+				/* cholH is the actual matrix in diagonal case */
+				if ( fabs( cholH->data[ll] ) < qpData->options.QPDUNES_ZERO * fabs( accC(jj,ll) ) ) {
+					qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in addCInvHCTStructured. Rank-deficient Hessian?" );
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+				invHC = accC(jj,ll) / cholH->data[ll];
+			}
+			else {
+				invHC = accC(jj,ll);
+			}
+			for( ii = iBegin; ii < iEnd; ++ii ) {
+				res->data[ii * nXK1 + jj] += accC(ii,ll) * invHC;
+			}
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF addCInvHCTStructured */
+
+
 /* ----------------------------------------------
  * ...
  *
@@ -360,7 +579,7 @@ return_t addScaledLambdaStep(	qpData_t* const qpData,
 								real_t scalingFactor,
 								const xn_vector_t* const deltaLambda 	)
 {
-	return addScaledVector( (vector_t*)res, scalingFactor, (vector_t*)deltaLambda, _NI_ * _NX_ );
+	return addScaledVector( (vector_t*)res, scalingFactor, (vector_t*)deltaLambda, _NXTTL_ );
 }
 /*<<< END OF addScaledLambdaStep */
 
@@ -757,7 +976,7 @@ real_t newtonGradientNorm(	const qpData_t* const qpData,
 							const xn_vector_t* const vec
 )	/* TODO: check whether this function is really needed! */
 {
-	return vectorNorm( (vector_t*)vec, _NI_ * _NX_ );
+	return vectorNorm( (vector_t*)vec, _NXTTL_ );
 }
 /*<<< END OF newtonGradientNorm */
 
@@ -1303,11 +1522,12 @@ return_t backsolveMatrixTDiagonalDense( qpData_t* const qpData,
 return_t backsolveRT_ZTET(qpData_t* const qpData, zx_matrix_t* const res,
 		const zz_matrix_t* const RT, const zz_matrix_t* const ZT,
 		x_vector_t* const sums, int_t dim0, /* number of physical rows and columns in  RT (storage) = number of columns in ZT */
-		int_t dim1 /* number of defined rows in ZT = number of defined rows and columns in RT */
+		int_t dim1, /* number of defined rows in ZT = number of defined rows and columns in RT */
+		int_t dim2 /* number of states of the stage */
 		) {
 	int_t ii, jj, kk;
 
-	int_t dim1SkipIdx = _NX_; /* stopping after the first _NX_ columns of ZT is equivalent to multiplication ZT*ET */
+	int_t dim1SkipIdx = dim2; /* stopping after the first dim2 columns of ZT is equivalent to multiplication ZT*ET */
 
 	/* solve RT*res = ZT */
 	for (ii = 0; ii < dim1; ++ii) {
@@ -1342,12 +1562,11 @@ return_t backsolveRT_ZTET(qpData_t* const qpData, zx_matrix_t* const res,
 return_t backsolveRT_ZTCT(qpData_t* const qpData, zx_matrix_t* const res,
 		const zz_matrix_t* const RT, const zz_matrix_t* const ZTCT,
 		x_vector_t* const sums, int_t dim0, /* number of physical rows and columns in RT (storage) */
-		int_t dim1 /* number of (well-defined) rows in ZTCT (same as ZT) */
+		int_t dim1, /* number of (well-defined) rows in ZTCT (same as ZT) */
+		int_t dim2 /* number of columns in ZTCT = number of rows of C */
 		) {
 	int_t ii, jj, kk;
 
-	int_t dim2 = _NX_; /* number of columns in ZTCT */
-
 	/* solve RT*res = ZT */
 	for (ii = 0; ii < dim1; ++ii) {
 		for (kk = 0; kk < dim2; ++kk) {
@@ -1399,7 +1618,7 @@ return_t multiplyMatrixVector( vector_t* const res,
 		case QPDUNES_DENSE		:
 			return multiplyMatrixVectorDense( res->data, M->data, x->data, dim0, dim1 );
 		case QPDUNES_SPARSE		:
-			return multiplyMatrixVectorSparse( res->data, M->data, x->data, dim0, dim1 );
+			return multiplyMatrixVectorSparse( res->data, &(M->sparse), x->data, dim0, dim1 );
 		case QPDUNES_DIAGONAL	:
 			return multiplyMatrixVectorDiagonal( res->data, M->data, x->data, dim0 );
 		case QPDUNES_IDENTITY	:
@@ -1465,7 +1684,7 @@ return_t multiplyBlockDiagMatrixVector( vector_t* const res,
 			multiplyMatrixVectorDense( res->data, M1->data, x->data, dimM1, dimM1 );
 			break;
 		case QPDUNES_SPARSE		:
-			multiplyMatrixVectorSparse( res->data, M1->data, x->data, dimM1, dimM1 );
+			multiplyMatrixVectorSparse( res->data, &(M1->sparse), x->data, dimM1, dimM1 );
 			break;
 		case QPDUNES_DIAGONAL	:
 			multiplyMatrixVectorDiagonal( res->data, M1->data, x->data, dimM1 );
@@ -1494,7 +1713,7 @@ return_t multiplyBlockDiagMatrixVector( vector_t* const res,
 			multiplyMatrixVectorDense( &(res->data[dimM1]), M2->data, &(x->data[dimM1]), dimM2, dimM2 );
 			break;
 		case QPDUNES_SPARSE		:
-			multiplyMatrixVectorSparse( &(res->data[dimM1]), M2->data, &(x->data[dimM1]), dimM2, dimM2 );
+			multiplyMatrixVectorSparse( &(res->data[dimM1]), &(M2->sparse), &(x->data[dimM1]), dimM2, dimM2 );
 			break;
 		case QPDUNES_DIAGONAL	:
 			multiplyMatrixVectorDiagonal( &(res->data[dimM1]), M2->data, &(x->data[dimM1]), dimM2 );
@@ -1607,7 +1826,7 @@ return_t multiplyMatrixTVector(	vector_t* const res,
 		case QPDUNES_DENSE		:
 			return multiplyMatrixTVectorDense( res->data, M->data, x->data, dim0, dim1 );
 		case QPDUNES_SPARSE		:
-			return multiplyMatrixTVectorSparse( res->data, M->data, x->data, dim0, dim1 );
+			return multiplyMatrixTVectorSparse( res->data, &(M->sparse), x->data, dim1 );
 		case QPDUNES_DIAGONAL	:
 			return multiplyMatrixVectorDiagonal( res->data, M->data, x->data, dim0 );
 		case QPDUNES_IDENTITY	:
@@ -1669,6 +1888,60 @@ return_t multiplyInvMatrixVector(	qpData_t* const qpData,
 /*<<< END OF multiplyInvMatrixVector */
 
 
+/* ----------------------------------------------
+ * Quadratic form res = x'*invM*x, using a Cholesky
+ * factorization M = L*L^T, i.e., res = ||L^-1*x||^2
+ *
+#>>>>>>                                           */
+return_t multiplyVectorInvMatrixVector(	qpData_t* const qpData,
+										real_t* const res,
+										const matrix_t* const cholH,
+										const vector_t* const x,
+										vector_t* const vecTmp,
+										int_t dim0						/**< dimension of symmetric matrix */
+										)
+{
+	int_t ii;
+	return_t statusFlag;
+
+	*res = 0.;
+
+	/** choose appropriate multiplication routine */
+	switch( cholH->sparsityType )
+	{
+		case QPDUNES_DENSE		:
+		case QPDUNES_SPARSE	:
+			statusFlag = backsolveDenseL( qpData, vecTmp->data, cholH->data, x->data, QPDUNES_FALSE, dim0 );
+			for( ii=0; ii<dim0; ++ii ) {
+				*res += vecTmp->data[ii] * vecTmp->data[ii];
+			}
+			return statusFlag;
+
+		case QPDUNES_DIAGONAL	:
+			/* cholH in this case contains full diagonal matrix (not a factor) */
+			for( ii=0; ii<dim0; ++ii ) {
+				if ( fabs( cholH->data[ii] ) < qpData->options.QPDUNES_ZERO * fabs( x->data[ii] ) ) {
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+				if ( x->data[ii] != 0. ) {
+					*res += x->data[ii] * x->data[ii] / cholH->data[ii];
+				}
+			}
+			return QPDUNES_OK;
+
+		case QPDUNES_IDENTITY	:
+			for( ii=0; ii<dim0; ++ii ) {
+				*res += x->data[ii] * x->data[ii];
+			}
+			return QPDUNES_OK;
+
+		default				:
+			return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+	}
+}
+/*<<< END OF multiplyVectorInvMatrixVector */
+
+
 /* ----------------------------------------------
  * Matrix-vector product res = invM*x,
  * where M is a block diagonal matrix M1, M2
@@ -1913,17 +2186,28 @@ real_t multiplyVectorMatrixVectorDense(	const real_t* const M,
 
 /* ---------------------------------------------- 
  * Sparse generic matrix-vector product b = A*x
- * WARNING: sparse matrix-vector multiplication 
- * not yet implemented
+ * for A in compressed sparse column storage
  * 
  >>>>>>                                           */
-return_t multiplyMatrixVectorSparse(	real_t* res,
-										const real_t* const M,
+return_t multiplyMatrixVectorSparse(	real_t* const res,
+										const sparseStorage_t* const M,
 										const real_t* const x,
 										int_t dim0,
 										int_t dim1		)
 {
-	return multiplyMatrixVectorDense( res, M, x, dim0, dim1 );
+	int_t ii, jj, kk;
+	
+	for( ii = 0; ii < dim0; ++ii ) {
+		res[ii] = 0.;
+	}
+	/* column-wise axpy, accumulates each row in the same order as the dense product */
+	for( jj = 0; jj < dim1; ++jj ) {
+		for( kk = M->colPtr[jj]; kk < M->colPtr[jj+1]; ++kk ) {
+			res[ M->rowIdx[kk] ] += M->val[kk] * x[jj];
+		}
+	}
+	
+	return QPDUNES_OK;
 }
 /*<<< END OF multiplyMatrixVectorSparse */
 
@@ -2000,20 +2284,29 @@ return_t multiplyMatrixTVectorDense(	real_t* const res,
 
 /* ---------------------------------------------- 
  * Sparse generic transposed matrix-vector product 
- * b = A*x
- * WARNING: sparse matrix-vector multiplication 
- * not yet implemented
+ * b = A.T*x for A in compressed sparse column storage
  * 
  >>>>>>                                           */
-return_t multiplyMatrixTVectorSparse(	real_t* res,
-										const real_t* const M,
+return_t multiplyMatrixTVectorSparse(	real_t* const res,
+										const sparseStorage_t* const M,	/**< untransposed matrix */
 										const real_t* const x,
-										int_t dim0,
 										int_t dim1		)
 {
-	return multiplyMatrixTVectorDense( res, M, x, dim0, dim1 );
+	int_t jj, kk;
+	real_t foo;
+	
+	/* each column of A gives one entry of the result */
+	for( jj = 0; jj < dim1; ++jj ) {
+		foo = 0.;
+		for( kk = M->colPtr[jj]; kk < M->colPtr[jj+1]; ++kk ) {
+			foo += M->val[kk] * x[ M->rowIdx[kk] ];
+		}
+		res[jj] = foo;
+	}
+	
+	return QPDUNES_OK;
 }
-/*<<< END OF multiplyMatrixVectorSparse */
+/*<<< END OF multiplyMatrixTVectorSparse */
 
 
 /* ----------------------------------------------
@@ -2098,7 +2391,13 @@ return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 {
 	int_t ii, jj, ll;
 
-	/* always assuming M2 is dense */
+	if ( ( M2->sparsityType == QPDUNES_SPARSE ) &&
+		 ( ( cholM1->sparsityType == QPDUNES_DIAGONAL ) || ( cholM1->sparsityType == QPDUNES_IDENTITY ) ) )
+	{
+		return addMultiplyMatrixInvMatrixMatrixTSparse( qpData, res, cholM1, &(M2->sparse), y, dim0, dim1 );
+	}
+
+	/* otherwise assuming M2 is dense (dense mirror of sparse M2 for dense M1) */
 /*	assert( M2->sparsityType == QPDUNES_DENSE );*/
 	/* compute M1^-1/2 * M2.T */
 	switch (cholM1->sparsityType) {
@@ -2163,25 +2462,123 @@ return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 
 
 /* ----------------------------------------------
- * Low level scalar product 
+ *  M2 * M1^-1 * M2.T for diagonal M1 and M2 in
+ *  compressed sparse column storage
+ *  result gets added to res, not overwritten
+ *
+ * >>>>>>                                           */
+return_t addMultiplyMatrixInvMatrixMatrixTSparse(	qpData_t* const qpData,
+													matrix_t* const res,
+													const matrix_t* const cholM1,
+													const sparseStorage_t* const M2,
+													const real_t* const y, /**< vector containing non-zeros for columns of M2 to be eliminated */
+													int_t dim0, /**< dimensions of M2 */
+													int_t dim1
+													)
+{
+	int_t ii, jj, ll;
+	real_t invM1Val;
+
+	qpDUNES_makeMatrixDense(res, dim0, dim0);
+
+	/* every free column ll contributes the dyadic product of its nonzeros only */
+	for (ll = 0; ll < dim1; ++ll) {
+		/* only add columns of variables with inactive bounds */
+		if ((y[2 * ll] <= qpData->options.equalityTolerance) && /* lower bound inactive */
+		(y[2 * ll + 1] <= qpData->options.equalityTolerance)) /* upper bound inactive */
+		{
+			for (jj = M2->colPtr[ll]; jj < M2->colPtr[ll + 1]; ++jj) {
+				if (cholM1->sparsityType == QPDUNES_DIAGONAL) {
+					/* M1 is the actual matrix in diagonal case */
+					if ( fabs( cholM1->data[ll] ) < qpData->options.QPDUNES_ZERO * fabs( M2->val[jj] ) ) {
+						qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in addMultiplyMatrixInvMatrixMatrixTSparse. Rank-deficient Matrix?" );
+						return QPDUNES_ERR_DIVISION_BY_ZERO;
+					}
+					invM1Val = M2->val[jj] / cholM1->data[ll];
+				}
+				else {
+					invM1Val = M2->val[jj];
+				}
+				for (ii = M2->colPtr[ll]; ii < M2->colPtr[ll + 1]; ++ii) {
+					res->data[M2->rowIdx[ii] * dim0 + M2->rowIdx[jj]] += M2->val[ii] * invM1Val;
+				}
+			}
+		} /* end of dyadic addend */
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF addMultiplyMatrixInvMatrixMatrixTSparse */
+
+
+/* ----------------------------------------------
+ * Low level scalar product; long vectors are split into leaves
+ * whose partial products are summed up in a fixed tree, so the
+ * result does not depend on the number of threads
  * 
  >>>>>>                                           */
 real_t scalarProd(	const vector_t* const x,
 					const vector_t* const y,
 					int_t len 	)
 {
-	int_t ii;
+	int_t ii, ll;
+	int_t leafSize, nLeaves, iEnd;
 	real_t res = 0.;
+	real_t partial[QPDUNES_REDUCTION_MAX_LEAVES];
 	
-	for( ii = 0; ii < len; ++ii ) {
-		res += x->data[ii]*y->data[ii];
+	if ( len <= QPDUNES_REDUCTION_LEAF_SIZE ) {
+		for( ii = 0; ii < len; ++ii ) {
+			res += x->data[ii]*y->data[ii];
+		}
+		return res;
+	}
+
+	leafSize = qpDUNES_max( QPDUNES_REDUCTION_LEAF_SIZE, (len + QPDUNES_REDUCTION_MAX_LEAVES - 1) / QPDUNES_REDUCTION_MAX_LEAVES );
+	nLeaves = (len + leafSize - 1) / leafSize;
+
+	#ifdef __QPDUNES_PARALLEL__
+	#pragma omp parallel for private(ll, ii, iEnd, res) schedule(static) if(len >= QPDUNES_REDUCTION_PARALLEL_MIN_LEN)
+	#endif
+	for( ll = 0; ll < nLeaves; ++ll ) {
+		res = 0.;
+		iEnd = qpDUNES_min( (ll + 1) * leafSize, len );
+		for( ii = ll * leafSize; ii < iEnd; ++ii ) {
+			res += x->data[ii]*y->data[ii];
+		}
+		partial[ll] = res;
 	}
 	
-	return res;
+	return treeSum( partial, nLeaves );
 }
 /*<<< END OF scalarProd */
 
 
+/* ----------------------------------------------
+ * pairwise sum of n partial results; the summation order only
+ * depends on n, neighbouring entries are added first
+ * 
+ >>>>>>                                           */
+real_t treeSum(	real_t* const partial,
+				int_t n
+				)
+{
+	int_t ii, stride;
+
+	if ( n <= 0 ) {
+		return 0.;
+	}
+
+	for( stride = 1; stride < n; stride *= 2 ) {
+		for( ii = 0; ii + stride < n; ii += 2 * stride ) {
+			partial[ii] += partial[ii + stride];
+		}
+	}
+
+	return partial[0];
+}
+/*<<< END OF treeSum */
+
+
 /* ----------------------------------------------
  * ...
  * 
@@ -77,6 +77,38 @@ void qpDUNES_intFree(	int_t** data
 /*<<< END OF qp42_intFree */
 
 
+/* ----------------------------------------------
+ * safe free routine
+ *
+ > >>>>>                  *                         */
+void qpDUNES_uintFree(	uint_t** data
+					)
+{
+	if ( *data != 0 )
+	{
+		free( *data );
+		*data = 0;
+	}
+}
+/*<<< END OF qpDUNES_uintFree */
+
+
+/* ----------------------------------------------
+ * safe free routine
+ *
+ > >>>>>                  *                         */
+void qpDUNES_facFree(	facReal_t** data
+					)
+{
+	if ( *data != 0 )
+	{
+		free( *data );
+		*data = 0;
+	}
+}
+/*<<< END OF qpDUNES_facFree */
+
+
 
 /* ----------------------------------------------
  * safe array offset routine, avoids NULL
@@ -111,37 +143,42 @@ void qpDUNES_copyRealArray( int_t n,
 
 sparsityType_t qpDUNES_detectMatrixSparsity(	const real_t* const M,
 											int_t nRows,
-											int_t nCols
+											int_t nCols,
+											real_t zeroTolerance,
+											real_t densityThreshold
 											)
 {
 	sparsityType_t sparsityM;
 	int_t i,j;
+	int_t nnz = 0;
 	
 	if ( ( nRows < 1 ) || ( nCols < 1 ) || ( M == 0 ) )
-		return QPDUNES_OK;
+		return QPDUNES_MATRIX_UNDEFINED;
+	
+	/* count exact nonzeros; independent of storage order */
+	for( i=0; i<nRows*nCols; ++i ) {
+		if ( M[i] != 0.0 ) {
+			++nnz;
+		}
+	}
 	
 	if ( nRows != nCols )
 	{
-		sparsityM = QPDUNES_DENSE;
-		return QPDUNES_OK;
+		return ( nnz < densityThreshold * nRows * nCols ) ? QPDUNES_SPARSE : QPDUNES_DENSE;
 	}
 	
 	/* check for sparsity */
 	sparsityM = QPDUNES_DIAGONAL;
 	
 	for( i=0; i<nRows; ++i ) {	/* check if dense */
-		for( j=0; j<i-1; ++j ) {	/* lower triangle */
-			if ( fabs( M[i*nCols+j] ) > 1e-15 ) {	/* TODO: make threshold adjustable! */
-				sparsityM = QPDUNES_DENSE;
-				break;
-			}
-		}
-		for( j=i+1; j<nCols; ++j ) {	/* upper triangle */
-			if ( fabs( M[i*nCols+j] ) > 1e-15 ) {
+		for( j=0; j<nCols; ++j ) {	/* off-diagonal entries */
+			if ( ( j != i ) && ( fabs( M[i*nCols+j] ) > zeroTolerance ) ) {
 				sparsityM = QPDUNES_DENSE;
 				break;
 			}
 		}
+		if ( sparsityM == QPDUNES_DENSE )
+			break;
 	}
 	
 	/* check whether diagonal or identity */
@@ -150,25 +187,143 @@ sparsityType_t qpDUNES_detectMatrixSparsity(	const real_t* const M,
 		sparsityM = QPDUNES_IDENTITY;
 		
 		for( i=0; i<nRows; ++i ) {
-			if ( fabs( M[i*nCols+i] - 1.0 ) > 1e-15 ) {
+			if ( fabs( M[i*nCols+i] - 1.0 ) > zeroTolerance ) {
 				sparsityM = QPDUNES_DIAGONAL;
 				break;
 			}
 		}
 	}
+	else if ( nnz < densityThreshold * nRows * nCols )
+	{
+		sparsityM = QPDUNES_SPARSE;
+	}
 	
 	return sparsityM;
 	
 }
 
 
+return_t qpDUNES_detectMatrixStructure(	matrixStructure_t* const S,
+										const real_t* const M,
+										int_t dim,
+										int_t ldM
+										)
+{
+	int_t i,j;
+	int_t bs;
+	boolean_t isBlockDiagonal = QPDUNES_FALSE;
+	boolean_t hasUnitDiagonal = QPDUNES_TRUE;
+	
+	S->type = QPDUNES_STRUCTURE_GENERAL;
+	S->lowerBw = dim-1;
+	S->upperBw = dim-1;
+	S->blockSize = dim;
+	
+	if ( ( dim < 2 ) || ( M == 0 ) )
+		return QPDUNES_OK;
+	
+	/* bandwidths; only exact zeros are structural */
+	S->lowerBw = 0;
+	S->upperBw = 0;
+	for( i=0; i<dim; ++i ) {
+		for( j=0; j<dim; ++j ) {
+			if ( M[i*ldM+j] != 0.0 ) {
+				if ( i-j > S->lowerBw )		S->lowerBw = i-j;
+				if ( j-i > S->upperBw )		S->upperBw = j-i;
+			}
+		}
+		if ( M[i*ldM+i] != 1.0 )
+			hasUnitDiagonal = QPDUNES_FALSE;
+	}
+	
+	/* integrator chain: x_i+ = x_i + a_i * x_(i+1) + ... */
+	if ( ( S->lowerBw == 0 ) && ( S->upperBw <= 1 ) && ( hasUnitDiagonal == QPDUNES_TRUE ) ) {
+		S->type = QPDUNES_STRUCTURE_INTEGRATOR_CHAIN;
+		return QPDUNES_OK;
+	}
+	
+	/* smallest uniform block size that holds all nonzeros; blocks cannot be narrower than the band */
+	for( bs = ( S->lowerBw > S->upperBw ? S->lowerBw : S->upperBw ) + 1; bs <= (dim+1)/2; ++bs ) {
+		isBlockDiagonal = QPDUNES_TRUE;
+		for( i=0; ( i<dim ) && ( isBlockDiagonal == QPDUNES_TRUE ); ++i ) {
+			for( j=0; j<dim; ++j ) {
+				if ( ( i/bs != j/bs ) && ( M[i*ldM+j] != 0.0 ) ) {
+					isBlockDiagonal = QPDUNES_FALSE;
+					break;
+				}
+			}
+		}
+		if ( isBlockDiagonal == QPDUNES_TRUE )
+			break;
+	}
+	
+	/* pick the class that touches fewer entries per row */
+	if ( ( isBlockDiagonal == QPDUNES_TRUE ) && ( bs < S->lowerBw + S->upperBw + 1 ) ) {
+		S->type = QPDUNES_STRUCTURE_BLOCK_DIAGONAL;
+		S->blockSize = bs;
+	}
+	else if ( S->lowerBw + S->upperBw + 1 < dim ) {
+		S->type = QPDUNES_STRUCTURE_BANDED;
+	}
+	
+	return QPDUNES_OK;
+}
+
+
+void qpDUNES_getStructureRowRange(	const matrixStructure_t* const S,
+									int_t i,
+									int_t dim,
+									int_t* const jBegin,
+									int_t* const jEnd
+									)
+{
+	switch ( S->type )
+	{
+		case QPDUNES_STRUCTURE_BLOCK_DIAGONAL:
+			*jBegin = ( i / S->blockSize ) * S->blockSize;
+			*jEnd = *jBegin + S->blockSize;
+			break;
+			
+		case QPDUNES_STRUCTURE_BANDED:
+		case QPDUNES_STRUCTURE_INTEGRATOR_CHAIN:
+			*jBegin = i - S->lowerBw;
+			*jEnd = i + S->upperBw + 1;
+			break;
+			
+		default:
+			*jBegin = 0;
+			*jEnd = dim;
+	}
+	
+	if ( *jBegin < 0 )		*jBegin = 0;
+	if ( *jEnd > dim )		*jEnd = dim;
+}
+
+
+void qpDUNES_getStructureColumnRange(	const matrixStructure_t* const S,
+										int_t j,
+										int_t dim,
+										int_t* const iBegin,
+										int_t* const iEnd
+										)
+{
+	matrixStructure_t ST = *S;
+	
+	/* column j of M is row j of M^T, whose bandwidths are swapped */
+	ST.lowerBw = S->upperBw;
+	ST.upperBw = S->lowerBw;
+	qpDUNES_getStructureRowRange( &ST, j, dim, iBegin, iEnd );
+}
+
+
 return_t qpDUNES_updateMatrixData(	matrix_t* const to,
 								const real_t* const from,
 								int_t nRows,
-								int_t nCols
+								int_t nCols,
+								storageOrder_t storageOrder
 								)
 {
-	int_t i;
+	int_t i, j;
 	real_t* _to = to->data;
 	unsigned _dim = nRows * nCols;
 	
@@ -181,11 +336,20 @@ return_t qpDUNES_updateMatrixData(	matrix_t* const to,
 	switch ( to->sparsityType )
 	{
 		case QPDUNES_DENSE:
-			for (i = 0; i < _dim; ++i)
-				_to[ i ] = from[ i ];
+		case QPDUNES_SPARSE:	/* dense data is kept as mirror of the compressed storage */
+			if ( storageOrder == QPDUNES_COLUMN_MAJOR ) {
+				/* read source contiguously, scatter into row-major storage */
+				for (j = 0; j < nCols; ++j)
+					for (i = 0; i < nRows; ++i)
+						_to[ i * nCols + j ] = from[ j * nRows + i ];
+			}
+			else {
+				for (i = 0; i < _dim; ++i)
+					_to[ i ] = from[ i ];
+			}
 			break;
 			
-		case QPDUNES_DIAGONAL:
+		case QPDUNES_DIAGONAL:	/* diagonal entries sit at the same place in either storage order */
 			for (i = 0; i < nRows; ++i)
 				_to[ i ] = from[i * nCols + i];
 			break;
@@ -197,10 +361,115 @@ return_t qpDUNES_updateMatrixData(	matrix_t* const to,
 			return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
 	}
 	
+	if ( to->sparsityType == QPDUNES_SPARSE )
+		return qpDUNES_updateSparseStorage( to, nRows, nCols );
+	
+	return QPDUNES_OK;
+}
+
+
+return_t qpDUNES_updateSparseStorage(	matrix_t* const M,
+										int_t nRows,
+										int_t nCols
+										)
+{
+	int_t i, j;
+	int_t nnz = 0;
+	sparseStorage_t* sp = &(M->sparse);
+	
+	if ( M->sparsityType != QPDUNES_SPARSE )
+		return QPDUNES_OK;
+	
+	for( i=0; i<nRows*nCols; ++i ) {
+		if ( M->data[i] != 0.0 ) {
+			++nnz;
+		}
+	}
+	
+	/* (re-)allocate if sparsity pattern grew */
+	if ( sp->colPtr == 0 ) {
+		sp->colPtr = (int_t*)qpDUNES_calloc( nCols+1, sizeof(int_t) );
+	}
+	if ( ( nnz > sp->nnzMax ) || ( sp->rowIdx == 0 ) ) {
+		qpDUNES_intFree( &(sp->rowIdx) );
+		qpDUNES_free( &(sp->val) );
+		sp->nnzMax = ( nnz > 0 ) ? nnz : 1;
+		sp->rowIdx = (int_t*)qpDUNES_calloc( sp->nnzMax, sizeof(int_t) );
+		sp->val = (real_t*)qpDUNES_calloc( sp->nnzMax, sizeof(real_t) );
+	}
+	
+	/* compress column by column from row-major dense data */
+	sp->nnz = 0;
+	for( j=0; j<nCols; ++j ) {
+		sp->colPtr[j] = sp->nnz;
+		for( i=0; i<nRows; ++i ) {
+			if ( M->data[i*nCols+j] != 0.0 ) {
+				sp->rowIdx[sp->nnz] = i;
+				sp->val[sp->nnz] = M->data[i*nCols+j];
+				++(sp->nnz);
+			}
+		}
+	}
+	sp->colPtr[nCols] = sp->nnz;
+	
 	return QPDUNES_OK;
 }
 
 
+return_t qpDUNES_scaleMatrix(	matrix_t* const M,
+								const real_t* const rowFactors,
+								const real_t* const colFactors,
+								int_t nRows,
+								int_t nCols
+								)
+{
+	int_t i, j;
+	
+	switch ( M->sparsityType )
+	{
+		case QPDUNES_DENSE:
+		case QPDUNES_SPARSE:
+			for (i = 0; i < nRows; ++i) {
+				for (j = 0; j < nCols; ++j) {
+					if ( rowFactors != 0 )	M->data[i * nCols + j] *= rowFactors[i];
+					if ( colFactors != 0 )	M->data[i * nCols + j] *= colFactors[j];
+				}
+			}
+			return qpDUNES_updateSparseStorage( M, nRows, nCols );
+			
+		case QPDUNES_IDENTITY:
+			for (i = 0; i < nRows; ++i)
+				M->data[i] = 1.0;
+			M->sparsityType = QPDUNES_DIAGONAL;
+			/* fall through */
+		case QPDUNES_DIAGONAL:
+			for (i = 0; i < nRows; ++i) {
+				if ( rowFactors != 0 )	M->data[i] *= rowFactors[i];
+				if ( colFactors != 0 )	M->data[i] *= colFactors[i];
+			}
+			return QPDUNES_OK;
+			
+		case QPDUNES_MATRIX_UNDEFINED:		/* matrix not given */
+		case QPDUNES_ALLZEROS:
+			return QPDUNES_OK;
+			
+		default:
+			return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+	}
+}
+
+
+void qpDUNES_freeSparseStorage(	matrix_t* const M
+								)
+{
+	qpDUNES_intFree( &(M->sparse.colPtr) );
+	qpDUNES_intFree( &(M->sparse.rowIdx) );
+	qpDUNES_free( &(M->sparse.val) );
+	M->sparse.nnz = 0;
+	M->sparse.nnzMax = 0;
+}
+
+
 return_t qpDUNES_setupZeroMatrix(	int_t nRows,
 								int_t nCols,
 								matrix_t* to
@@ -221,6 +490,9 @@ return_t qpDUNES_setMatrixNull(	matrix_t* const matrix
 								)
 {
 	qpDUNES_free( &(matrix->data) );
+	if ( matrix->sparsityType == QPDUNES_SPARSE ) {
+		qpDUNES_freeSparseStorage( matrix );
+	}
 	matrix->sparsityType = QPDUNES_MATRIX_UNDEFINED;
 	
 	return QPDUNES_OK;
@@ -310,29 +582,30 @@ return_t qpDUNES_updateVector(	vector_t* const to,
 }
 
 
-return_t qpDUNES_updateSimpleBoundVector(	qpData_t* qpData,
-										vector_t* const to,
+return_t qpDUNES_updateSimpleBoundVector(	vector_t* const to,
 										const real_t* const dBnd,
 										const real_t* const xBnd,
-										const real_t* const uBnd
+										const real_t* const uBnd,
+										uint_t nX,
+										uint_t nU
 										)
 {
 	uint_t i;
 	
 	if ( dBnd != 0 ) {
-		for( i=0; i<_NX_+_NU_; ++i ) {
+		for( i=0; i<nX+nU; ++i ) {
 			to->data[i] = dBnd[i];
 		}
 	}
 	else {
 		if ( xBnd != 0 ) {
-			for( i=0; i<_NX_; ++i ) {
+			for( i=0; i<nX; ++i ) {
 				to->data[i] = xBnd[i];
 			}
 		}
 		if ( uBnd != 0 ) {
-			for( i=0; i<_NU_; ++i ) {
-				to->data[_NX_+i] = uBnd[i];
+			for( i=0; i<nU; ++i ) {
+				to->data[nX+i] = uBnd[i];
 			}
 		}
 	}
@@ -654,6 +927,38 @@ int_t qpDUNES_sign(	const qpData_t* const qpData,
 
 
 
+uint_t qpDUNES_popcount(	actSetWord_t word
+							)
+{
+	#if defined(__GNUC__)
+	return (uint_t)__builtin_popcount( word );
+	#else
+	uint_t nBits = 0;
+
+	while ( word != 0 ) {
+		word &= word - 1;		/* clear lowest set bit */
+		++nBits;
+	}
+	return nBits;
+	#endif
+}
+/*<<< END OF qpDUNES_popcount */
+
+
+
+actSetWord_t qpDUNES_getActSetStatus(	const actSet_t* const actSet,
+										int_t ii,
+										boolean_t fromPrevBits
+										)
+{
+	const actSetWord_t* bits = ( fromPrevBits == QPDUNES_TRUE ) ? actSet->prevBits : actSet->bits;
+
+	return ( bits[ii / QPDUNES_ACTSET_CONSTR_PER_WORD] >> ( 2 * (ii % QPDUNES_ACTSET_CONSTR_PER_WORD) ) ) & 3;
+}
+/*<<< END OF qpDUNES_getActSetStatus */
+
+
+
 /*extern inline void qp42_assertOK(	return_t statusFlag,*/
 void qpDUNES_assertOK(	return_t statusFlag,
 							char* fileName,
@@ -1059,27 +1364,27 @@ void qpDUNES_printNewtonHessian(	const qpData_t* const qpData,
 								)
 {
 	#ifndef __SUPPRESS_ALL_OUTPUT__
-	uint_t ii, jj, kk;
+	int_t ii, jj, kk;
 
 	qpDUNES_printStrArgs( "NewtonHessian = ...\n" );
 	qpDUNES_printStrArgs( "[\n" );
 
 	for( kk=0; kk<_NI_; ++kk ) {
-		for( ii=0; ii<_NX_; ++ii ) {
+		for( ii=0; ii<_NX(kk+1); ++ii ) {
 			qpDUNES_printStrArgs( "[" );
-			for( jj=0; jj < ((kk-1) * (uint_t)_NX_); ++jj ) {  /* begin of row */  /* need casting from uint_t to int_t to enable safe comparisons */
+			for( jj=0; jj < ((kk > 0) ? _XNOFF(kk-1) : 0); ++jj ) {  /* begin of row */
 				qpDUNES_printStrArgs( " 0.0\t\t\t" );
 			}
-			for( jj=0; jj<(kk > 0 ? 1 : 0)*(uint_t)_NX_; ++jj ) {  /* subdiagonal block */
+			for( jj=0; jj<(kk > 0 ? 1 : 0)*_NX(kk); ++jj ) {  /* subdiagonal block */
 				qpDUNES_printStrArgs( "% .*e\t", PRINTING_PRECISION, accHessian( kk, -1, ii, jj ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=0; jj<_NX_; ++jj ) {	/* diagonal block */
-				qpDUNES_printStrArgs( "% .*e\t", PRINTING_PRECISION, accHessian( kk, 0, ii, jj ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
+			for( jj=0; jj<_NX(kk+1); ++jj ) {	/* diagonal block */
+				qpDUNES_printStrArgs( "% .*e\t", PRINTING_PRECISION, (jj <= ii) ? accHessian( kk, 0, ii, jj ) : accHessian( kk, 0, jj, ii ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=0; jj<(kk < _NI_-1 ? 1 : 0)*(uint_t)_NX_; ++jj ) {  /* superdiagonal block */
+			for( jj=0; jj<(kk < _NI_-1 ? 1 : 0)*_NX(kk+2); ++jj ) {  /* superdiagonal block */
 				qpDUNES_printStrArgs( "% .*e\t", PRINTING_PRECISION, accHessian( kk+1, -1, jj, ii ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=(kk+2)*_NX_; jj<_NI_*_NX_; ++jj ) {  /* remaining row */
+			for( jj=_XNOFF( (kk+2 < _NI_) ? kk+2 : _NI_ ); jj<_NXTTL_; ++jj ) {  /* remaining row */
 				qpDUNES_printStrArgs( " 0.0\t\t\t" );
 			}
 			qpDUNES_printStrArgs( "]\n" );
@@ -1105,7 +1410,7 @@ void qpDUNES_printNewtonHessianToFile(	const qpData_t* const qpData,
 									)
 {
 	#ifndef __SUPPRESS_ALL_OUTPUT__
-	uint_t ii, jj, kk;
+	int_t ii, jj, kk;
 
 	va_list printArgs;
 
@@ -1119,21 +1424,21 @@ void qpDUNES_printNewtonHessianToFile(	const qpData_t* const qpData,
 	va_end( printArgs );
 
 	for( kk=0; kk<_NI_; ++kk ) {
-		for( ii=0; ii<_NX_; ++ii ) {
+		for( ii=0; ii<_NX(kk+1); ++ii ) {
 			qpDUNES_printStrArgsToFile( filePtr,  "" );
-			for( jj=0; jj < ((kk-1) * (uint_t)_NX_); ++jj ) {  /* begin of row */  /* need casting from uint_t to int_t to enable safe comparisons */
+			for( jj=0; jj < ((kk > 0) ? _XNOFF(kk-1) : 0); ++jj ) {  /* begin of row */
 				qpDUNES_printStrArgsToFile( filePtr, " 0.0\t\t\t" );
 			}
-			for( jj=0; jj<(kk > 0 ? 1 : 0)*_NX_; ++jj ) {  /* subdiagonal block */
+			for( jj=0; jj<(kk > 0 ? 1 : 0)*_NX(kk); ++jj ) {  /* subdiagonal block */
 				qpDUNES_printStrArgsToFile( filePtr, "% .*e\t", PRINTING_PRECISION, accHessian( kk, -1, ii, jj ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=0; jj<_NX_; ++jj ) {	/* diagonal block */
-				qpDUNES_printStrArgsToFile( filePtr, "% .*e\t", PRINTING_PRECISION, accHessian( kk, 0, ii, jj ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
+			for( jj=0; jj<_NX(kk+1); ++jj ) {	/* diagonal block */
+				qpDUNES_printStrArgsToFile( filePtr, "% .*e\t", PRINTING_PRECISION, (jj <= ii) ? accHessian( kk, 0, ii, jj ) : accHessian( kk, 0, jj, ii ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=0; jj<(kk < _NI_-1 ? 1 : 0)*_NX_; ++jj ) {  /* superdiagonal block */
+			for( jj=0; jj<(kk < _NI_-1 ? 1 : 0)*_NX(kk+2); ++jj ) {  /* superdiagonal block */
 				qpDUNES_printStrArgsToFile( filePtr, "% .*e\t", PRINTING_PRECISION, accHessian( kk+1, -1, jj, ii ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=(kk+2)*_NX_; jj<_NI_*_NX_; ++jj ) {  /* remaining row */
+			for( jj=_XNOFF( (kk+2 < _NI_) ? kk+2 : _NI_ ); jj<_NXTTL_; ++jj ) {  /* remaining row */
 				qpDUNES_printStrArgsToFile( filePtr, " 0.0\t\t\t" );
 			}
 			qpDUNES_printStrArgsToFile( filePtr, "\n" );
@@ -1158,24 +1463,24 @@ void qpDUNES_printCholNewtonHessian(	const qpData_t* const qpData,
 									)
 {
 	#ifndef __SUPPRESS_ALL_OUTPUT__
-	uint_t ii, jj, kk;
+	int_t ii, jj, kk;
 
 	qpDUNES_printStrArgs( "Cholesky factor of Newton Hessian\n" );
 	qpDUNES_printStrArgs( "[\n" );
 
 	for( kk=0; kk<_NI_; ++kk ) {
-		for( ii=0; ii<_NX_; ++ii ) {
+		for( ii=0; ii<_NX(kk+1); ++ii ) {
 			qpDUNES_printStrArgs( "[" );
-			for( jj=0; jj < ((kk-1) * (uint_t)_NX_); ++jj ) {  /* begin of row */  /* need casting from uint_t to int_t to enable safe comparisons */
+			for( jj=0; jj < ((kk > 0) ? _XNOFF(kk-1) : 0); ++jj ) {  /* begin of row */
 				qpDUNES_printStrArgs( "0.0\t\t\t" );
 			}
-			for( jj=0; jj<(kk > 0 ? 1 : 0)*_NX_; ++jj ) {  /* subdiagonal block */
+			for( jj=0; jj<(kk > 0 ? 1 : 0)*_NX(kk); ++jj ) {  /* subdiagonal block */
 				qpDUNES_printStrArgs( "%.*e\t", PRINTING_PRECISION, accCholHessian( kk, -1, ii, jj ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
 			for( jj=0; jj<=ii; ++jj ) {	/* diagonal block */
 				qpDUNES_printStrArgs( "%.*e\t", PRINTING_PRECISION, accCholHessian( kk, 0, ii, jj ) );	/* TODO: use variable from qpOptions Struct; currently defined in types.h */
 			}
-			for( jj=kk*_NX_+ii+1; jj<_NI_*_NX_; ++jj ) {  /* remaining row */
+			for( jj=_XNOFF(kk)+ii+1; jj<_NXTTL_; ++jj ) {  /* remaining row */
 				qpDUNES_printStrArgs( "0.0\t\t\t" );
 			}
 			qpDUNES_printStrArgs( "]\n" );
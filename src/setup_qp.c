@@ -34,7 +34,8 @@
 
 
 /* ----------------------------------------------
- * memory allocation
+ * memory allocation for a problem with the same
+ * number of states and controls on all stages
  * 
 #>>>>>>                                           */
 return_t qpDUNES_setup(	qpData_t* const qpData,
@@ -44,10 +45,52 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 						uint_t* nD,
 						qpOptions_t* options
 						)
+{
+	uint_t kk;
+
+	return_t statusFlag;
+
+	uint_t* nXk = (uint_t*)qpDUNES_calloc( nI+1,sizeof(uint_t) );
+	uint_t* nUk = (uint_t*)qpDUNES_calloc( nI,sizeof(uint_t) );
+
+	for( kk=0; kk<nI; ++kk ) {
+		nXk[kk] = nX;
+		nUk[kk] = nU;
+	}
+	nXk[nI] = nX;
+
+	statusFlag = qpDUNES_setupVariableDims( qpData, nI, nXk, nUk, nD, options );
+
+	qpDUNES_uintFree( &nXk );
+	qpDUNES_uintFree( &nUk );
+
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_setup */
+
+
+/* ----------------------------------------------
+ * memory allocation for a problem with stage-wise
+ * numbers of states nX[0..nI] and controls nU[0..nI-1];
+ * the Newton Hessian and all multiplier vectors are
+ * stored without padding
+ * 
+#>>>>>>                                           */
+return_t qpDUNES_setupVariableDims(	qpData_t* const qpData,
+									uint_t nI,
+									const uint_t* const nX,
+									const uint_t* const nU,
+									uint_t* nD,
+									qpOptions_t* options
+									)
 {
 	uint_t ii, kk;
 
-	int_t nZ = nX+nU;
+	uint_t nXmax = 0;	/* workspace is sized for the largest stage */
+	uint_t nUmax = 0;
+	uint_t nZmax = 0;
+	uint_t nXttl;
+	uint_t nHttl;		/* number of stored Newton Hessian elements */
 
 	int_t nDttl = 0;	/* total number of constraints */
 
@@ -60,10 +103,22 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 	}
 
 	/* set up dimensions */
+	qpData->hasUniformDims = QPDUNES_TRUE;
+	for( kk=0; kk<nI+1; ++kk ) {
+		if ( nX[kk] > nXmax )	nXmax = nX[kk];
+		if ( nX[kk] != nX[0] )	qpData->hasUniformDims = QPDUNES_FALSE;
+		if ( kk < nI ) {
+			if ( nU[kk] > nUmax )	nUmax = nU[kk];
+			if ( nU[kk] != nU[0] )	qpData->hasUniformDims = QPDUNES_FALSE;
+			if ( nX[kk]+nU[kk] > nZmax )	nZmax = nX[kk]+nU[kk];
+		}
+	}
+	if ( nX[nI] > nZmax )	nZmax = nX[nI];
+
 	qpData->nI = nI;
-	qpData->nX = nX;
-	qpData->nU = nU;
-	qpData->nZ = nZ;
+	qpData->nX = nXmax;
+	qpData->nU = nUmax;
+	qpData->nZ = nZmax;
 
 	if (nD != 0) {
 		for( ii=0; ii<nI+1; ++ii ) {
@@ -77,33 +132,45 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 		return QPDUNES_ERR_INVALID_ARGUMENT;
 	}
 
+	/* offsets of multiplier blocks and Newton Hessian block rows; block row kk holds the
+	 * sub-diagonal block (nX[kk+1] x nX[kk]) and the packed lower triangle of the diagonal block */
+	qpData->xnOffset = (uint_t*)qpDUNES_calloc( nI+1,sizeof(uint_t) );
+	qpData->xn2xOffset = (uint_t*)qpDUNES_calloc( nI+1,sizeof(uint_t) );
+	for( kk=0; kk<nI; ++kk ) {
+		qpData->xnOffset[kk+1] = qpData->xnOffset[kk] + nX[kk+1];
+		qpData->xn2xOffset[kk+1] = qpData->xn2xOffset[kk] + nX[kk+1] * nX[kk] + nX[kk+1] * (nX[kk+1] + 1) / 2;
+	}
+	nXttl = qpData->xnOffset[nI];
+	nHttl = qpData->xn2xOffset[nI];
+	qpData->nXttl = nXttl;
+
 	qpData->intervals = (interval_t**)qpDUNES_calloc( nI+1,sizeof(interval_t*) );
 
 
 	/* normal intervals */
 	for( ii=0; ii<nI; ++ii )
 	{
-		qpData->intervals[ii] = qpDUNES_allocInterval( qpData, nX, nU, nZ, ( (nD != 0) ? nD[ii] : 0 ) );
+		qpData->intervals[ii] = qpDUNES_allocInterval( qpData, nX[ii], nU[ii], nX[ii+1], ( (nD != 0) ? nD[ii] : 0 ) );
 		
 		qpData->intervals[ii]->id = ii;		/* give interval its initial stage index */
 
-		qpData->intervals[ii]->xVecTmp.data  = (real_t*)qpDUNES_calloc( nX,sizeof(real_t) );
-		qpData->intervals[ii]->uVecTmp.data  = (real_t*)qpDUNES_calloc( nU,sizeof(real_t) );
-		qpData->intervals[ii]->zVecTmp.data  = (real_t*)qpDUNES_calloc( nZ,sizeof(real_t) );
+		qpData->intervals[ii]->xVecTmp.data  = (real_t*)qpDUNES_calloc( nXmax,sizeof(real_t) );
+		qpData->intervals[ii]->uVecTmp.data  = (real_t*)qpDUNES_calloc( nUmax,sizeof(real_t) );
+		qpData->intervals[ii]->zVecTmp.data  = (real_t*)qpDUNES_calloc( nZmax,sizeof(real_t) );
 	}
 	
 
 	/* last interval */
-	qpData->intervals[nI] = qpDUNES_allocInterval( qpData, nX, nU, nX, ( (nD != 0) ? nD[nI] : 0 ) );
+	qpData->intervals[nI] = qpDUNES_allocInterval( qpData, nX[nI], 0, nX[nI], ( (nD != 0) ? nD[nI] : 0 ) );
 	
 	qpData->intervals[nI]->id = nI;		/* give interval its initial stage index */
 
 	qpDUNES_setMatrixNull( &( qpData->intervals[nI]->C ) );
 	qpDUNES_free( &(qpData->intervals[nI]->c.data) );
 
-	qpData->intervals[nI]->xVecTmp.data  = (real_t*)qpDUNES_calloc( nX,sizeof(real_t) );
-	qpData->intervals[nI]->uVecTmp.data  = (real_t*)qpDUNES_calloc( nU,sizeof(real_t) );
-	qpData->intervals[nI]->zVecTmp.data  = (real_t*)qpDUNES_calloc( nZ,sizeof(real_t) );
+	qpData->intervals[nI]->xVecTmp.data  = (real_t*)qpDUNES_calloc( nXmax,sizeof(real_t) );
+	qpData->intervals[nI]->uVecTmp.data  = (real_t*)qpDUNES_calloc( nUmax,sizeof(real_t) );
+	qpData->intervals[nI]->zVecTmp.data  = (real_t*)qpDUNES_calloc( nZmax,sizeof(real_t) );
 	
 	
 	/* undefined not-defined lambda parts */
@@ -113,26 +180,46 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 
 
 	/* remainder of qpData struct */
-	qpData->lambda.data      = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
-	qpData->deltaLambda.data = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
+	qpData->lambda.data      = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->deltaLambda.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
 	
-	qpData->hessian.data  = (real_t*)qpDUNES_calloc( (nX*2)*(nX*nI),sizeof(real_t) );
-	qpData->cholHessian.data  = (real_t*)qpDUNES_calloc( (nX*2)*(nX*nI),sizeof(real_t) );
-	qpData->gradient.data = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
+	qpData->hessian.data  = (real_t*)qpDUNES_calloc( nHttl,sizeof(real_t) );
+	qpData->cholHessian.data  = (facReal_t*)qpDUNES_calloc( nHttl,sizeof(facReal_t) );
+	qpData->gradient.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->lsGradient.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->regShift = (real_t*)qpDUNES_calloc( nI,sizeof(real_t) );
+	qpData->regDirections.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->regParam = qpData->options.regParam;
+	qpData->nwtnFacTwistIdx = 0;
+	qpData->nwtnFacFirstChangeFreq = (real_t*)qpDUNES_calloc( nI,sizeof(real_t) );
+	qpData->nwtnFacLastChangeFreq = (real_t*)qpDUNES_calloc( nI,sizeof(real_t) );
+	qpData->nwtnBlockUpdateCount = (int_t*)qpDUNES_calloc( nI,sizeof(int_t) );
+	qpData->stageReductionTmp = (real_t*)qpDUNES_calloc( nI+1,sizeof(real_t) );
+	qpData->lsGridSize = qpDUNES_max( qpData->options.lineSearchNbrGridPoints, 2 );	/* more grid points are evaluated in several sweeps */
+	qpData->lsGridAlpha = (real_t*)qpDUNES_calloc( qpData->lsGridSize,sizeof(real_t) );
+	qpData->lsGridObjVal = (real_t*)qpDUNES_calloc( qpData->lsGridSize,sizeof(real_t) );
+	qpData->lsGridStageObjVal = (real_t*)qpDUNES_calloc( qpData->lsGridSize*(nI+1),sizeof(real_t) );
+	qpData->lsGridTmp = (real_t*)qpDUNES_calloc( 4*qpData->lsGridSize*(nI+1),sizeof(real_t) );
+	qpData->log.numProjCacheHits = 0;
+	qpData->log.numProjCacheMisses = 0;
 	
 	
-	qpData->xVecTmp.data  = (real_t*)qpDUNES_calloc( nX,sizeof(real_t) );
-	qpData->uVecTmp.data  = (real_t*)qpDUNES_calloc( nU,sizeof(real_t) );
-	qpData->zVecTmp.data  = (real_t*)qpDUNES_calloc( nZ,sizeof(real_t) );
-	qpData->xnVecTmp.data  = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
-	qpData->xnVecTmp2.data  = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
-	qpData->xxMatTmp.data = (real_t*)qpDUNES_calloc( nX*nX,sizeof(real_t) );
-	qpData->xxMatTmp2.data = (real_t*)qpDUNES_calloc( nX*nX,sizeof(real_t) );
-	qpData->xzMatTmp.data = (real_t*)qpDUNES_calloc( nX*nZ,sizeof(real_t) );
-	qpData->uxMatTmp.data = (real_t*)qpDUNES_calloc( nU*nX,sizeof(real_t) );
-	qpData->zxMatTmp.data = (real_t*)qpDUNES_calloc( nZ*nX,sizeof(real_t) );
-	qpData->zzMatTmp.data = (real_t*)qpDUNES_calloc( nZ*nZ,sizeof(real_t) );
-	qpData->zzMatTmp2.data = (real_t*)qpDUNES_calloc( nZ*nZ,sizeof(real_t) );
+	qpData->xVecTmp.data  = (real_t*)qpDUNES_calloc( nXmax,sizeof(real_t) );
+	qpData->uVecTmp.data  = (real_t*)qpDUNES_calloc( nUmax,sizeof(real_t) );
+	qpData->zVecTmp.data  = (real_t*)qpDUNES_calloc( nZmax,sizeof(real_t) );
+	qpData->xnVecTmp.data  = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->xnVecTmp2.data  = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->xnVecTmp3.data  = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->xnVecTmp4.data  = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->xnVecTmp5.data  = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->xnVecTmp6.data  = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+	qpData->xxMatTmp.data = (real_t*)qpDUNES_calloc( nXmax*nXmax,sizeof(real_t) );
+	qpData->xxMatTmp2.data = (real_t*)qpDUNES_calloc( nXmax*nXmax,sizeof(real_t) );
+	qpData->xzMatTmp.data = (real_t*)qpDUNES_calloc( nXmax*nZmax,sizeof(real_t) );
+	qpData->uxMatTmp.data = (real_t*)qpDUNES_calloc( nUmax*nXmax,sizeof(real_t) );
+	qpData->zxMatTmp.data = (real_t*)qpDUNES_calloc( nZmax*nXmax,sizeof(real_t) );
+	qpData->zzMatTmp.data = (real_t*)qpDUNES_calloc( nZmax*nZmax,sizeof(real_t) );
+	qpData->zzMatTmp2.data = (real_t*)qpDUNES_calloc( nZmax*nZmax,sizeof(real_t) );
 	
 	
 	/* set incumbent objective function value to minus infinity */
@@ -150,45 +237,36 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 			for( kk=0; kk<nI+1; ++kk ) {
 				qpData->log.itLog[ii].ieqStatus[kk] = (int_t*)qpDUNES_calloc( ((nD != 0) ? nD[kk] : 0) + _NV(kk),sizeof(int_t) );
 			}
-			qpData->log.itLog[ii].prevIeqStatus = 0;
 
 			if ( qpData->options.logLevel == QPDUNES_LOG_ALL_DATA )
 			{
-				qpData->log.itLog[ii].regDirections.data = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
+				qpData->log.itLog[ii].regDirections.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
 
-				qpData->log.itLog[ii].lambda.data      = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
-				qpData->log.itLog[ii].deltaLambda.data = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
+				qpData->log.itLog[ii].lambda.data      = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+				qpData->log.itLog[ii].deltaLambda.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
 
-				qpData->log.itLog[ii].gradient.data = (real_t*)qpDUNES_calloc( nX*nI,sizeof(real_t) );
-				qpData->log.itLog[ii].hessian.data  = (real_t*)qpDUNES_calloc( (nX*2)*(nX*nI),sizeof(real_t) );
-				qpData->log.itLog[ii].cholHessian.data  = (real_t*)qpDUNES_calloc( (nX*2)*(nX*nI),sizeof(real_t) );
+				qpData->log.itLog[ii].gradient.data = (real_t*)qpDUNES_calloc( nXttl,sizeof(real_t) );
+				qpData->log.itLog[ii].hessian.data  = (real_t*)qpDUNES_calloc( nHttl,sizeof(real_t) );
+				qpData->log.itLog[ii].cholHessian.data  = (real_t*)qpDUNES_calloc( nHttl,sizeof(real_t) );
 				#if defined(__ANALYZE_FACTORIZATION__)
-				qpData->log.itLog[ii].invHessian.data =  (real_t*)qpDUNES_calloc( (nX*nI)*(nX*nI),sizeof(real_t) );
+				qpData->log.itLog[ii].invHessian.data =  (real_t*)qpDUNES_calloc( nXttl*nXttl,sizeof(real_t) );
 				#endif
 
-				qpData->log.itLog[ii].dz.data = (real_t*)qpDUNES_calloc( nI*nZ+nX,sizeof(real_t) );
-				qpData->log.itLog[ii].zUnconstrained.data = (real_t*)qpDUNES_calloc( nI*nZ+nX,sizeof(real_t) );
-				qpData->log.itLog[ii].z.data  = (real_t*)qpDUNES_calloc( nI*nZ+nX,sizeof(real_t) );
-				qpData->log.itLog[ii].y.data  = (real_t*)qpDUNES_calloc( 2*nZ + 2*nDttl,sizeof(real_t) );
+				qpData->log.itLog[ii].dz.data = (real_t*)qpDUNES_calloc( nI*nZmax+nXmax,sizeof(real_t) );
+				qpData->log.itLog[ii].zUnconstrained.data = (real_t*)qpDUNES_calloc( nI*nZmax+nXmax,sizeof(real_t) );
+				qpData->log.itLog[ii].z.data  = (real_t*)qpDUNES_calloc( nI*nZmax+nXmax,sizeof(real_t) );
+				qpData->log.itLog[ii].y.data  = (real_t*)qpDUNES_calloc( 2*nZmax + 2*nDttl,sizeof(real_t) );
 				/* TODO: make multiplier definition clean! */
 			}
 		}
-
-		/* memory for itLog[0].prevIeqStatus needed in any case to enable AS comparison between subsequently solved QPs */
-		qpData->log.itLog[0].prevIeqStatus = (int_t**)qpDUNES_calloc( nI+1,sizeof(int_t*) );
-		for( kk=0; kk<nI+1; ++kk ) {
-			qpData->log.itLog[0].prevIeqStatus[kk] = (int_t*)qpDUNES_calloc( ((nD != 0) ? nD[kk] : 0) + _NV(kk),sizeof(int_t) );
-		}
 	}
 	else {
 		/* allocate only memory to check active set changes */
 		/* TODO: even remove this when no printing */
 		qpData->log.itLog = (itLog_t*)qpDUNES_calloc( 1, sizeof(itLog_t) );
 		qpData->log.itLog[0].ieqStatus = (int_t**)qpDUNES_calloc( nI+1,sizeof(int_t*) );
-		qpData->log.itLog[0].prevIeqStatus = (int_t**)qpDUNES_calloc( nI+1,sizeof(int_t*) );
 		for( kk=0; kk<nI+1; ++kk ) {
-			qpData->log.itLog[0].ieqStatus[kk] = (int_t*)qpDUNES_calloc( ((nD != 0) ? nD[kk] : 0) + nZ,sizeof(int_t) );
-			qpData->log.itLog[0].prevIeqStatus[kk] = (int_t*)qpDUNES_calloc( ((nD != 0) ? nD[kk] : 0) + nZ,sizeof(int_t) );
+			qpData->log.itLog[0].ieqStatus[kk] = (int_t*)qpDUNES_calloc( ((nD != 0) ? nD[kk] : 0) + nZmax,sizeof(int_t) );
 		}
 	}
 
@@ -201,23 +279,27 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_allocate */
+/*<<< END OF qpDUNES_setupVariableDims */
 
 
 /* ----------------------------------------------
  *
 #>>>>>>                                           */
 interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
-								uint_t nX,		/* FIXME: just use these temporary, work with nZ later on */
-								uint_t nU,		/* FIXME: just use these temporary, work with nZ later on */
-								uint_t nV,
+								uint_t nX,		/* number of states */
+								uint_t nU,		/* number of controls */
+								uint_t nXK1,	/* number of states of the next stage (rows of C) */
 								uint_t nD
 								)
 {
 	interval_t* interval = (interval_t*)qpDUNES_calloc( 1,sizeof(interval_t) );
 
+	uint_t nV = nX + nU;
+
 	interval->nD = nD;
 	interval->nV = nV;
+	interval->nX = nX;
+	interval->nU = nU;
 
 	interval->H.data = (real_t*)qpDUNES_calloc( nV*nV,sizeof(real_t) );
 	interval->H.sparsityType = QPDUNES_MATRIX_UNDEFINED;
@@ -228,12 +310,15 @@ interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 
 	interval->q.data  = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
 
-	interval->C.data = (real_t*)qpDUNES_calloc( nX*nV,sizeof(real_t) );
+	interval->C.data = (real_t*)qpDUNES_calloc( nXK1*nV,sizeof(real_t) );
 	interval->C.sparsityType = QPDUNES_MATRIX_UNDEFINED;
-	interval->c.data = (real_t*)qpDUNES_calloc( nX,sizeof(real_t) );
+	interval->c.data = (real_t*)qpDUNES_calloc( nXK1,sizeof(real_t) );
 
 	interval->zLow.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
 	interval->zUpp.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
+	interval->softL1.data = 0;		/* soft bounds are allocated on demand in qpDUNES_setIntervalSoftBounds */
+	interval->softL2.data = 0;
+	interval->scaling.data = 0;		/* allocated in qpDUNES_setupScaling if requested */
 
 	interval->D.data = (real_t*)qpDUNES_calloc(  nD*nV,sizeof(real_t) );
 	interval->D.sparsityType = QPDUNES_MATRIX_UNDEFINED;
@@ -244,15 +329,41 @@ interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 
 	interval->y.data = (real_t*)qpDUNES_calloc( 2*nV + 2*nD,sizeof(real_t) );	/* TODO: clean multiplier definition */
 
+	interval->actSet.nWords = (nV + nD + QPDUNES_ACTSET_CONSTR_PER_WORD - 1) / QPDUNES_ACTSET_CONSTR_PER_WORD;
+	interval->actSet.bits = (actSetWord_t*)qpDUNES_calloc( interval->actSet.nWords,sizeof(actSetWord_t) );
+	interval->actSet.prevBits = (actSetWord_t*)qpDUNES_calloc( interval->actSet.nWords,sizeof(actSetWord_t) );
+	qpDUNES_invalidateActSet( interval );
+
+	interval->dataVersion = 0;
+	interval->projCache.capacity = qpDUNES_max( qpData->options.projCacheSize, 0 );
+	interval->projCache.nEntries = 0;
+	interval->projCache.entrySize = nX*(nX+1)/2 + nXK1*(nXK1+1)/2 + nXK1*nX;
+	interval->projCache.clock = 0;
+	interval->projCache.curEntry = 0;
+	if ( interval->projCache.capacity > 0 ) {
+		interval->projCache.dataVersion = (uint_t*)qpDUNES_calloc( interval->projCache.capacity,sizeof(uint_t) );
+		interval->projCache.lastUse = (uint_t*)qpDUNES_calloc( interval->projCache.capacity,sizeof(uint_t) );
+		interval->projCache.bits = (actSetWord_t*)qpDUNES_calloc( interval->projCache.capacity*interval->actSet.nWords,sizeof(actSetWord_t) );
+		interval->projCache.data = (real_t*)qpDUNES_calloc( interval->projCache.capacity*interval->projCache.entrySize,sizeof(real_t) );
+	}
+	else {
+		interval->projCache.dataVersion = 0;
+		interval->projCache.lastUse = 0;
+		interval->projCache.bits = 0;
+		interval->projCache.data = 0;
+	}
+
 	interval->lambdaK.data = (real_t*)qpDUNES_calloc( nX,sizeof(real_t) );
 	interval->lambdaK.isDefined = QPDUNES_TRUE;							/* define both lambda parts by default */
-	interval->lambdaK1.data = (real_t*)qpDUNES_calloc( nX,sizeof(real_t) );
+	interval->lambdaK1.data = (real_t*)qpDUNES_calloc( nXK1,sizeof(real_t) );
 	interval->lambdaK1.isDefined = QPDUNES_TRUE;
 
 	/* get memory for clipping QP solver */
 	interval->qpSolverClipping.qStep.data  = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
 	interval->qpSolverClipping.zUnconstrained.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
 	interval->qpSolverClipping.dz.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
+	interval->qpSolverClipping.HSoft.data = 0;
+	interval->qpSolverClipping.HSoft.sparsityType = QPDUNES_MATRIX_UNDEFINED;
 
 	/* get memory for qpOASES QP solver */
 	/* TODO: do this only if needed later on in code generated / static memory version */
@@ -264,6 +375,8 @@ interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 
 
 	interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_UNDEFINED;
+	interval->isPrepared = QPDUNES_FALSE;
+	interval->lambdaHasChanged = QPDUNES_TRUE;
 
 	return interval;
 }
@@ -277,7 +390,7 @@ interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 return_t qpDUNES_cleanup(	qpData_t* const qpData
 						)
 {
-	uint_t ii, kk;
+	int_t ii, kk;
 
 	/* free all normal intervals */
 	for( ii=0; ii<_NI_; ++ii )
@@ -310,9 +423,23 @@ return_t qpDUNES_cleanup(	qpData_t* const qpData
 	qpDUNES_free( &(qpData->lambda.data) );
 	qpDUNES_free( &(qpData->deltaLambda.data) );
 	
+	qpDUNES_uintFree( &(qpData->xnOffset) );
+	qpDUNES_uintFree( &(qpData->xn2xOffset) );
+
 	qpDUNES_free( &(qpData->hessian.data) );
-	qpDUNES_free( &(qpData->cholHessian.data) );
+	qpDUNES_facFree( &(qpData->cholHessian.data) );
 	qpDUNES_free( &(qpData->gradient.data) );
+	qpDUNES_free( &(qpData->lsGradient.data) );
+	qpDUNES_free( &(qpData->regShift) );
+	qpDUNES_free( &(qpData->regDirections.data) );
+	qpDUNES_free( &(qpData->nwtnFacFirstChangeFreq) );
+	qpDUNES_free( &(qpData->nwtnFacLastChangeFreq) );
+	qpDUNES_intFree( &(qpData->nwtnBlockUpdateCount) );
+	qpDUNES_free( &(qpData->stageReductionTmp) );
+	qpDUNES_free( &(qpData->lsGridAlpha) );
+	qpDUNES_free( &(qpData->lsGridObjVal) );
+	qpDUNES_free( &(qpData->lsGridStageObjVal) );
+	qpDUNES_free( &(qpData->lsGridTmp) );
 	
 	
 	qpDUNES_free( &(qpData->xVecTmp.data) );
@@ -320,6 +447,10 @@ return_t qpDUNES_cleanup(	qpData_t* const qpData
 	qpDUNES_free( &(qpData->zVecTmp.data) );
 	qpDUNES_free( &(qpData->xnVecTmp.data) );
 	qpDUNES_free( &(qpData->xnVecTmp2.data) );
+	qpDUNES_free( &(qpData->xnVecTmp3.data) );
+	qpDUNES_free( &(qpData->xnVecTmp4.data) );
+	qpDUNES_free( &(qpData->xnVecTmp5.data) );
+	qpDUNES_free( &(qpData->xnVecTmp6.data) );
 	qpDUNES_free( &(qpData->xxMatTmp.data) );
 	qpDUNES_free( &(qpData->xxMatTmp2.data) );
 	qpDUNES_free( &(qpData->xzMatTmp.data) );
@@ -363,30 +494,16 @@ return_t qpDUNES_cleanup(	qpData_t* const qpData
 				qpDUNES_free( &(qpData->log.itLog[ii].y.data) );
 			}
 		}
-
-		/* itLog[0].prevIeqStatus is always allocated */
-		for( kk=0; kk<_NI_+1; ++kk ) {
-			qpDUNES_intFree( &(qpData->log.itLog[0].prevIeqStatus[kk]) );
-		}
-		if ( qpData->log.itLog[0].prevIeqStatus != 0 ) {
-			free( qpData->log.itLog[0].prevIeqStatus );
-		}
-		qpData->log.itLog[0].prevIeqStatus = 0;
 	}
 	else {
 		/* free ieqStatus array */
 		for( kk=0; kk<_NI_+1; ++kk ) {
 			qpDUNES_intFree( &(qpData->log.itLog[0].ieqStatus[kk]) );
-			qpDUNES_intFree( &(qpData->log.itLog[0].prevIeqStatus[kk]) );
 		}
 		if ( qpData->log.itLog[0].ieqStatus != 0 ) {
 			free( qpData->log.itLog[0].ieqStatus );
 		}
 		qpData->log.itLog[0].ieqStatus = 0;
-		if ( qpData->log.itLog[0].prevIeqStatus != 0 ) {
-			free( qpData->log.itLog[0].prevIeqStatus );
-		}
-		qpData->log.itLog[0].prevIeqStatus = 0;
 	}
 
 
@@ -416,12 +533,17 @@ void qpDUNES_freeInterval(	qpData_t* const qpData,
 	qpDUNES_free( &(interval->cholH.data) );
 
 	qpDUNES_free( &(interval->C.data) );
+	qpDUNES_freeSparseStorage( (matrix_t*)&(interval->C) );
 	qpDUNES_free( &(interval->c.data) );
 
 	qpDUNES_free( &(interval->zLow.data) );
 	qpDUNES_free( &(interval->zUpp.data) );
+	qpDUNES_free( &(interval->softL1.data) );
+	qpDUNES_free( &(interval->softL2.data) );
+	qpDUNES_free( &(interval->scaling.data) );
 
 	qpDUNES_free( &(interval->D.data) );
+	qpDUNES_freeSparseStorage( (matrix_t*)&(interval->D) );
 	qpDUNES_free( &(interval->dLow.data) );
 	qpDUNES_free( &(interval->dUpp.data) );
 
@@ -429,6 +551,30 @@ void qpDUNES_freeInterval(	qpData_t* const qpData,
 
 	qpDUNES_free( &(interval->y.data) );
 
+	if ( interval->actSet.bits != 0 ) {
+		free( interval->actSet.bits );
+		interval->actSet.bits = 0;
+	}
+	if ( interval->actSet.prevBits != 0 ) {
+		free( interval->actSet.prevBits );
+		interval->actSet.prevBits = 0;
+	}
+
+	if ( interval->projCache.dataVersion != 0 ) {
+		free( interval->projCache.dataVersion );
+		interval->projCache.dataVersion = 0;
+	}
+	if ( interval->projCache.lastUse != 0 ) {
+		free( interval->projCache.lastUse );
+		interval->projCache.lastUse = 0;
+	}
+	if ( interval->projCache.bits != 0 ) {
+		free( interval->projCache.bits );
+		interval->projCache.bits = 0;
+	}
+	qpDUNES_free( &(interval->projCache.data) );
+	interval->projCache.nEntries = 0;
+
 	qpDUNES_free( &(interval->lambdaK.data) );
 	qpDUNES_free( &(interval->lambdaK1.data) );
 
@@ -436,6 +582,7 @@ void qpDUNES_freeInterval(	qpData_t* const qpData,
 	qpDUNES_free( &(interval->qpSolverClipping.qStep.data) );
 	qpDUNES_free( &(interval->qpSolverClipping.zUnconstrained.data) );
 	qpDUNES_free( &(interval->qpSolverClipping.dz.data) );
+	qpDUNES_free( &(interval->qpSolverClipping.HSoft.data) );
 
 
 	#ifndef __SIMPLE_BOUNDS_ONLY__
@@ -453,19 +600,42 @@ void qpDUNES_freeInterval(	qpData_t* const qpData,
 void qpDUNES_indicateDataChange(	qpData_t* const qpData
 									)
 {
-	int_t kk, ii;
+	int_t kk;
 
-	/* initialize prevIeqStatus to safe values when data was changed to force Hessian refactorization */
+	/* invalidate active sets of last Hessian setup when data was changed to force Hessian refactorization */
 	for( kk=0; kk<_NI_+1; ++kk ) {
-		for( ii=0; ii<_ND(kk)+_NV(kk); ++ii ) {
-			qpData->log.itLog[0].prevIeqStatus[kk][ii] = -42;			/* some safe dummy value */
-		}
+		qpDUNES_invalidateActSet( qpData->intervals[kk] );
 	}
 }
 /*<<< END OF qpDUNES_indicateDataChange */
 
 
 
+/* ----------------------------------------------
+ * mark the active set of the last Newton Hessian setup as unknown;
+ * every constraint of the stage then compares as changed
+ *
+#>>>>>>                                           */
+void qpDUNES_invalidateActSet(	interval_t* const interval
+								)
+{
+	int_t ii;
+	int_t nConstr = interval->nV + interval->nD;
+	int_t nRem = nConstr % QPDUNES_ACTSET_CONSTR_PER_WORD;
+
+	for( ii=0; ii<nConstr/QPDUNES_ACTSET_CONSTR_PER_WORD; ++ii ) {
+		interval->actSet.prevBits[ii] = ~((actSetWord_t)0);
+	}
+	/* keep padding bits of last word clear */
+	if ( nRem != 0 ) {
+		interval->actSet.prevBits[interval->actSet.nWords-1] = ( ((actSetWord_t)1) << (2*nRem) ) - 1;
+	}
+	interval->actSet.prevBitsAreValid = QPDUNES_FALSE;
+}
+/*<<< END OF qpDUNES_invalidateActSet */
+
+
+
 /* ----------------------------------------------
  *
  >>>>>>                                           */
@@ -480,10 +650,39 @@ return_t qpDUNES_init(	qpData_t* const qpData,
 						const real_t* const dLow_,
 						const real_t* const dUpp_
 						)
+{
+	return qpDUNES_initWithStorageOrder( qpData, H_, g_, C_, c_, zLow_, zUpp_, D_, dLow_, dUpp_, QPDUNES_ROW_MAJOR );
+}
+/*<<< END OF qpDUNES_init */
+
+
+
+/* ----------------------------------------------
+ * set up all intervals from matrix data in the
+ * given storage order (row- or column-major)
+ *
+ >>>>>>                                           */
+return_t qpDUNES_initWithStorageOrder(	qpData_t* const qpData,
+										const real_t* const H_,
+										const real_t* const g_,
+										const real_t* const C_,
+										const real_t* const c_,
+										const real_t* const zLow_,
+										const real_t* const zUpp_,
+										const real_t* const D_,
+										const real_t* const dLow_,
+										const real_t* const dUpp_,
+										storageOrder_t storageOrder
+										)
 {
 	int_t kk;
 
+	/* offsets of the stage data in the stacked arrays; stages may differ in size */
 	int_t nDoffset = 0;
+	int_t nZoffset = 0;
+	int_t nHoffset = 0;
+	int_t nCoffset = 0;
+	int_t nDZoffset = 0;
 
 	boolean_t isLTI = QPDUNES_FALSE;	/* todo: auto-detect, or specify through interface! */
 
@@ -492,17 +691,27 @@ return_t qpDUNES_init(	qpData_t* const qpData,
 	for( kk=0; kk<_NI_; ++kk )
 	{
 		qpDUNES_setupRegularInterval( qpData, qpData->intervals[kk],
-								   offsetArray(H_, kk*_NZ_*_NZ_), 0, 0, 0, offsetArray(g_, kk*_NZ_),
-								   offsetArray(C_, kk*_NX_*_NZ_), 0, 0, offsetArray(c_, kk*_NX_),
-								   offsetArray(zLow_, kk*_NZ_), offsetArray(zUpp_, kk*_NZ_), 0, 0, 0, 0,
-								   offsetArray(D_, nDoffset*_NZ_), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset) );
-		nDoffset += qpData->intervals[kk]->nD;
+								   offsetArray(H_, nHoffset), 0, 0, 0, offsetArray(g_, nZoffset),
+								   offsetArray(C_, nCoffset), 0, 0, offsetArray(c_, _XNOFF(kk)),
+								   offsetArray(zLow_, nZoffset), offsetArray(zUpp_, nZoffset), 0, 0, 0, 0,
+								   offsetArray(D_, nDZoffset), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset),
+								   storageOrder );
+		nDoffset += _ND(kk);
+		nZoffset += _NV(kk);
+		nHoffset += _NV(kk)*_NV(kk);
+		nCoffset += _NX(kk+1)*_NV(kk);
+		nDZoffset += _ND(kk)*_NV(kk);
 	}
 	/** set up final interval */
 	qpDUNES_setupFinalInterval( qpData, qpData->intervals[_NI_],
-							 offsetArray(H_, _NI_*_NZ_*_NZ_), offsetArray(g_, _NI_*_NZ_),
-							 offsetArray(zLow_, _NI_*_NZ_), offsetArray(zUpp_, _NI_*_NZ_),
-							 offsetArray(D_, nDoffset*_NZ_), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset) );
+							 offsetArray(H_, nHoffset), offsetArray(g_, nZoffset),
+							 offsetArray(zLow_, nZoffset), offsetArray(zUpp_, nZoffset),
+							 offsetArray(D_, nDZoffset), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset),
+							 storageOrder );
+
+
+	/** equilibrate stage data if requested */
+	qpDUNES_setupScaling( qpData );
 
 
 	/** determine local QP solvers and set up auxiliary data */
@@ -515,7 +724,7 @@ return_t qpDUNES_init(	qpData_t* const qpData,
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_init */
+/*<<< END OF qpDUNES_initWithStorageOrder */
 
 
 
@@ -533,29 +742,62 @@ return_t qpDUNES_updateData(	qpData_t* const qpData,
 								const real_t* const dLow_,
 								const real_t* const dUpp_
 								)
+{
+	return qpDUNES_updateDataWithStorageOrder( qpData, H_, g_, C_, c_, zLow_, zUpp_, D_, dLow_, dUpp_, QPDUNES_ROW_MAJOR );
+}
+/*<<< END OF qpDUNES_updateData */
+
+
+
+/* ----------------------------------------------
+ * update all intervals from matrix data in the
+ * given storage order (row- or column-major)
+ *
+ >>>>>>                                           */
+return_t qpDUNES_updateDataWithStorageOrder(	qpData_t* const qpData,
+												const real_t* const H_,
+												const real_t* const g_,
+												const real_t* const C_,
+												const real_t* const c_,
+												const real_t* const zLow_,
+												const real_t* const zUpp_,
+												const real_t* const D_,
+												const real_t* const dLow_,
+												const real_t* const dUpp_,
+												storageOrder_t storageOrder
+												)
 {
 	int_t kk;
 
+	/* offsets of the stage data in the stacked arrays; stages may differ in size */
 	int_t nDoffset = 0;
+	int_t nZoffset = 0;
+	int_t nHoffset = 0;
+	int_t nCoffset = 0;
+	int_t nDZoffset = 0;
 
 	/** setup regular intervals */
 	for( kk=0; kk<_NI_; ++kk )
 	{
 		qpDUNES_updateIntervalData( qpData, qpData->intervals[kk],
-									 offsetArray(H_, kk*_NZ_*_NZ_), offsetArray(g_, kk*_NZ_),
-									 offsetArray(C_, kk*_NX_*_NZ_), offsetArray(c_, kk*_NX_),
-									 offsetArray(zLow_, kk*_NZ_), offsetArray(zUpp_, kk*_NZ_),
-									 offsetArray(D_, nDoffset*_NZ_), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset),
-									 0 );
-		nDoffset += qpData->intervals[kk]->nD;
+									 offsetArray(H_, nHoffset), offsetArray(g_, nZoffset),
+									 offsetArray(C_, nCoffset), offsetArray(c_, _XNOFF(kk)),
+									 offsetArray(zLow_, nZoffset), offsetArray(zUpp_, nZoffset),
+									 offsetArray(D_, nDZoffset), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset),
+									 0, storageOrder );
+		nDoffset += _ND(kk);
+		nZoffset += _NV(kk);
+		nHoffset += _NV(kk)*_NV(kk);
+		nCoffset += _NX(kk+1)*_NV(kk);
+		nDZoffset += _ND(kk)*_NV(kk);
 	}
 	/** set up final interval */
 	qpDUNES_updateIntervalData( qpData, qpData->intervals[_NI_],
-							 offsetArray(H_, _NI_*_NZ_*_NZ_), offsetArray(g_, _NI_*_NZ_),
+							 offsetArray(H_, nHoffset), offsetArray(g_, nZoffset),
 							 0, 0,
-							 offsetArray(zLow_, _NI_*_NZ_), offsetArray(zUpp_, _NI_*_NZ_),
-							 offsetArray(D_, nDoffset*_NZ_), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset),
-							 0 );
+							 offsetArray(zLow_, nZoffset), offsetArray(zUpp_, nZoffset),
+							 offsetArray(D_, nDZoffset), offsetArray(dLow_, nDoffset), offsetArray(dUpp_, nDoffset),
+							 0, storageOrder );
 
 	/* reset current active set to force Hessian refactorization
 	 * (needed if matrix data entering the Newton Hessian has changed) */
@@ -565,7 +807,7 @@ return_t qpDUNES_updateData(	qpData_t* const qpData,
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_updateData */
+/*<<< END OF qpDUNES_updateDataWithStorageOrder */
 
 
 
@@ -584,10 +826,10 @@ return_t qpDUNES_setupSimpleBoundedInterval(	qpData_t* const qpData,
 											)
 {
 	if ( R != 0 ) {
-		return qpDUNES_setupRegularInterval( qpData, interval, 0, Q, R, S, 0, 0, A, B, c, 0, 0, xLow, xUpp, uLow, uUpp, 0, 0, 0 );
+		return qpDUNES_setupRegularInterval( qpData, interval, 0, Q, R, S, 0, 0, A, B, c, 0, 0, xLow, xUpp, uLow, uUpp, 0, 0, 0, QPDUNES_ROW_MAJOR );
 	}
 	else {	/* final interval */
-		return qpDUNES_setupFinalInterval( qpData, interval, Q, 0, xLow, xUpp, 0, 0, 0 );
+		return qpDUNES_setupFinalInterval( qpData, interval, Q, 0, xLow, xUpp, 0, 0, 0, QPDUNES_ROW_MAJOR );
 	}
 }
 
@@ -615,71 +857,77 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 									const real_t* const uUpp_,
 									const real_t* const D_,
 									const real_t* const dLow_,
-									const real_t* const dUpp_
+									const real_t* const dUpp_,
+									storageOrder_t storageOrder
 									)
 {
 	int_t ii, jj;
 	
 	int_t nD = interval->nD;	/* TODO: enable ND static for full static memory!*/
 	int_t nV = interval->nV;
+	int_t nX = interval->nX;
+	int_t nU = interval->nU;
+	int_t nXK1 = _NX( interval->id+1 );	/* number of states of the next stage, i.e., rows of C */
 
 	vv_matrix_t* H = &(interval->H);
 	xz_matrix_t* C = &(interval->C);
 	
 	sparsityType_t sparsityQ;
 	sparsityType_t sparsityR;
+	boolean_t detectSparsityC = QPDUNES_FALSE;
 
 	/** (1) quadratic term of cost function */
 	if ( H_ != 0 ) {	/* Hessian given directly */
 		if (H->sparsityType == QPDUNES_MATRIX_UNDEFINED) {
-			H->sparsityType = qpDUNES_detectMatrixSparsity( H_, _NZ_, _NZ_ );
+			/* Hessians are only handled as diagonal or dense, never compressed */
+			H->sparsityType = qpDUNES_detectMatrixSparsity( H_, nV, nV, qpData->options.matrixZeroTolerance, 0. );
 		}
-		qpDUNES_updateMatrixData( (matrix_t*)H, H_, _NZ_, _NZ_ );
+		qpDUNES_updateMatrixData( (matrix_t*)H, H_, nV, nV, storageOrder );
 	}
 	else {	/* assemble Hessian */
 		/* TODO: move Q, R out to MPC module */
 		/* detect sparsity of Q, R */
-		sparsityQ =  (Q_ != 0) ? qpDUNES_detectMatrixSparsity( Q_, _NX_, _NX_ ) : QPDUNES_IDENTITY;
-		sparsityR =  (R_ != 0) ? qpDUNES_detectMatrixSparsity( R_, _NU_, _NU_ ) : QPDUNES_IDENTITY;
+		sparsityQ =  (Q_ != 0) ? qpDUNES_detectMatrixSparsity( Q_, nX, nX, qpData->options.matrixZeroTolerance, 0. ) : QPDUNES_IDENTITY;
+		sparsityR =  (R_ != 0) ? qpDUNES_detectMatrixSparsity( R_, nU, nU, qpData->options.matrixZeroTolerance, 0. ) : QPDUNES_IDENTITY;
 
 		if ( S_ != 0 ) {	/* assemble full (dense) Hessian */
 			H->sparsityType = QPDUNES_DENSE;
 			/* Hessian written completely; TODO: check if one triangular half Hessian would be sufficient */
-			for ( ii=0; ii<_NX_; ++ii ) {
+			for ( ii=0; ii<nX; ++ii ) {
 				if ( Q_ != 0 ) {			/* Q part */
-					for( jj=0; jj<_NX_; ++jj ) {
-						accH( ii,jj ) = Q_[ii*_NX_+jj];
+					for( jj=0; jj<nX; ++jj ) {
+						accH( ii,jj ) = accInput( Q_, ii, jj, nX, nX );
 					}
 				}
 				else {
 					accH( ii,ii ) = qpData->options.regParam;
 				}
-				for( jj=0; jj<_NU_; ++jj ) {	/* S part */
-					accH( ii,_NX_+jj ) = S_[ii*_NU_+jj];
+				for( jj=0; jj<nU; ++jj ) {	/* S part */
+					accH( ii,nX+jj ) = accInput( S_, ii, jj, nX, nU );
 				}
 			}
-			for ( ii=0; ii<_NU_; ++ii ) {
-				for( jj=0; jj<_NX_; ++jj ) {	/* S^T part */
-					accH( _NX_+ii,jj ) = S_[jj*_NX_+ii];
+			for ( ii=0; ii<nU; ++ii ) {
+				for( jj=0; jj<nX; ++jj ) {	/* S^T part */
+					accH( nX+ii,jj ) = accInput( S_, jj, ii, nX, nU );
 				}
 				if ( R_ != 0 ) {			/* R part */
-					for( jj=0; jj<_NU_; ++jj ) {
-						accH( _NX_+ii,_NX_+jj ) = R_[ii*_NU_+jj];
+					for( jj=0; jj<nU; ++jj ) {
+						accH( nX+ii,nX+jj ) = accInput( R_, ii, jj, nU, nU );
 					}
 				}
 				else {
-					accH( _NX_+ii,_NX_+ii ) = qpData->options.regParam;
+					accH( nX+ii,nX+ii ) = qpData->options.regParam;
 				}
 			}
 		}
 		else {	/* write Hessian blocks */
 			if ( (sparsityQ == QPDUNES_DENSE) || (sparsityR == QPDUNES_DENSE) ) {
 				H->sparsityType = QPDUNES_DENSE;
-				for ( ii=0; ii<_NX_; ++ii ) {
+				for ( ii=0; ii<nX; ++ii ) {
 					/* Q part */
 					if ( Q_ != 0 ) {
-						for( jj=0; jj<_NX_; ++jj ) {
-							accH( ii,jj ) = Q_[ii*_NX_+jj];
+						for( jj=0; jj<nX; ++jj ) {
+							accH( ii,jj ) = accInput( Q_, ii, jj, nX, nX );
 						}
 					}
 					else {
@@ -687,33 +935,33 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 							accH( ii,jj ) = 0.;
 						}
 						accH( ii,ii ) = qpData->options.regParam;
-						for( jj=ii+1; jj<_NX_; ++jj ) {
+						for( jj=ii+1; jj<nX; ++jj ) {
 							accH( ii,jj ) = 0.;
 						}
 					}
 					/* S part */
-					for( jj=_NX_; jj<_NZ_; ++jj ) {
+					for( jj=nX; jj<nV; ++jj ) {
 						accH( ii,jj ) = 0.;
 					}
 				}
-				for ( ii=0; ii<_NU_; ++ii ) {
+				for ( ii=0; ii<nU; ++ii ) {
 					/* S^T part */
-					for( jj=0; jj<_NX_; ++jj ) {
-						accH( _NX_+ii,jj ) = 0.;
+					for( jj=0; jj<nX; ++jj ) {
+						accH( nX+ii,jj ) = 0.;
 					}
 					/* R part */
 					if ( R_ != 0 ) {
-						for( jj=0; jj<_NU_; ++jj ) {
-							accH( _NX_+ii,_NX_+jj ) = R_[ii*_NU_+jj];
+						for( jj=0; jj<nU; ++jj ) {
+							accH( nX+ii,nX+jj ) = accInput( R_, ii, jj, nU, nU );
 						}
 					}
 					else {
 						for( jj=0; jj<ii; ++jj ) {
-							accH( _NX_+ii,_NX_+jj ) = 0.;
+							accH( nX+ii,nX+jj ) = 0.;
 						}
-						accH( _NX_+ii,_NX_+ii ) = qpData->options.regParam;
-						for( jj=ii+1; jj<_NX_; ++jj ) {
-							accH( _NX_+ii,_NX_+jj ) = 0.;
+						accH( nX+ii,nX+ii ) = qpData->options.regParam;
+						for( jj=ii+1; jj<nX; ++jj ) {
+							accH( nX+ii,nX+jj ) = 0.;
 						}
 					}
 				}
@@ -728,24 +976,24 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 					/* write diagonal in first line for cache efficiency */
 					/* Q part */
 					if (sparsityQ == QPDUNES_IDENTITY) {
-						for( ii=0; ii<_NX_; ++ii) {
+						for( ii=0; ii<nX; ++ii) {
 							accH( 0,ii ) = 1.;
 						}
 					}
 					else {
-						for( ii=0; ii<_NX_; ++ii) {
-							accH( 0,ii ) = Q_[ii*_NX_+ii];
+						for( ii=0; ii<nX; ++ii) {
+							accH( 0,ii ) = Q_[ii*nX+ii];
 						}
 					}
 					/* R part */
 					if (sparsityR == QPDUNES_IDENTITY) {
-						for( ii=0; ii<_NU_; ++ii) {
-							accH( 0,_NX_+ii ) = 1.;
+						for( ii=0; ii<nU; ++ii) {
+							accH( 0,nX+ii ) = 1.;
 						}
 					}
 					else {
-						for( ii=0; ii<_NU_; ++ii) {
-							accH( 0,_NX_+ii ) = R_[ii*_NU_+ii];
+						for( ii=0; ii<nU; ++ii) {
+							accH( 0,nX+ii ) = R_[ii*nU+ii];
 						}
 					}
 				}
@@ -771,21 +1019,22 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 	/** (3) dynamic system */
 	if (C->sparsityType == QPDUNES_MATRIX_UNDEFINED) {
 		C->sparsityType = QPDUNES_DENSE;
+		detectSparsityC = QPDUNES_TRUE;
 	}
 	if ( C_ != 0 ) {
 		/* set up C directly */
-		qpDUNES_updateMatrixData( (matrix_t*)C, C_, _NX_, _NZ_ );
+		qpDUNES_updateMatrixData( (matrix_t*)C, C_, nXK1, nV, storageOrder );
 	}
 	else {
 		/* TODO: move assembly out to MPC interface */
 		if ( (A_ != 0) && (B_ != 0) ) {
 			/* build up C */
-			for ( ii=0; ii<_NX_; ++ii ) {
-				for( jj=0; jj<_NX_; ++jj ) {
-					accC( ii, jj ) = A_[ii*_NX_+jj];
+			for ( ii=0; ii<nXK1; ++ii ) {
+				for( jj=0; jj<nX; ++jj ) {
+					accC( ii, jj ) = accInput( A_, ii, jj, nXK1, nX );
 				}
-				for( jj=0; jj<_NU_; ++jj ) {
-					accC( ii, _NX_+jj ) = B_[ii*_NU_+jj];
+				for( jj=0; jj<nU; ++jj ) {
+					accC( ii, nX+jj ) = accInput( B_, ii, jj, nXK1, nU );
 				}
 			}
 		}
@@ -794,29 +1043,42 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 			return QPDUNES_ERR_INVALID_ARGUMENT;
 		}
 	}
+	if ( detectSparsityC == QPDUNES_TRUE ) {
+		/* C is kept in general form; only choose between dense and compressed storage */
+		if ( qpDUNES_detectMatrixSparsity( C->data, nXK1, nV, qpData->options.matrixZeroTolerance, qpData->options.sparseDensityThreshold ) == QPDUNES_SPARSE ) {
+			C->sparsityType = QPDUNES_SPARSE;
+		}
+	}
+	qpDUNES_updateSparseStorage( (matrix_t*)C, nXK1, nV );
+	if ( nXK1 == nX ) {
+		qpDUNES_detectMatrixStructure( &(C->structure), C->data, nX, nV );
+	}
+	else {	/* structure of the A part is only exploited for square A */
+		C->structure.type = QPDUNES_STRUCTURE_GENERAL;
+	}
 	
 	if ( c_ != 0 ) {
-		qpDUNES_setupVector( (vector_t*)&(interval->c), c_, _NX_ );
+		qpDUNES_setupVector( (vector_t*)&(interval->c), c_, nXK1 );
 	}
 	else {
-		qpDUNES_setupZeroVector( (vector_t*)&(interval->c), _NX_ );
+		qpDUNES_setupZeroVector( (vector_t*)&(interval->c), nXK1 );
 	}
 	
 	
 	/** (4) bounds */
 	qpDUNES_setupUniformVector( (vector_t*)&(interval->zLow), -qpData->options.QPDUNES_INFTY, nV );
-	qpDUNES_updateSimpleBoundVector( qpData, (vector_t*)&(interval->zLow), zLow_, xLow_, uLow_ );
+	qpDUNES_updateSimpleBoundVector( (vector_t*)&(interval->zLow), zLow_, xLow_, uLow_, nX, nU );
 	qpDUNES_setupUniformVector( (vector_t*)&(interval->zUpp), qpData->options.QPDUNES_INFTY, nV );
-	qpDUNES_updateSimpleBoundVector( qpData, (vector_t*)&(interval->zUpp), zUpp_, xUpp_, uUpp_ );
+	qpDUNES_updateSimpleBoundVector( (vector_t*)&(interval->zUpp), zUpp_, xUpp_, uUpp_, nX, nU );
 
 
 	/** (5) constraints */
 	/*  - Matrix */
 	if ( D_ != 0 ) {	/* generically bounded QP */
 		if (interval->D.sparsityType == QPDUNES_MATRIX_UNDEFINED) {
-			interval->D.sparsityType = qpDUNES_detectMatrixSparsity( D_, nD, _NZ_ );
+			interval->D.sparsityType = qpDUNES_detectMatrixSparsity( D_, nD, nV, qpData->options.matrixZeroTolerance, qpData->options.sparseDensityThreshold );
 		}
-		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, _NZ_ );
+		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, nV, storageOrder );
 
 	}
 	else {	/* simply bounded QP */
@@ -846,7 +1108,8 @@ return_t qpDUNES_setupFinalInterval(	qpData_t* const qpData,
 									const real_t* const zUpp_,
 									const real_t* const D_,
 									const real_t* const dLow_,
-									const real_t* const dUpp_
+									const real_t* const dUpp_,
+									storageOrder_t storageOrder
 									)
 {
 	int_t nV = interval->nV;
@@ -857,11 +1120,11 @@ return_t qpDUNES_setupFinalInterval(	qpData_t* const qpData,
 
 	/** (1) quadratic term of cost function */
  	if ( H_ != 0 ) {	/* H given */
- 		H->sparsityType = qpDUNES_detectMatrixSparsity( H_, nV, nV );
- 		qpDUNES_updateMatrixData( (matrix_t*)H, H_, nV, nV );
+ 		H->sparsityType = qpDUNES_detectMatrixSparsity( H_, nV, nV, qpData->options.matrixZeroTolerance, 0. );
+ 		qpDUNES_updateMatrixData( (matrix_t*)H, H_, nV, nV, storageOrder );
  	}
 	else {
-		qpDUNES_setupScaledIdentityMatrix( _NX_, qpData->options.regParam, (matrix_t*)H );
+		qpDUNES_setupScaledIdentityMatrix( nV, qpData->options.regParam, (matrix_t*)H );
 	}
 
 
@@ -884,9 +1147,9 @@ return_t qpDUNES_setupFinalInterval(	qpData_t* const qpData,
 	/** (4) local constraints */
 	if ( D_ != 0 ) {	/* generically bounded QP */
 		if (interval->D.sparsityType == QPDUNES_MATRIX_UNDEFINED) {
-			interval->D.sparsityType = qpDUNES_detectMatrixSparsity( D_, nD, nV );
+			interval->D.sparsityType = qpDUNES_detectMatrixSparsity( D_, nD, nV, qpData->options.matrixZeroTolerance, qpData->options.sparseDensityThreshold );
 		}
-		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, nV );
+		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, nV, storageOrder );
 	}
 	else {	/* simply bounded QP */
 		qpDUNES_setMatrixNull( (matrix_t*)&(interval->D) );
@@ -917,42 +1180,60 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 										const real_t* const D_,
 										const real_t* const dLow_,
 										const real_t* const dUpp_,
-										vv_matrix_t* const cholH
+										vv_matrix_t* const cholH,
+										storageOrder_t storageOrder
 										)
 {
 	int_t nD = interval->nD;
 
 
 	int_t nV = interval->nV;
+	int_t nXK1;
 
 	boolean_t refactorHessian;
 
 
 	/** copy data */
-	qpDUNES_updateMatrixData( (matrix_t*)&(interval->H), H_, nV, nV );
+	qpDUNES_updateMatrixData( (matrix_t*)&(interval->H), H_, nV, nV, storageOrder );
 	qpDUNES_updateVector( (vector_t*)&(interval->g), g_, nV );
 
-	qpDUNES_updateMatrixData( (matrix_t*)&(interval->C), C_, _NX_, _NZ_ );
-	qpDUNES_updateVector( (vector_t*)&(interval->c), c_, _NX_ );
+	if ( C_ != 0 ) {	/* C and c are only defined on regular intervals */
+		nXK1 = _NX( interval->id+1 );
+		qpDUNES_updateMatrixData( (matrix_t*)&(interval->C), C_, nXK1, nV, storageOrder );
+		if ( nXK1 == (int_t)interval->nX ) {	/* new data may fill structural zeros */
+			qpDUNES_detectMatrixStructure( &(interval->C.structure), interval->C.data, nXK1, nV );
+		}
+	}
+	if ( c_ != 0 ) {
+		qpDUNES_updateVector( (vector_t*)&(interval->c), c_, _NX( interval->id+1 ) );
+	}
 
 	qpDUNES_updateVector( (vector_t*)&(interval->zLow), zLow_, nV );
 	qpDUNES_updateVector( (vector_t*)&(interval->zUpp), zUpp_, nV );
 
 	/* generically bounded QP */
 	if ( D_ != 0 ) {
-		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, nV );
+		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, nV, storageOrder );
 	}
 	qpDUNES_updateVector( (vector_t*)&(interval->dLow), dLow_, nD );
 	qpDUNES_updateVector( (vector_t*)&(interval->dUpp), dUpp_, nD );
 
+	/* new data is given in unscaled variables */
+	qpDUNES_scaleIntervalData( qpData, interval, H_, g_, C_, c_, zLow_, zUpp_, D_ );
+
+	/* cached Newton Hessian contributions and blocks refer to the old matrices */
+	if ( (H_ != 0) || (C_ != 0) || (D_ != 0) ) {
+		qpDUNES_invalidateActSet( interval );
+		++interval->dataVersion;
+	}
 
 	/** re-factorize Hessian for direct QP solver if needed */
 	/** re-run stage QP setup if objective and/or matrices changed */
-	if ( (H_ != 0) || (g_ != 0) || (D_ != 0) ) 	/* matrices and/or QP objective were changed */
+	if ( (H_ != 0) || (g_ != 0) || (C_ != 0) || (c_ != 0) || (D_ != 0) ) 	/* matrices and/or QP objective were changed */
 	{
 		refactorHessian = QPDUNES_FALSE;
 		if (H_ != 0) {			/* updated H */
-			if (cholH != 0) {	/* factorization provided */
+			if ( (cholH != 0) && (interval->scaling.data == 0) ) {	/* factorization provided (of the unscaled Hessian) */
 				qpDUNES_copyMatrix( (matrix_t*)&(interval->cholH), (matrix_t*)cholH, nV, nV );
 			}
 		else {					/* no factorization provided */
@@ -969,6 +1250,387 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 /*<<< END OF qpDUNES_updateIntervalData */
 
 
+/* ----------------------------------------------
+ * soft variable bounds on one interval; a violation v of either
+ * bound is penalized by softL1*v + 0.5*softL2*v^2, coordinates with
+ * both weights zero keep hard bounds; passing two null pointers
+ * makes all bounds of the interval hard again
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setIntervalSoftBounds(	qpData_t* const qpData,
+										interval_t* interval,
+										const real_t* const softL1_,
+										const real_t* const softL2_
+										)
+{
+	int_t ii;
+	int_t nV = interval->nV;
+
+	if ( interval->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_QPOASES ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Soft bounds are only supported by the clipping stage QP solver (interval %d).", interval->id );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	if ( (softL1_ == 0) && (softL2_ == 0) ) {
+		qpDUNES_free( &(interval->softL1.data) );
+		qpDUNES_free( &(interval->softL2.data) );
+		qpDUNES_free( &(interval->qpSolverClipping.HSoft.data) );
+		qpDUNES_invalidateActSet( interval );	/* previous active set may still hold penalized variables */
+		++interval->dataVersion;
+		return QPDUNES_OK;
+	}
+
+	for ( ii=0; ii<nV; ++ii ) {
+		if ( ( (softL1_ != 0) && (softL1_[ii] < 0.) ) || ( (softL2_ != 0) && (softL2_[ii] < 0.) ) ) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Negative soft bound weight on interval %d, variable %d.", interval->id, ii );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+	}
+
+	if ( interval->softL1.data == 0 ) {
+		interval->softL1.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
+		interval->softL2.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
+		interval->qpSolverClipping.HSoft.data = (real_t*)qpDUNES_calloc( nV,sizeof(real_t) );
+		interval->qpSolverClipping.HSoft.sparsityType = QPDUNES_DIAGONAL;
+	}
+
+	/* a null pointer sets the respective weights to zero */
+	qpDUNES_setupZeroVector( (vector_t*)&(interval->softL1), nV );
+	qpDUNES_setupZeroVector( (vector_t*)&(interval->softL2), nV );
+	qpDUNES_updateVector( (vector_t*)&(interval->softL1), softL1_, nV );
+	qpDUNES_updateVector( (vector_t*)&(interval->softL2), softL2_, nV );
+	qpDUNES_scaleSoftBounds( interval, QPDUNES_FALSE );
+
+	/* soft weights enter the Newton Hessian blocks */
+	qpDUNES_invalidateActSet( interval );
+	++interval->dataVersion;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_setIntervalSoftBounds */
+
+
+/* ----------------------------------------------
+ * soft variable bounds on all intervals; weights are
+ * concatenated over stages like the bounds themselves
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setSoftBounds(	qpData_t* const qpData,
+								const real_t* const softL1,
+								const real_t* const softL2
+								)
+{
+	int_t kk;
+	int_t nZoffset = 0;
+
+	return_t statusFlag;
+
+	for ( kk=0; kk<_NI_+1; ++kk ) {
+		statusFlag = qpDUNES_setIntervalSoftBounds( qpData, qpData->intervals[kk],
+													 offsetArray(softL1, nZoffset),
+													 offsetArray(softL2, nZoffset) );
+		if ( statusFlag != QPDUNES_OK ) {
+			return statusFlag;
+		}
+		nZoffset += qpData->intervals[kk]->nV;
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_setSoftBounds */
+
+
+/* ----------------------------------------------
+ * Ruiz equilibration of the stage data; every variable gets a
+ * factor, z = scaling .* zScaled, and the coupling rows are scaled
+ * by the inverse factors of the states they define, so the
+ * coupling structure C_k*z_k + c_k = x_{k+1} is preserved; the
+ * factors are fixed here and reused by qpDUNES_updateIntervalData
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setupScaling(	qpData_t* const qpData
+								)
+{
+	int_t ii, jj, kk, it;
+	int_t nV, nX, nXK1;
+
+	interval_t* interval;
+	real_t* s;
+	real_t* sK1;
+	real_t* colNorm;
+	real_t* rowNorm;
+	real_t val, cn, rn;
+
+	boolean_t shareFactors = qpData->hasUniformDims;	/* keeps the LTI structure of the stage data */
+
+
+	/** (1) stored soft weights and multipliers refer to an old scaling */
+	if ( qpData->intervals[0]->scaling.data != 0 ) {
+		for( kk=0; kk<_NI_+1; ++kk ) {
+			qpDUNES_scaleSoftBounds( qpData->intervals[kk], QPDUNES_TRUE );
+		}
+		qpDUNES_scaleLambda( qpData, &(qpData->lambda), QPDUNES_TRUE );
+	}
+	if ( qpData->options.maxNumScalingIterations <= 0 ) {
+		for( kk=0; kk<_NI_+1; ++kk ) {
+			qpDUNES_free( &(qpData->intervals[kk]->scaling.data) );
+		}
+		return QPDUNES_OK;
+	}
+	for( kk=0; kk<_NI_+1; ++kk ) {
+		interval = qpData->intervals[kk];
+		if ( interval->scaling.data == 0 ) {
+			interval->scaling.data = (real_t*)qpDUNES_calloc( interval->nV,sizeof(real_t) );
+		}
+		qpDUNES_setupUniformVector( (vector_t*)&(interval->scaling), 1., interval->nV );
+	}
+
+
+	/** (2) equilibration sweeps on the unscaled data */
+	for( it=0; it<qpData->options.maxNumScalingIterations; ++it )
+	{
+		/* (a) infinity norms of the columns and coupling rows under the current scaling;
+		 *     the -I entries of the coupling contribute 1 to state rows and columns */
+		for( kk=0; kk<_NI_+1; ++kk ) {
+			interval = qpData->intervals[kk];
+			nV = interval->nV;
+			nX = interval->nX;
+			s = interval->scaling.data;
+			colNorm = interval->zVecTmp.data;
+
+			for( jj=0; jj<nV; ++jj ) {
+				colNorm[jj] = ( (kk > 0) && (jj < nX) ) ? 1. : 0.;
+			}
+			switch ( interval->H.sparsityType ) {
+				case QPDUNES_IDENTITY:
+				case QPDUNES_DIAGONAL:
+					for( jj=0; jj<nV; ++jj ) {
+						val = ( interval->H.sparsityType == QPDUNES_IDENTITY ) ? 1. : interval->H.data[jj];
+						colNorm[jj] = qpDUNES_fmax( colNorm[jj], fabs( val ) * s[jj] * s[jj] );
+					}
+					break;
+				default:
+					for( ii=0; ii<nV; ++ii ) {
+						for( jj=0; jj<nV; ++jj ) {
+							colNorm[jj] = qpDUNES_fmax( colNorm[jj], fabs( interval->H.data[ii*nV+jj] ) * s[ii] * s[jj] );
+						}
+					}
+					break;
+			}
+			if ( ( interval->D.sparsityType == QPDUNES_DENSE ) || ( interval->D.sparsityType == QPDUNES_SPARSE ) ) {
+				for( ii=0; ii<(int_t)interval->nD; ++ii ) {
+					for( jj=0; jj<nV; ++jj ) {
+						colNorm[jj] = qpDUNES_fmax( colNorm[jj], fabs( interval->D.data[ii*nV+jj] ) * s[jj] );
+					}
+				}
+			}
+			if ( kk < _NI_ ) {
+				nXK1 = _NX(kk+1);
+				sK1 = qpData->intervals[kk+1]->scaling.data;
+				rowNorm = qpData->intervals[kk+1]->xVecTmp.data;
+				for( ii=0; ii<nXK1; ++ii ) {
+					rowNorm[ii] = 1.;
+					for( jj=0; jj<nV; ++jj ) {
+						val = fabs( interval->C.data[ii*nV+jj] ) * s[jj] / sK1[ii];
+						colNorm[jj] = qpDUNES_fmax( colNorm[jj], val );
+						rowNorm[ii] = qpDUNES_fmax( rowNorm[ii], val );
+					}
+				}
+			}
+		}
+
+		/* (b) common factors over all stages for uniform dimensions */
+		if ( shareFactors == QPDUNES_TRUE ) {
+			for( jj=0; jj<(int_t)_NZ_; ++jj ) {
+				qpData->zVecTmp.data[jj] = 0.;
+			}
+			for( jj=0; jj<(int_t)_NX_; ++jj ) {
+				qpData->xVecTmp.data[jj] = 0.;
+			}
+			for( kk=0; kk<_NI_+1; ++kk ) {
+				interval = qpData->intervals[kk];
+				for( jj=0; jj<(int_t)interval->nV; ++jj ) {
+					qpData->zVecTmp.data[jj] = qpDUNES_fmax( qpData->zVecTmp.data[jj], interval->zVecTmp.data[jj] );
+				}
+				if ( kk > 0 ) {
+					for( jj=0; jj<(int_t)_NX_; ++jj ) {
+						qpData->xVecTmp.data[jj] = qpDUNES_fmax( qpData->xVecTmp.data[jj], interval->xVecTmp.data[jj] );
+					}
+				}
+			}
+		}
+
+		/* (c) update factors; states balance their column against their coupling row */
+		for( kk=0; kk<_NI_+1; ++kk ) {
+			interval = qpData->intervals[kk];
+			colNorm = ( shareFactors == QPDUNES_TRUE ) ? qpData->zVecTmp.data : interval->zVecTmp.data;
+			rowNorm = ( shareFactors == QPDUNES_TRUE ) ? qpData->xVecTmp.data : interval->xVecTmp.data;
+			for( jj=0; jj<(int_t)interval->nV; ++jj ) {
+				cn = colNorm[jj];
+				if ( cn < qpData->options.matrixZeroTolerance ) {	/* variable does not enter the data */
+					continue;
+				}
+				if ( ( jj < (int_t)interval->nX ) && ( (kk > 0) || (shareFactors == QPDUNES_TRUE) ) ) {
+					rn = rowNorm[jj];
+					interval->scaling.data[jj] *= sqrt( sqrt( rn / cn ) );
+				}
+				else {
+					interval->scaling.data[jj] /= sqrt( cn );
+				}
+			}
+		}
+	}
+
+
+	/** (3) scale stored data, soft weights and the multiplier guess */
+	for( kk=0; kk<_NI_+1; ++kk ) {
+		interval = qpData->intervals[kk];
+		qpDUNES_scaleIntervalData( qpData, interval, interval->H.data, interval->g.data,
+								   (kk < _NI_) ? interval->C.data : 0, (kk < _NI_) ? interval->c.data : 0,
+								   interval->zLow.data, interval->zUpp.data, interval->D.data );
+		qpDUNES_scaleSoftBounds( interval, QPDUNES_FALSE );
+		++interval->dataVersion;
+	}
+	qpDUNES_scaleLambda( qpData, &(qpData->lambda), QPDUNES_FALSE );
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_setupScaling */
+
+
+/* ----------------------------------------------
+ * apply the variable scaling of an interval to the stored data;
+ * only fields for which (new) data is given, i.e. the respective
+ * pointer is not null, are scaled
+ *
+ >>>>>>                                           */
+return_t qpDUNES_scaleIntervalData(	qpData_t* const qpData,
+									interval_t* interval,
+									const real_t* const H_,
+									const real_t* const g_,
+									const real_t* const C_,
+									const real_t* const c_,
+									const real_t* const zLow_,
+									const real_t* const zUpp_,
+									const real_t* const D_
+									)
+{
+	int_t ii;
+	int_t nV = interval->nV;
+	int_t nXK1;
+
+	real_t* s = interval->scaling.data;
+	real_t* sK1;
+	real_t* invSK1 = interval->xVecTmp.data;
+
+	if ( s == 0 ) {		/* scaling is off */
+		return QPDUNES_OK;
+	}
+
+	if ( H_ != 0 ) {
+		qpDUNES_scaleMatrix( (matrix_t*)&(interval->H), s, s, nV, nV );
+	}
+	if ( g_ != 0 ) {
+		for( ii=0; ii<nV; ++ii ) {
+			interval->g.data[ii] *= s[ii];
+		}
+	}
+
+	if ( (int_t)interval->id < _NI_ ) {
+		nXK1 = _NX( interval->id+1 );
+		sK1 = qpData->intervals[interval->id+1]->scaling.data;
+		if ( C_ != 0 ) {
+			for( ii=0; ii<nXK1; ++ii ) {
+				invSK1[ii] = 1. / sK1[ii];
+			}
+			qpDUNES_scaleMatrix( (matrix_t*)&(interval->C), invSK1, s, nXK1, nV );
+			if ( nXK1 == (int_t)interval->nX ) {	/* scaled data may change the structure, e.g. of integrator chains */
+				qpDUNES_detectMatrixStructure( &(interval->C.structure), interval->C.data, nXK1, nV );
+			}
+		}
+		if ( c_ != 0 ) {
+			for( ii=0; ii<nXK1; ++ii ) {
+				interval->c.data[ii] /= sK1[ii];
+			}
+		}
+	}
+
+	/* infinite bounds stay infinite */
+	for( ii=0; ii<nV; ++ii ) {
+		if ( ( zLow_ != 0 ) && ( interval->zLow.data[ii] > -qpData->options.QPDUNES_INFTY ) ) {
+			interval->zLow.data[ii] /= s[ii];
+		}
+		if ( ( zUpp_ != 0 ) && ( interval->zUpp.data[ii] < qpData->options.QPDUNES_INFTY ) ) {
+			interval->zUpp.data[ii] /= s[ii];
+		}
+	}
+
+	if ( D_ != 0 ) {
+		qpDUNES_scaleMatrix( (matrix_t*)&(interval->D), 0, s, interval->nD, nV );
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_scaleIntervalData */
+
+
+/* ----------------------------------------------
+ * soft bound weights in scaled variables: softL1 .* scaling and
+ * softL2 .* scaling.^2; undo maps them back
+ *
+ >>>>>>                                           */
+void qpDUNES_scaleSoftBounds(	interval_t* const interval,
+								boolean_t undo
+								)
+{
+	int_t ii;
+	real_t sc;
+
+	if ( ( interval->scaling.data == 0 ) || ( interval->softL1.data == 0 ) )
+	{
+		return;
+	}
+
+	for( ii=0; ii<(int_t)interval->nV; ++ii ) {
+		sc = ( undo == QPDUNES_TRUE ) ? 1. / interval->scaling.data[ii] : interval->scaling.data[ii];
+		interval->softL1.data[ii] *= sc;
+		interval->softL2.data[ii] *= sc * sc;
+	}
+}
+/*<<< END OF qpDUNES_scaleSoftBounds */
+
+
+/* ----------------------------------------------
+ * coupling multipliers in scaled variables, lambdaScaled_k =
+ * scaling_{k+1}(states) .* lambda_k; undo maps them back
+ *
+ >>>>>>                                           */
+void qpDUNES_scaleLambda(	const qpData_t* const qpData,
+							xn_vector_t* const lambda,
+							boolean_t undo
+							)
+{
+	int_t ii, kk;
+	real_t* s;
+
+	for( kk=0; kk<_NI_; ++kk ) {
+		s = qpData->intervals[kk+1]->scaling.data;
+		if ( s == 0 ) {
+			return;
+		}
+		for( ii=0; ii<_NX(kk+1); ++ii ) {
+			if ( undo == QPDUNES_TRUE ) {
+				lambda->data[_XNOFF(kk)+ii] /= s[ii];
+			}
+			else {
+				lambda->data[_XNOFF(kk)+ii] *= s[ii];
+			}
+		}
+	}
+}
+/*<<< END OF qpDUNES_scaleLambda */
+
+
 
 
 /* ----------------------------------------------
@@ -986,12 +1648,12 @@ return_t qpDUNES_setupAllLocalQPs(	qpData_t* const qpData,
 
 
 	/* (1) set up initial lambda guess */
-	qpDUNES_updateVector( &(qpData->intervals[0]->lambdaK1), &(qpData->lambda.data[0]), _NX_ );
+	qpDUNES_updateVector( &(qpData->intervals[0]->lambdaK1), &(qpData->lambda.data[0]), _NX(1) );
 	for( kk=1; kk<_NI_; ++kk ) {
-		qpDUNES_updateVector( &(qpData->intervals[kk]->lambdaK), &(qpData->lambda.data[(kk-1)*_NX_]), _NX_ );
-		qpDUNES_updateVector( &(qpData->intervals[kk]->lambdaK1), &(qpData->lambda.data[kk*_NX_]), _NX_ );
+		qpDUNES_updateVector( &(qpData->intervals[kk]->lambdaK), &(qpData->lambda.data[_XNOFF(kk-1)]), _NX(kk) );
+		qpDUNES_updateVector( &(qpData->intervals[kk]->lambdaK1), &(qpData->lambda.data[_XNOFF(kk)]), _NX(kk+1) );
 	}
-	qpDUNES_updateVector( &(qpData->intervals[_NI_]->lambdaK), &(qpData->lambda.data[(_NI_-1)*_NX_]), _NX_ );
+	qpDUNES_updateVector( &(qpData->intervals[_NI_]->lambdaK), &(qpData->lambda.data[_XNOFF(_NI_-1)]), _NX(_NI_) );
 
 
 	/* (2) decide which QP solver to use and set up */
@@ -1052,6 +1714,9 @@ return_t qpDUNES_setupStageQP(	qpData_t* const qpData,
 	return_t statusFlag;
 
 
+	/* stage QP is reset, a step from qpDUNES_prepare is no longer valid */
+	interval->isPrepared = QPDUNES_FALSE;
+
 	/* presolve first QP */
 	if ( interval->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING ) {
 		/* (a) use clipping stage QP solver */
@@ -1065,10 +1730,10 @@ return_t qpDUNES_setupStageQP(	qpData_t* const qpData,
 		/* (c) solve unconstrained local QP for g and initial lambda guess: */
 		/*	   - get (possibly updated) lambda guess */
 		if (interval->id > 0) {		/* lambdaK exists */
-			qpDUNES_updateVector( &(interval->lambdaK), &(qpData->lambda.data[((interval->id)-1)*_NX_]), _NX_ );
+			qpDUNES_updateVector( &(interval->lambdaK), &(qpData->lambda.data[_XNOFF((interval->id)-1)]), interval->nX );
 		}
-		if (interval->id < _NI_) {		/* lambdaK1 exists */
-			qpDUNES_updateVector( &(interval->lambdaK1), &(qpData->lambda.data[(interval->id)*_NX_]), _NX_ );
+		if ((int_t)interval->id < _NI_) {		/* lambdaK1 exists */
+			qpDUNES_updateVector( &(interval->lambdaK1), &(qpData->lambda.data[_XNOFF(interval->id)]), _NX((interval->id)+1) );
 		}
 
 		/*     - update first order term */
@@ -1088,6 +1753,11 @@ return_t qpDUNES_setupStageQP(	qpData_t* const qpData,
 	}
 	else
 	{
+		if ( interval->softL1.data != 0 ) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Soft bounds are only supported by the clipping stage QP solver (interval %d).", interval->id );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+
 		#ifndef __SIMPLE_BOUNDS_ONLY__
 		/* (a) use qpOASES */
 		interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_QPOASES;
@@ -1097,10 +1767,10 @@ return_t qpDUNES_setupStageQP(	qpData_t* const qpData,
 		qpDUNES_copyVector( &(interval->q), &(interval->g), interval->nV );
 		/*	   - get (possibly updated) lambda guess */
 		if (interval->id > 0) {		/* lambdaK exists */
-			qpDUNES_updateVector( &(interval->lambdaK), &(qpData->lambda.data[((interval->id)-1)*_NX_]), _NX_ );
+			qpDUNES_updateVector( &(interval->lambdaK), &(qpData->lambda.data[_XNOFF((interval->id)-1)]), interval->nX );
 		}
-		if (interval->id < _NI_) {		/* lambdaK1 exists */
-			qpDUNES_updateVector( &(interval->lambdaK1), &(qpData->lambda.data[(interval->id)*_NX_]), _NX_ );
+		if ((int_t)interval->id < _NI_) {		/* lambdaK1 exists */
+			qpDUNES_updateVector( &(interval->lambdaK1), &(qpData->lambda.data[_XNOFF(interval->id)]), _NX((interval->id)+1) );
 		}
 		qpOASES_updateStageData( qpData, interval, &(interval->lambdaK), &(interval->lambdaK1) );
 
@@ -1122,6 +1792,10 @@ return_t qpDUNES_setupStageQP(	qpData_t* const qpData,
 
 
 /* ----------------------------------------------
+ * shift stage data by one interval; the active sets of the last
+ * Newton Hessian setup are kept with the Newton Hessian blocks, which
+ * is only valid for time invariant stage matrices, otherwise call
+ * qpDUNES_indicateDataChange afterwards
  *
  >>>>>>                                           */
 return_t qpDUNES_shiftIntervals(	qpData_t* const qpData
@@ -1129,10 +1803,27 @@ return_t qpDUNES_shiftIntervals(	qpData_t* const qpData
 {
 	int_t kk;
 
+	/*  active sets of last Hessian setup belong to the (unshifted) Newton Hessian blocks */
+	actSetWord_t* freePrevBits = qpData->intervals[_NI_-1]->actSet.prevBits;
+	boolean_t freePrevBitsAreValid = qpData->intervals[_NI_-1]->actSet.prevBitsAreValid;
+
 	/** (1) Shift Interval pointers */
 	/*  save pointer to first interval */
 	interval_t* freeInterval = qpData->intervals[0];
 
+	if ( qpData->hasUniformDims == QPDUNES_FALSE ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Shifting is only supported for stages of equal dimensions." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	/*  keep active sets of last Hessian setup in place */
+	for (kk=_NI_-1; kk>0; --kk) {
+		qpData->intervals[kk]->actSet.prevBits = qpData->intervals[kk-1]->actSet.prevBits;
+		qpData->intervals[kk]->actSet.prevBitsAreValid = qpData->intervals[kk-1]->actSet.prevBitsAreValid;
+	}
+	qpData->intervals[0]->actSet.prevBits = freePrevBits;
+	qpData->intervals[0]->actSet.prevBitsAreValid = freePrevBitsAreValid;
+
 	/*  shift all but the last interval (different size) left */
 	for (kk=0; kk<_NI_-1; ++kk) {
 		qpData->intervals[kk] = qpData->intervals[kk+1];
@@ -1160,6 +1851,11 @@ return_t qpDUNES_shiftLambda(	qpData_t* const qpData
 {
 	int_t kk, ii;
 
+	if ( qpData->hasUniformDims == QPDUNES_FALSE ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Shifting is only supported for stages of equal dimensions." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
 	for (kk=0; kk<_NI_-1; ++kk) {
 		for (ii=0; ii<_NX_; ++ii) {
 			qpData->lambda.data[kk*_NX_+ii] = qpData->lambda.data[(kk+1)*_NX_+ii];
@@ -1203,6 +1899,9 @@ qpOptions_t qpDUNES_setupDefaultOptions(
 	/* additional options */
 	options.nbrInitialGradientSteps		= 0;
 	options.checkForInfeasibility		= QPDUNES_FALSE;
+	options.matrixZeroTolerance			= 1.e-15;
+	options.sparseDensityThreshold		= 0.1;
+	options.maxNumScalingIterations		= 0;
 
 	/* regularization option */
 	options.regType 					= QPDUNES_REG_LEVENBERG_MARQUARDT;
@@ -1212,8 +1911,21 @@ qpOptions_t qpDUNES_setupDefaultOptions(
 	 	 	 	 	 	 	 	 	 	 	 	 	 	 - in this singular direction i want to do mostly a gradient step,
 	 	 	 	 	 	 	 	 	 	 	 	 	 	   few Hessian information usable
 	 	 	 	 	 	 	 	 	 	 	 	 	  */
+	options.regParamMin					= 1.e-9;
+	options.regParamMax					= 1.e-1;
+	options.regParamAdaptationFactor	= 10.;
 
 	options.nwtnHssnFacAlg				= QPDUNES_NH_FAC_BAND_REVERSE;
+	#ifdef __USE_MIXED_PRECISION__
+	options.maxNumNewtonRefinementIterations = 3;
+	#else
+	options.maxNumNewtonRefinementIterations = 0;
+	#endif
+	options.maxNumNewtonCGIterations	= 100;
+	options.nwtnCGForcingTolerance		= 1.e-2;
+	options.maxNumNewtonBlockUpdates	= 0;
+	options.projCacheSize				= 0;
+	options.lambdaChangeTolerance		= 0.;
 
 
 	/* line search options */
@@ -54,9 +54,9 @@ return_t clippingQpSolver_updateStageData(	qpData_t* const qpData,
 
 	if (lambdaK1->isDefined == QPDUNES_TRUE) {
 		/* qStep = C.T*lambdaK1 */
-		multiplyCTy( qpData, &(interval->qpSolverClipping.qStep), &(interval->C), lambdaK1 );
+		multiplyCTy( &(interval->qpSolverClipping.qStep), &(interval->C), lambdaK1, _NX( interval->id+1 ), interval->nV );
 		/* pStep = c*lambdaK1 */
-		interval->qpSolverClipping.pStep = scalarProd( lambdaK1, &(interval->c), _NX_ );	/* constant objective term */
+		interval->qpSolverClipping.pStep = scalarProd( lambdaK1, &(interval->c), _NX( interval->id+1 ) );	/* constant objective term */
 	}
 	else {
 		/* qStep = 0 */
@@ -67,7 +67,7 @@ return_t clippingQpSolver_updateStageData(	qpData_t* const qpData,
 
 	if (lambdaK->isDefined == QPDUNES_TRUE) {
 		/* qStep -= [lambdaK.T 0]	*/
-		for ( ii=0; ii<_NX_; ++ii ) {
+		for ( ii=0; ii<(int_t)interval->nX; ++ii ) {
 			interval->qpSolverClipping.qStep.data[ii] -= lambdaK->data[ii];
 		}
 	}
@@ -111,12 +111,35 @@ return_t directQpSolver_getMinStepsize( const qpData_t* const qpData,
 										const interval_t* const interval,
 										real_t* alphaMin )
 {
-	int ii;
+	int ii, jj;
 	real_t alphaASChange;
+	real_t hii;
+	real_t breakPoint[4];
+
+	const real_t* zU = interval->qpSolverClipping.zUnconstrained.data;
+	const real_t* dz = interval->qpSolverClipping.dz.data;
 
 	for( ii=0; ii<interval->nV; ++ii ) {
+		if ( ( interval->softL1.data != 0 ) &&
+			 ( ( interval->softL1.data[ii] > 0. ) || ( interval->softL2.data[ii] > 0. ) ) )
+		{
+			/* soft bound: the solution changes its regime where zUnconstrained crosses a bound or the end of the L1 kink */
+			hii = ( interval->H.sparsityType == QPDUNES_DIAGONAL ) ? interval->H.data[ii] : 1.;
+			breakPoint[0] = interval->zLow.data[ii];
+			breakPoint[1] = interval->zLow.data[ii] - interval->softL1.data[ii] / hii;
+			breakPoint[2] = interval->zUpp.data[ii];
+			breakPoint[3] = interval->zUpp.data[ii] + interval->softL1.data[ii] / hii;
+			for( jj=0; jj<4; ++jj ) {
+				alphaASChange = ( breakPoint[jj] - zU[ii] ) / dz[ii];
+				if ( (alphaASChange > 0. ) && (alphaASChange < *alphaMin) ) {
+					*alphaMin = alphaASChange;
+				}
+			}
+			continue;
+		}
+
 		/* WARNING: compiler support for 1./0. == inf, and (2. < inf) == TRUE are assumed */
-		alphaASChange = 1./qpDUNES_fmax( interval->qpSolverClipping.dz.data[ii] / interval->y.data[2*ii], interval->qpSolverClipping.dz.data[ii] / - interval->y.data[2*ii+1] );
+		alphaASChange = 1./qpDUNES_fmax( dz[ii] / interval->y.data[2*ii], dz[ii] / - interval->y.data[2*ii+1] );
 		if ( (alphaASChange > 0. ) && (alphaASChange < *alphaMin) ) {
 			*alphaMin = alphaASChange;
 		}
@@ -222,7 +245,7 @@ return_t directQpSolver_doStep( qpData_t* const qpData,
 //	else {
 		qpDUNES_copyVector( z, zUnconstrained, interval->nV );
 	}
-	directQpSolver_saturateVector( qpData, z, mu, &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV );
+	directQpSolver_saturateVector( qpData, z, mu, &(interval->zLow), &(interval->zUpp), &(interval->H), &(interval->softL1), &(interval->softL2), interval->nV );
 
 	/* update q */
 	for ( ii=0; ii<interval->nV; ++ii ) {
@@ -237,6 +260,158 @@ return_t directQpSolver_doStep( qpData_t* const qpData,
 /*<<< END OF qpDUNES_directQpSolver_doStep */
 
 
+/* ----------------------------------------------
+ * fused line search trial point: for step size alpha the trial
+ * primal solution zUnconstrained + alpha*dz is saturated by
+ * directQpSolver_saturateVector, which also yields its bound gaps mu;
+ * the stage objective with q + alpha*qStep, p + alpha*pStep and soft
+ * bound penalties follows while the trial point is still in cache
+ *
+#>>>>>>                                           */
+return_t clippingQpSolver_evaluateTrialPoint(	qpData_t* const qpData,
+												interval_t* const interval,
+												real_t alpha,
+												z_vector_t* const zTry,
+												d2_vector_t* const mu,
+												real_t* const objVal
+												)
+{
+	int_t ii;
+	int_t nV = interval->nV;
+
+	const real_t* zUnc = interval->qpSolverClipping.zUnconstrained.data;
+	const real_t* dz = interval->qpSolverClipping.dz.data;
+	const real_t* q = interval->q.data;
+	const real_t* qStep = interval->qpSolverClipping.qStep.data;
+	const real_t* lb = interval->zLow.data;
+	const real_t* ub = interval->zUpp.data;
+	const real_t* softL1 = interval->softL1.data;	/* not allocated if all bounds are hard */
+	const real_t* softL2 = interval->softL2.data;
+	real_t* z = zTry->data;
+
+	real_t hii;
+	real_t violation;
+	real_t quadPart = 0.;
+	real_t linPart = 0.;
+	real_t penalty = 0.;
+
+	return_t statusFlag;
+
+	/* trial point and feasibility gaps */
+	for( ii=0; ii<nV; ++ii ) {
+		z[ii] = zUnc[ii] + alpha * dz[ii];
+	}
+	statusFlag = directQpSolver_saturateVector( qpData, zTry, mu, &(interval->zLow), &(interval->zUpp), &(interval->H), &(interval->softL1), &(interval->softL2), nV );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+
+	/* objective contributions */
+	for( ii=0; ii<nV; ++ii ) {
+		hii = ( interval->H.sparsityType == QPDUNES_DIAGONAL ) ? interval->H.data[ii] : 1.;
+		quadPart += hii * z[ii] * z[ii];
+		linPart += (q[ii] + alpha * qStep[ii]) * z[ii];
+		if ( softL1 != 0 ) {
+			violation = qpDUNES_fmax( lb[ii] - z[ii], z[ii] - ub[ii] );
+			if ( violation > 0. ) {
+				penalty += (softL1[ii] + 0.5 * softL2[ii] * violation) * violation;
+			}
+		}
+	}
+
+	*objVal = 0.5 * quadPart;
+	*objVal += linPart;
+	*objVal += interval->p + alpha * interval->qpSolverClipping.pStep;
+	*objVal += penalty;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF clippingQpSolver_evaluateTrialPoint */
+
+
+/* ----------------------------------------------
+ * stage objective at nAlpha trial step sizes in one pass over the
+ * stage variables; the inner loop runs over the step sizes, so the
+ * stage data is loaded once per variable and hard bounded variables
+ * vectorize across the step sizes. Per step size the result equals
+ * clippingQpSolver_evaluateTrialPoint. work holds 3*nAlpha entries.
+ *
+#>>>>>>                                           */
+return_t clippingQpSolver_evaluateTrialPoints(	qpData_t* const qpData,
+												interval_t* const interval,
+												int_t nAlpha,
+												const real_t* const alphas,
+												real_t* const objVals,
+												real_t* const work
+												)
+{
+	int_t ii, aa;
+	int_t nV = interval->nV;
+
+	const real_t* softL1 = interval->softL1.data;	/* not allocated if all bounds are hard */
+	const real_t* softL2 = interval->softL2.data;
+	real_t* quadPart = work;
+	real_t* linPart = &(work[nAlpha]);
+	real_t* penalty = &(work[2*nAlpha]);
+
+	real_t hii, zUnc, dz, q, qStep, lb, ub, w1, w2;
+	real_t zTry, gapLow, gapUpp, violation;
+	real_t tol = qpData->options.activenessTolerance;
+
+	if ( ( interval->H.sparsityType != QPDUNES_DIAGONAL ) && ( interval->H.sparsityType != QPDUNES_IDENTITY ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown sparsity type of QP hessian" );
+		return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+	}
+
+	for( aa=0; aa<3*nAlpha; ++aa ) {
+		work[aa] = 0.;
+	}
+
+	for( ii=0; ii<nV; ++ii ) {
+		hii = ( interval->H.sparsityType == QPDUNES_DIAGONAL ) ? interval->H.data[ii] : 1.;
+		zUnc = interval->qpSolverClipping.zUnconstrained.data[ii];
+		dz = interval->qpSolverClipping.dz.data[ii];
+		q = interval->q.data[ii];
+		qStep = interval->qpSolverClipping.qStep.data[ii];
+		lb = interval->zLow.data[ii];
+		ub = interval->zUpp.data[ii];
+
+		if ( ( softL1 == 0 ) || ( ( softL1[ii] <= 0. ) && ( softL2[ii] <= 0. ) ) ) {
+			/* hard bounds: branch free clipping */
+			for( aa=0; aa<nAlpha; ++aa ) {
+				zTry = zUnc + alphas[aa] * dz;
+				zTry = ( (lb - zTry)*hii >= -tol ) ? lb : ( ( (zTry - ub)*hii >= -tol ) ? ub : zTry );
+				quadPart[aa] += hii * zTry * zTry;
+				linPart[aa] += (q + alphas[aa] * qStep) * zTry;
+			}
+			continue;
+		}
+
+		/* soft bounds, same saturation as directQpSolver_saturateVectorSoft */
+		w1 = softL1[ii];
+		w2 = softL2[ii];
+		for( aa=0; aa<nAlpha; ++aa ) {
+			zTry = zUnc + alphas[aa] * dz;
+			directQpSolver_saturateEntrySoft( &zTry, &gapLow, &gapUpp, lb, ub, hii, w1, w2, tol );
+			quadPart[aa] += hii * zTry * zTry;
+			linPart[aa] += (q + alphas[aa] * qStep) * zTry;
+			violation = ( lb - zTry > zTry - ub ) ? lb - zTry : zTry - ub;
+			penalty[aa] += ( violation > 0. ) ? (w1 + 0.5 * w2 * violation) * violation : 0.;
+		}
+	}
+
+	for( aa=0; aa<nAlpha; ++aa ) {
+		objVals[aa] = 0.5 * quadPart[aa];
+		objVals[aa] += linPart[aa];
+		objVals[aa] += interval->p + alphas[aa] * interval->qpSolverClipping.pStep;
+		objVals[aa] += penalty[aa];
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF clippingQpSolver_evaluateTrialPoints */
+
+
 /* ----------------------------------------------
  * ...
  * 
@@ -248,11 +423,17 @@ return_t directQpSolver_saturateVector(	qpData_t* const qpData,
 										const d_vector_t* const lb,
 										const d_vector_t* const ub,
 										const zz_matrix_t* const H,
+										const z_vector_t* const softL1,	/* L1 weights of soft bounds; not allocated if all bounds are hard */
+										const z_vector_t* const softL2,	/* L2 weights of soft bounds */
 										int_t nV
 										)
 {
 	int_t ii;
 	
+	if ( softL1->data != 0 ) {
+		return directQpSolver_saturateVectorSoft( qpData, vec, mu, lb, ub, H, softL1, softL2, nV );
+	}
+
 	switch (H->sparsityType)	{
 		case QPDUNES_DIAGONAL:		/* H is saved in first row of memory */
 			for( ii=0; ii<nV; ++ii ) {
@@ -311,6 +492,181 @@ return_t directQpSolver_saturateVector(	qpData_t* const qpData,
 /*<<< END OF qp42_directQpSolver_saturateVector */
 
 
+/* ----------------------------------------------
+ * saturation with soft bounds; per coordinate the stage QP
+ *   min 0.5*h*z^2 + q*z + w1*v + 0.5*w2*v^2,  v = bound violation,
+ * stays separable: from zUnconstrained the solution is clipped to
+ * the bound while the bound multiplier h*(lb-zUnconstrained) is
+ * below w1, and beyond that moves into the penalized region as
+ *   z = (h*zUnconstrained + w1 + w2*lb) / (h + w2)
+ * (analogously for ub); in the penalized region the bound is not
+ * clipping, mu holds the (negative) distance to the end of the kink
+ *
+#>>>>>>                                           */
+return_t directQpSolver_saturateVectorSoft(	qpData_t* const qpData,
+											d_vector_t* const vec,
+											d2_vector_t* const mu,
+											const d_vector_t* const lb,
+											const d_vector_t* const ub,
+											const zz_matrix_t* const H,
+											const z_vector_t* const softL1,
+											const z_vector_t* const softL2,
+											int_t nV
+											)
+{
+	int_t ii;
+	real_t hii;
+
+	if ( ( H->sparsityType != QPDUNES_DIAGONAL ) && ( H->sparsityType != QPDUNES_IDENTITY ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown sparsity type of QP hessian" );
+		return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+	}
+
+	for( ii=0; ii<nV; ++ii ) {
+		hii = ( H->sparsityType == QPDUNES_DIAGONAL ) ? H->data[ii] : 1.;
+
+		if ( ( softL1->data[ii] > 0. ) || ( softL2->data[ii] > 0. ) ) {
+			directQpSolver_saturateEntrySoft( &(vec->data[ii]), &(mu->data[2*ii]), &(mu->data[2*ii+1]),
+											  lb->data[ii], ub->data[ii], hii, softL1->data[ii], softL2->data[ii],
+											  qpData->options.activenessTolerance );
+			continue;
+		}
+
+		mu->data[2*ii] = (lb->data[ii] - vec->data[ii])*hii;	/* feasibility gap to lower bound; negative value means inactive */
+		mu->data[2*ii+1] = (vec->data[ii] - ub->data[ii])*hii;	/* feasibility gap to upper bound; negative value means inactive */
+
+		if ( mu->data[2*ii] >= -qpData->options.activenessTolerance ) {
+			vec->data[ii] = lb->data[ii];
+		}
+		else {
+			if ( mu->data[2*ii+1] >= -qpData->options.activenessTolerance ) {
+				vec->data[ii] = ub->data[ii];
+			}
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF directQpSolver_saturateVectorSoft */
+
+
+/* ----------------------------------------------
+ * soft bound saturation of a single coordinate with penalty weights
+ * w1, w2 (not both zero), as in directQpSolver_saturateVectorSoft;
+ * z holds the unconstrained value on entry and the saturated one on
+ * return, gapLow and gapUpp receive the corresponding entries of mu
+ *
+#>>>>>>                                           */
+void directQpSolver_saturateEntrySoft(	real_t* const z,
+										real_t* const gapLow,
+										real_t* const gapUpp,
+										real_t lb,
+										real_t ub,
+										real_t hii,
+										real_t w1,
+										real_t w2,
+										real_t activenessTolerance
+										)
+{
+	*gapLow = (lb - *z)*hii;	/* feasibility gap to lower bound; negative value means inactive */
+	*gapUpp = (*z - ub)*hii;	/* feasibility gap to upper bound; negative value means inactive */
+
+	if ( *gapLow > w1 ) {	/* penalized region below lb */
+		*z = (hii * *z + w1 + w2 * lb) / (hii + w2);
+		*gapLow = w1 - *gapLow;
+		return;
+	}
+	if ( *gapUpp > w1 ) {	/* penalized region above ub */
+		*z = (hii * *z - w1 + w2 * ub) / (hii + w2);
+		*gapUpp = w1 - *gapUpp;
+		return;
+	}
+
+	if ( *gapLow >= -activenessTolerance ) {
+		*z = lb;
+	}
+	else {
+		if ( *gapUpp >= -activenessTolerance ) {
+			*z = ub;
+		}
+	}
+}
+/*<<< END OF directQpSolver_saturateEntrySoft */
+
+
+/* ----------------------------------------------
+ * penalty of soft bound violations in the current primal solution
+ *
+#>>>>>>                                           */
+real_t clippingQpSolver_getSoftPenalty(	const interval_t* const interval
+										)
+{
+	int_t ii;
+	real_t violation;
+	real_t penalty = 0.;
+
+	if ( interval->softL1.data == 0 ) {
+		return 0.;
+	}
+
+	for( ii=0; ii<(int_t)interval->nV; ++ii ) {
+		violation = qpDUNES_fmax( interval->zLow.data[ii] - interval->z.data[ii], interval->z.data[ii] - interval->zUpp.data[ii] );
+		if ( violation > 0. ) {
+			penalty += (interval->softL1.data[ii] + 0.5 * interval->softL2.data[ii] * violation) * violation;
+		}
+	}
+
+	return penalty;
+}
+/*<<< END OF clippingQpSolver_getSoftPenalty */
+
+
+/* ----------------------------------------------
+ * diagonal stage Hessian as seen by the Newton system: variables in
+ * the penalized region of a soft bound have curvature h + softL2;
+ * without soft bounds this is just the (diagonal) Hessian factor
+ *
+#>>>>>>                                           */
+vv_matrix_t* clippingQpSolver_getNewtonHessianFactor(	interval_t* const interval
+														)
+{
+	int_t ii;
+	vv_matrix_t* HSoft = &(interval->qpSolverClipping.HSoft);
+
+	if ( interval->softL1.data == 0 ) {
+		return &(interval->cholH);
+	}
+
+	for( ii=0; ii<(int_t)interval->nV; ++ii ) {
+		HSoft->data[ii] = ( interval->H.sparsityType == QPDUNES_DIAGONAL ) ? interval->H.data[ii] : 1.;
+		if ( clippingQpSolver_isSoftActive( interval, ii ) == QPDUNES_TRUE ) {
+			HSoft->data[ii] += interval->softL2.data[ii];
+		}
+	}
+
+	return HSoft;
+}
+/*<<< END OF clippingQpSolver_getNewtonHessianFactor */
+
+
+/* ----------------------------------------------
+ * whether variable ii lies in the penalized region of a soft bound
+ * with quadratic weight, i.e., beyond its bound
+ *
+#>>>>>>                                           */
+boolean_t clippingQpSolver_isSoftActive(	const interval_t* const interval,
+											int_t ii
+											)
+{
+	if ( ( interval->softL1.data == 0 ) || ( interval->softL2.data[ii] <= 0. ) ) {
+		return QPDUNES_FALSE;
+	}
+
+	return ( ( interval->z.data[ii] < interval->zLow.data[ii] ) || ( interval->z.data[ii] > interval->zUpp.data[ii] ) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+}
+/*<<< END OF clippingQpSolver_isSoftActive */
+
+
 
 /* ----------------------------------------------
  * ...
@@ -377,6 +733,8 @@ real_t directQpSolver_getObjectiveValue(	qpData_t* const qpData,
 	objVal += scalarProd( &(interval->q), &(interval->z), interval->nV );
 	/* constant part */
 	objVal += interval->p;
+	/* soft bound penalties */
+	objVal += clippingQpSolver_getSoftPenalty( interval );
 
 	return objVal;
 }
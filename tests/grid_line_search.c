@@ -0,0 +1,133 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/grid_line_search.c
+ *
+ *	Checks the grid line searches with hard and soft bounds against the
+ *	default line search, and the objective values of the vectorized grid
+ *	evaluation against single evaluations along the Newton direction.
+ */
+
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "test_utils.h"
+
+#define NGRID 25	/* number of grid points */
+#define NLS 2		/* number of tested grid line searches */
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t ii, soft, ls;
+	int_t nErrors = 0;
+
+	lineSearchType_t lsType[NLS] = { QPDUNES_LS_GRID_LS, QPDUNES_LS_ACCELERATED_GRID_LS };
+
+	testProblem_t qp;
+	real_t *softL1, *softL2;
+
+	real_t alphas[NGRID], objVals[NGRID];
+	real_t err, objVal;
+
+	qpData_t qpData;
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions;
+
+
+	test_createProblem( &qp, 10, 3, 2, 4.0, 0.3, -0.7, 0.5 );
+	softL1 = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	softL2 = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	for (ii = 0; ii < qp.nZttl; ++ii) {
+		softL1[ii] = ( ii % 3 ) ? 0.5 : 0.;
+		softL2[ii] = ( ii % 2 ) ? 1.0 : 0.;
+	}
+	for (ii = 0; ii < NGRID; ++ii) {
+		alphas[ii] = 0.02 + 1.3 * ii / (NGRID - 1);
+	}
+
+	for (soft = 0; soft < 2; ++soft)
+	{
+		/* reference: default line search */
+		qpOptions = qpDUNES_setupDefaultOptions();
+		qpOptions.printLevel = 0;
+		if ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) {
+			return 1;
+		}
+		if ( soft ) {
+			qpDUNES_setSoftBounds( &qpDataRef, softL1, softL2 );
+		}
+		test_check( &nErrors, qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "soft %d: reference QP solver failed", soft );
+
+		for (ls = 0; ls < NLS; ++ls) {
+			qpOptions.lsType = lsType[ls];
+			qpOptions.lineSearchNbrGridPoints = NGRID;
+			if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+				return 1;
+			}
+			if ( soft ) {
+				qpDUNES_setSoftBounds( &qpData, softL1, softL2 );
+			}
+			test_check( &nErrors, qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+						"soft %d: QP solver failed with line search %d", soft, lsType[ls] );
+			test_check( &nErrors, test_solutionDifference( &qpData, &qpDataRef ) <= TOL,
+						"soft %d: solution with line search %d differs from default", soft, lsType[ls] );
+			qpDUNES_cleanup( &qpData );
+		}
+		qpDUNES_cleanup( &qpDataRef );
+
+		/* grid objective values along the Newton direction of an unfinished solve */
+		qpOptions.maxIter = 2;
+		if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+			return 1;
+		}
+		if ( soft ) {
+			qpDUNES_setSoftBounds( &qpData, softL1, softL2 );
+		}
+		qpDUNES_solve( &qpData );
+		test_check( &nErrors, qpDUNES_computeGridObjectiveValues( &qpData, NGRID, alphas, objVals ) == QPDUNES_OK,
+					"soft %d: grid objective evaluation failed", soft );
+		err = 0.;
+		for (ii = 0; ii < NGRID; ++ii) {
+			objVal = qpDUNES_computeParametricObjectiveValue( &qpData, alphas[ii] );
+			err = fmax( err, fabs( objVals[ii] - objVal ) / ( 1. + fabs( objVal ) ) );
+		}
+		test_check( &nErrors, err <= TOL, "soft %d: grid objective values differ from single evaluations by %.3e", soft, err );
+		qpDUNES_cleanup( &qpData );
+	}
+
+	test_freeProblem( &qp );
+	free( softL1 );
+	free( softL2 );
+
+	return test_finish( "grid_line_search", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
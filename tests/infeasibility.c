@@ -0,0 +1,123 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/infeasibility.c
+ *
+ *	Makes the stage coupling of a test QP infeasible by an offset that no
+ *	stage feasible point can compensate, and checks that qpDUNES_solve
+ *	reports it with a valid certificate, while the feasible QP is still
+ *	solved with the check enabled.
+ */
+
+
+#include <math.h>
+
+#include "test_utils.h"
+
+#define INFEASIBLE_STAGE 4
+#define OFFSET 10.0		/* exceeds |C_k z_k - x_{k+1}| over the stage boxes */
+#define TOL 1.0e-10
+
+
+int main( )
+{
+	int_t ii, jj, kk, nV;
+	int_t nErrors = 0;
+	return_t statusFlag;
+	real_t bound, minResidual, coeff, dirNorm;
+	real_t* dir;
+
+	testProblem_t qp;
+
+	qpData_t qpData;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+	qpOptions.checkForInfeasibility = QPDUNES_TRUE;
+
+
+	test_createProblem( &qp, 8, 3, 2, 2.0, 0.5, -1.0, 1.0 );
+
+	/** (1) feasible QP: the check must not trigger */
+	if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	statusFlag = qpDUNES_solve( &qpData );
+	test_check( &nErrors, statusFlag == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+				"feasible QP: solver returned %d instead of an optimal solution", statusFlag );
+	qpDUNES_cleanup( &qpData );
+
+	/** (2) infeasible QP */
+	qp.c[INFEASIBLE_STAGE*qp.nX] += OFFSET;
+	if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	statusFlag = qpDUNES_solve( &qpData );
+	test_check( &nErrors, statusFlag == QPDUNES_ERROR_STAGE_COUPLING_INFEASIBLE,
+				"infeasible QP: solver returned %d instead of infeasible stage coupling", statusFlag );
+
+	/* certificate: direction r with min_{z in stage boxes} r.T*(C_k*z_k + c_k - x_{k+1}) > 0,
+	 * evaluated here from the QP data independently of qpDUNES_getCouplingViolationBound */
+	dir = qpData.deltaLambda.data;
+	bound = qpDUNES_getCouplingViolationBound( &qpData, &(qpData.deltaLambda) );
+	if ( qpDUNES_getCouplingViolationBound( &qpData, &(qpData.lambda) ) > bound ) {
+		dir = qpData.lambda.data;
+		bound = qpDUNES_getCouplingViolationBound( &qpData, &(qpData.lambda) );
+	}
+	dirNorm = 0.;
+	for (ii = 0; ii < qp.nXttl; ++ii) {
+		dirNorm = qpDUNES_fmax( dirNorm, fabs( dir[ii] ) );
+	}
+	minResidual = 0.;
+	for (kk = 0; kk <= qp.nI; ++kk) {
+		nV = (kk < qp.nI) ? qp.nZ : qp.nX;
+		for (jj = 0; jj < nV; ++jj) {
+			coeff = 0.;
+			for (ii = 0; (kk < qp.nI) && (ii < qp.nX); ++ii) {
+				coeff += qp.C[(kk*qp.nX + ii)*qp.nZ + jj] * dir[kk*qp.nX + ii];
+			}
+			if ( (kk > 0) && (jj < qp.nX) ) {
+				coeff -= dir[(kk-1)*qp.nX + jj];
+			}
+			minResidual += coeff * ( (coeff > 0.) ? qp.zLow[kk*qp.nZ + jj] : qp.zUpp[kk*qp.nZ + jj] );
+		}
+		for (ii = 0; (kk < qp.nI) && (ii < qp.nX); ++ii) {
+			minResidual += dir[kk*qp.nX + ii] * qp.c[kk*qp.nX + ii];
+		}
+	}
+	test_check( &nErrors, minResidual / dirNorm > qpOptions.stationarityTolerance,
+				"infeasible QP: no certificate, violation bound %.3e", minResidual / dirNorm );
+	test_check( &nErrors, fabs( bound - minResidual / dirNorm ) <= TOL * qpDUNES_fmax( 1., fabs( bound ) ),
+				"infeasible QP: reported violation bound %.3e differs from %.3e", bound, minResidual / dirNorm );
+	qpDUNES_cleanup( &qpData );
+
+	test_freeProblem( &qp );
+
+	return test_finish( "infeasibility", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
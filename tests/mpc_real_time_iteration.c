@@ -0,0 +1,120 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/mpc_real_time_iteration.c
+ *
+ *	Runs a closed loop MPC simulation twice, once with mpcDUNES_solve and
+ *	once split into the feedback and preparation phases of a real-time
+ *	iteration, and checks that both give the same MPC solutions.
+ */
+
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <mpc/setup_mpc.h>
+#include "test_utils.h"
+
+#define NSTEPS 10	/* number of closed loop steps */
+#define TOL 1.0e-12
+
+
+int main( )
+{
+	int_t ii, step;
+	int_t nErrors = 0;
+	return_t statusFlag, statusFlagRti;
+	real_t err;
+
+	testProblem_t qp;
+	real_t *zRef, *x0;
+
+	mpcProblem_t mpcProblem;
+	mpcProblem_t mpcProblemRti;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+
+
+	test_createProblem( &qp, 12, 3, 2, 3.0, 0.5, -1.2, 1.0 );
+	zRef = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	x0 = (real_t*)calloc( qp.nX, sizeof(real_t) );
+	for (ii = 0; ii < qp.nX; ++ii) {
+		x0[ii] = 0.3 * test_random();
+	}
+
+	if ( ( mpcDUNES_setup( &mpcProblem, qp.nI, qp.nX, qp.nU, 0, &qpOptions ) != QPDUNES_OK ) ||
+		 ( mpcDUNES_setup( &mpcProblemRti, qp.nI, qp.nX, qp.nU, 0, &qpOptions ) != QPDUNES_OK ) ||
+		 ( mpcDUNES_initLtvSb( &mpcProblem, qp.H, qp.g, qp.C, qp.c, qp.zLow, qp.zUpp, zRef ) != QPDUNES_OK ) ||
+		 ( mpcDUNES_initLtvSb( &mpcProblemRti, qp.H, qp.g, qp.C, qp.c, qp.zLow, qp.zUpp, zRef ) != QPDUNES_OK ) )
+	{
+		printf( "Setup of the MPC problems failed\n" );
+		return 1;
+	}
+
+	for (step = 0; step < NSTEPS; ++step)
+	{
+		statusFlag = mpcDUNES_solve( &mpcProblem, x0 );
+
+		statusFlagRti = mpcDUNES_feedback( &mpcProblemRti, x0 );
+		test_check( &nErrors, statusFlagRti == statusFlag,
+					"step %d: feedback returned %d, solve returned %d", step, statusFlagRti, statusFlag );
+		test_check( &nErrors, statusFlag == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+					"step %d: MPC solve failed with %d", step, statusFlag );
+
+		err = fabs( mpcProblemRti.optObjVal - mpcProblem.optObjVal );
+		for (ii = 0; ii < (qp.nI + 1) * qp.nX; ++ii) {
+			err = fmax( err, fabs( mpcProblemRti.xOpt[ii] - mpcProblem.xOpt[ii] ) );
+		}
+		for (ii = 0; ii < qp.nI * qp.nU; ++ii) {
+			err = fmax( err, fabs( mpcProblemRti.uOpt[ii] - mpcProblem.uOpt[ii] ) );
+		}
+		for (ii = 0; ii < qp.nXttl; ++ii) {
+			err = fmax( err, fabs( mpcProblemRti.lambdaOpt[ii] - mpcProblem.lambdaOpt[ii] ) );
+		}
+		test_check( &nErrors, err <= TOL,
+					"step %d: feedback and preparation differ from solve by %.3e", step, err );
+
+		test_check( &nErrors, mpcDUNES_prepare( &mpcProblemRti ) == QPDUNES_OK,
+					"step %d: preparation of the next QP failed", step );
+
+		/* closed loop: the next initial value is the predicted state */
+		for (ii = 0; ii < qp.nX; ++ii) {
+			x0[ii] = mpcProblem.xOpt[qp.nX + ii];
+		}
+	}
+
+	mpcDUNES_cleanup( &mpcProblem );
+	mpcDUNES_cleanup( &mpcProblemRti );
+	free( zRef );
+	free( x0 );
+	test_freeProblem( &qp );
+
+	return test_finish( "mpc_real_time_iteration", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,116 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/newton_factor_twist.c
+ *
+ *	Solves a sequence of QPs whose active set changes first only in the
+ *	last and then only in the first stages with the automatically twisted
+ *	band factorization of the Newton Hessian. Checks that the twist
+ *	follows the changes and that the solutions match the forward and the
+ *	fixed twist factorizations.
+ */
+
+
+#include "test_utils.h"
+
+#define NRUNS 15	/* number of solves per phase */
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t ii, run, phase, kk;
+	int_t nErrors = 0;
+
+	testProblem_t qp;
+
+	qpData_t qpDataAuto;
+	qpData_t qpDataForward;
+	qpData_t qpDataTwisted;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+
+
+	test_createProblem( &qp, 20, 3, 2, 3.0, 0.5, -1.0, 1.0 );
+	qpOptions.nwtnHssnFacAlg = QPDUNES_NH_FAC_BAND_AUTO;
+	if ( test_setupSolver( &qpDataAuto, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	qpOptions.nwtnHssnFacAlg = QPDUNES_NH_FAC_BAND_FORWARD;
+	if ( test_setupSolver( &qpDataForward, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	qpOptions.nwtnHssnFacAlg = QPDUNES_NH_FAC_BAND_TWISTED;
+	if ( test_setupSolver( &qpDataTwisted, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+
+	/* phase 0: gradient changes in the last quarter of the horizon, phase 1: in the first quarter */
+	for (phase = 0; phase < 2; ++phase)
+	{
+		for (run = 0; run < NRUNS; ++run)
+		{
+			test_check( &nErrors, ( qpDUNES_solve( &qpDataAuto ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+								  ( qpDUNES_solve( &qpDataForward ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+								  ( qpDUNES_solve( &qpDataTwisted ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ),
+						"phase %d, run %d: QP solver failed", phase, run );
+			test_check( &nErrors, test_solutionDifference( &qpDataAuto, &qpDataForward ) <= TOL,
+						"phase %d, run %d: automatic twist solution differs from forward factorization", phase, run );
+			test_check( &nErrors, test_solutionDifference( &qpDataAuto, &qpDataTwisted ) <= TOL,
+						"phase %d, run %d: automatic twist solution differs from fixed twist", phase, run );
+
+			for (ii = 0; ii < qp.nZttl; ++ii) {
+				kk = ii / qp.nZ;
+				if ( ( phase == 0 ) ? ( kk >= 3*qp.nI/4 ) : ( kk < qp.nI/4 ) ) {
+					qp.g[ii] += 0.8 * test_random();
+				}
+			}
+			qpDUNES_updateData( &qpDataAuto, 0, qp.g, 0, 0, 0, 0, 0, 0, 0 );
+			qpDUNES_updateData( &qpDataForward, 0, qp.g, 0, 0, 0, 0, 0, 0, 0 );
+			qpDUNES_updateData( &qpDataTwisted, 0, qp.g, 0, 0, 0, 0, 0, 0, 0 );
+		}
+
+		if ( phase == 0 ) {
+			test_check( &nErrors, qpDataAuto.nwtnFacTwistIdx >= qp.nI/2,
+						"twist at block %d after active set changes at the end of the horizon", qpDataAuto.nwtnFacTwistIdx );
+		}
+		else {
+			test_check( &nErrors, qpDataAuto.nwtnFacTwistIdx < qp.nI/2,
+						"twist at block %d after active set changes at the start of the horizon", qpDataAuto.nwtnFacTwistIdx );
+		}
+	}
+
+	qpDUNES_cleanup( &qpDataAuto );
+	qpDUNES_cleanup( &qpDataForward );
+	qpDUNES_cleanup( &qpDataTwisted );
+	test_freeProblem( &qp );
+
+	return test_finish( "newton_factor_twist", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,97 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/newton_solvers.c
+ *
+ *	Solves an MPC like sequence of QPs with each alternative solver of the
+ *	Newton system and compares it with the default reverse band
+ *	factorization of the Newton Hessian.
+ */
+
+
+#include "test_utils.h"
+
+#define NRUNS 20	/* number of solves with updated data */
+#define NALG 2		/* number of tested Newton system solvers */
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t run, alg;
+	int_t nErrors = 0;
+
+	nwtnHssnFacAlg_t nwtnHssnFacAlg[NALG] = { QPDUNES_NH_PCG_BLOCK_JACOBI, QPDUNES_NH_FAC_BAND_TWISTED };
+
+	testProblem_t qp;
+
+	qpData_t qpData[NALG];
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+	qpOptions.stationarityTolerance = 1.0e-8;	/* inexact Newton steps end elsewhere within the default tolerance */
+
+
+	test_createProblem( &qp, 12, 3, 2, 3.0, 0.5, -1.2, 1.0 );
+	if ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	for (alg = 0; alg < NALG; ++alg) {
+		qpOptions.nwtnHssnFacAlg = nwtnHssnFacAlg[alg];
+		if ( test_setupSolver( &qpData[alg], &qp, &qpOptions ) != QPDUNES_OK ) {
+			return 1;
+		}
+	}
+
+	for (run = 0; run < NRUNS; ++run)
+	{
+		test_check( &nErrors, qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "run %d: reference QP solver failed", run );
+		for (alg = 0; alg < NALG; ++alg) {
+			test_check( &nErrors, qpDUNES_solve( &qpData[alg] ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+						"run %d: QP solver failed with Newton system solver %d", run, nwtnHssnFacAlg[alg] );
+			test_check( &nErrors, test_solutionDifference( &qpData[alg], &qpDataRef ) <= TOL,
+						"run %d: solution with Newton system solver %d differs from reverse factorization", run, nwtnHssnFacAlg[alg] );
+		}
+
+		test_perturbProblem( &qp );
+		qpDUNES_updateData( &qpDataRef, 0, qp.g, 0, 0, qp.zLow, qp.zUpp, 0, 0, 0 );
+		for (alg = 0; alg < NALG; ++alg) {
+			qpDUNES_updateData( &qpData[alg], 0, qp.g, 0, 0, qp.zLow, qp.zUpp, 0, 0, 0 );
+		}
+	}
+
+	qpDUNES_cleanup( &qpDataRef );
+	for (alg = 0; alg < NALG; ++alg) {
+		qpDUNES_cleanup( &qpData[alg] );
+	}
+	test_freeProblem( &qp );
+
+	return test_finish( "newton_solvers", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,101 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/projection_cache.c
+ *
+ *	Solves an MPC like sequence of QPs, with Hessian and dynamics updated
+ *	halfway, with the cache of stage projections enabled and compares it
+ *	with the uncached solver.
+ */
+
+
+#include "test_utils.h"
+
+#define NRUNS 20	/* number of solves with updated data */
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t ii, jj, kk, run;
+	int_t nErrors = 0;
+
+	testProblem_t qp;
+
+	qpData_t qpData;
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+
+
+	test_createProblem( &qp, 12, 3, 2, 3.0, 0.5, -1.2, 1.0 );
+	if ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	qpOptions.projCacheSize = 8;
+	if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+
+	for (run = 0; run < NRUNS; ++run)
+	{
+		test_check( &nErrors, ( qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+							  ( qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ),
+					"run %d: QP solver failed", run );
+		test_check( &nErrors, test_solutionDifference( &qpData, &qpDataRef ) <= TOL,
+					"run %d: solution with projection cache differs", run );
+
+		test_perturbProblem( &qp );
+		if ( run == NRUNS/2 ) {
+			/* cached projections of the old stage data must not be reused */
+			for (kk = 0; kk < qp.nI; ++kk) {
+				for (ii = 0; ii < qp.nZ; ++ii) {
+					qp.H[kk*qp.nZ*qp.nZ + ii*qp.nZ + ii] *= 1.5;
+				}
+				for (jj = 0; jj < qp.nZ; ++jj) {
+					qp.C[kk*qp.nX*qp.nZ + jj] += 0.2;
+				}
+			}
+			qpDUNES_updateData( &qpData, qp.H, qp.g, qp.C, 0, qp.zLow, qp.zUpp, 0, 0, 0 );
+			qpDUNES_updateData( &qpDataRef, qp.H, qp.g, qp.C, 0, qp.zLow, qp.zUpp, 0, 0, 0 );
+		}
+		else {
+			qpDUNES_updateData( &qpData, 0, qp.g, 0, 0, qp.zLow, qp.zUpp, 0, 0, 0 );
+			qpDUNES_updateData( &qpDataRef, 0, qp.g, 0, 0, qp.zLow, qp.zUpp, 0, 0, 0 );
+		}
+	}
+	test_check( &nErrors, qpData.log.numProjCacheHits > 0, "projection cache was never used" );
+
+	qpDUNES_cleanup( &qpData );
+	qpDUNES_cleanup( &qpDataRef );
+	test_freeProblem( &qp );
+
+	return test_finish( "projection_cache", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
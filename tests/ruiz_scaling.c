@@ -0,0 +1,113 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/ruiz_scaling.c
+ *
+ *	Solves a badly scaled QP with and without Ruiz equilibration of the
+ *	stage data, before and after a data update, and compares the
+ *	solutions, which are returned in the original variables.
+ */
+
+
+#include "test_utils.h"
+
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t ii, jj, kk, run, nV;
+	int_t nErrors = 0;
+
+	/* variable magnitudes, z = T .* zHat with well scaled zHat */
+	real_t T[4] = { 1.0e2, 1.0e-1, 1.0, 1.0e-2 };
+
+	testProblem_t qp;
+
+	qpData_t qpData;
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+
+
+	/* transform a well scaled problem to the variables z = T .* zHat */
+	test_createProblem( &qp, 8, 3, 1, 2.0, 0.4, -0.7, 0.5 );
+	for (kk = 0; kk <= qp.nI; ++kk) {
+		nV = ( kk < qp.nI ) ? qp.nZ : qp.nX;
+		for (ii = 0; ii < nV; ++ii) {
+			qp.H[kk*qp.nZ*qp.nZ + ii*nV + ii] /= T[ii] * T[ii];
+			qp.g[kk*qp.nZ + ii] /= T[ii];
+			qp.zLow[kk*qp.nZ + ii] *= T[ii];
+			qp.zUpp[kk*qp.nZ + ii] *= T[ii];
+		}
+		if ( kk < qp.nI ) {
+			for (ii = 0; ii < qp.nX; ++ii) {
+				for (jj = 0; jj < qp.nZ; ++jj) {
+					qp.C[(kk*qp.nX + ii)*qp.nZ + jj] *= T[ii] / T[jj];
+				}
+				qp.c[kk*qp.nX + ii] *= T[ii];
+			}
+		}
+	}
+
+	if ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	qpOptions.maxNumScalingIterations = 10;
+	if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+
+
+	/* solve, then update the data and solve again */
+	for (run = 0; run < 2; ++run)
+	{
+		test_check( &nErrors, ( qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+							  ( qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ),
+					"run %d: QP solver failed", run );
+		test_check( &nErrors, test_solutionDifference( &qpData, &qpDataRef ) <= TOL,
+					"run %d: scaled solution differs from unscaled one", run );
+
+		for (ii = 0; ii < qp.nZttl; ++ii) {
+			qp.g[ii] = 2.0 * test_random() / T[ii % qp.nZ];
+		}
+		for (ii = 0; ii < qp.nXttl; ++ii) {
+			qp.c[ii] = 0.2 * test_random() * T[ii % qp.nX];
+		}
+		qpDUNES_updateData( &qpData, 0, qp.g, 0, qp.c, 0, 0, 0, 0, 0 );
+		qpDUNES_updateData( &qpDataRef, 0, qp.g, 0, qp.c, 0, 0, 0, 0, 0 );
+	}
+
+	qpDUNES_cleanup( &qpData );
+	qpDUNES_cleanup( &qpDataRef );
+	test_freeProblem( &qp );
+
+	return test_finish( "ruiz_scaling", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
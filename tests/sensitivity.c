@@ -0,0 +1,207 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/sensitivity.c
+ *
+ *	Compares the tangential predictors of qpDUNES_getSensitivity and
+ *	qpDUNES_getSensitivityMatrixX0 with central finite differences of
+ *	fresh solves, for each Newton system solver, with and without
+ *	scaling of the stage data.
+ */
+
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "test_utils.h"
+
+#define NALG 5			/* number of tested Newton system solvers */
+#define STEP 1.0e-6		/* finite difference step */
+#define TOL 1.0e-5
+
+
+int main( )
+{
+	int_t ii, jj, alg, scaled;
+	int_t nErrors = 0;
+	real_t err;
+
+	nwtnHssnFacAlg_t nwtnHssnFacAlg[NALG] = { QPDUNES_NH_FAC_BAND_FORWARD, QPDUNES_NH_FAC_BAND_REVERSE,
+											  QPDUNES_NH_FAC_BAND_TWISTED, QPDUNES_NH_FAC_BAND_AUTO,
+											  QPDUNES_NH_PCG_BLOCK_JACOBI };
+
+	testProblem_t qp;
+
+	real_t *x0, *dx0, *dc, *c;
+	real_t *dz, *dLambda, *dzDx0, *dLambdaDx0;
+	real_t *zPlus, *zMinus, *lambdaPlus, *lambdaMinus;
+	real_t *dzFD, *dLambdaFD, *dzDx0FD, *dLambdaDx0FD;
+
+	qpData_t qpData;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+	qpOptions.stationarityTolerance = 1.0e-10;	/* finite differences of the solution need an accurate solution */
+
+
+	test_createProblem( &qp, 8, 3, 2, 2.0, 0.5, -1.0, 1.0 );
+	test_perturbProblem( &qp );		/* embeds a fixed initial value */
+
+	x0 = (real_t*)calloc( qp.nX, sizeof(real_t) );
+	dx0 = (real_t*)calloc( qp.nX, sizeof(real_t) );
+	dc = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	c = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	dz = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	dLambda = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	dzDx0 = (real_t*)calloc( qp.nX*qp.nZttl, sizeof(real_t) );
+	dLambdaDx0 = (real_t*)calloc( qp.nX*qp.nXttl, sizeof(real_t) );
+	zPlus = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	zMinus = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	lambdaPlus = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	lambdaMinus = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	dzFD = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	dLambdaFD = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	dzDx0FD = (real_t*)calloc( qp.nX*qp.nZttl, sizeof(real_t) );
+	dLambdaDx0FD = (real_t*)calloc( qp.nX*qp.nXttl, sizeof(real_t) );
+
+	for (ii = 0; ii < qp.nX; ++ii) {
+		x0[ii] = qp.zLow[ii];
+		dx0[ii] = test_random();
+	}
+	for (ii = 0; ii < qp.nXttl; ++ii) {
+		c[ii] = qp.c[ii];
+		dc[ii] = test_random();
+	}
+
+	/** (1) reference: central differences along (dx0,dc) and along each initial state */
+	for (jj = -1; jj < qp.nX; ++jj) {
+		for (ii = 0; ii < qp.nX; ++ii) {
+			qp.zLow[ii] = x0[ii] + STEP * ( (jj < 0) ? dx0[ii] : (ii == jj) );
+			qp.zUpp[ii] = qp.zLow[ii];
+		}
+		for (ii = 0; ii < qp.nXttl; ++ii) {
+			qp.c[ii] = c[ii] + ( (jj < 0) ? STEP * dc[ii] : 0. );
+		}
+		test_check( &nErrors, test_solveProblem( &qp, &qpOptions, zPlus, lambdaPlus ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+					"direction %d: QP solver failed on forward difference", jj );
+
+		for (ii = 0; ii < qp.nX; ++ii) {
+			qp.zLow[ii] = x0[ii] - STEP * ( (jj < 0) ? dx0[ii] : (ii == jj) );
+			qp.zUpp[ii] = qp.zLow[ii];
+		}
+		for (ii = 0; ii < qp.nXttl; ++ii) {
+			qp.c[ii] = c[ii] - ( (jj < 0) ? STEP * dc[ii] : 0. );
+		}
+		test_check( &nErrors, test_solveProblem( &qp, &qpOptions, zMinus, lambdaMinus ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+					"direction %d: QP solver failed on backward difference", jj );
+
+		for (ii = 0; ii < qp.nZttl; ++ii) {
+			if (jj < 0) {
+				dzFD[ii] = ( zPlus[ii] - zMinus[ii] ) / ( 2. * STEP );
+			}
+			else {
+				dzDx0FD[jj*qp.nZttl + ii] = ( zPlus[ii] - zMinus[ii] ) / ( 2. * STEP );
+			}
+		}
+		for (ii = 0; ii < qp.nXttl; ++ii) {
+			if (jj < 0) {
+				dLambdaFD[ii] = ( lambdaPlus[ii] - lambdaMinus[ii] ) / ( 2. * STEP );
+			}
+			else {
+				dLambdaDx0FD[jj*qp.nXttl + ii] = ( lambdaPlus[ii] - lambdaMinus[ii] ) / ( 2. * STEP );
+			}
+		}
+	}
+	for (ii = 0; ii < qp.nX; ++ii) {
+		qp.zLow[ii] = x0[ii];
+		qp.zUpp[ii] = x0[ii];
+	}
+	for (ii = 0; ii < qp.nXttl; ++ii) {
+		qp.c[ii] = c[ii];
+	}
+
+	/** (2) sensitivities at the nominal solution */
+	for (scaled = 0; scaled < 2; ++scaled) {
+		qpOptions.maxNumScalingIterations = scaled ? 5 : 0;
+		for (alg = 0; alg < NALG; ++alg) {
+			qpOptions.nwtnHssnFacAlg = nwtnHssnFacAlg[alg];
+			if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+				return 1;
+			}
+			test_check( &nErrors, qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+						"solver %d, scaling %d: QP solver failed", nwtnHssnFacAlg[alg], scaled );
+
+			test_check( &nErrors, qpDUNES_getSensitivity( &qpData, dx0, dc, dLambda, dz ) == QPDUNES_OK,
+						"solver %d, scaling %d: directional sensitivity failed", nwtnHssnFacAlg[alg], scaled );
+			err = 0.;
+			for (ii = 0; ii < qp.nZttl; ++ii) {
+				err = fmax( err, fabs( dz[ii] - dzFD[ii] ) );
+			}
+			for (ii = 0; ii < qp.nXttl; ++ii) {
+				err = fmax( err, fabs( dLambda[ii] - dLambdaFD[ii] ) );
+			}
+			test_check( &nErrors, err <= TOL,
+						"solver %d, scaling %d: directional sensitivity differs from finite differences by %.3e", nwtnHssnFacAlg[alg], scaled, err );
+
+			test_check( &nErrors, qpDUNES_getSensitivityMatrixX0( &qpData, dLambdaDx0, dzDx0 ) == QPDUNES_OK,
+						"solver %d, scaling %d: initial value sensitivity failed", nwtnHssnFacAlg[alg], scaled );
+			err = 0.;
+			for (ii = 0; ii < qp.nX*qp.nZttl; ++ii) {
+				err = fmax( err, fabs( dzDx0[ii] - dzDx0FD[ii] ) );
+			}
+			for (ii = 0; ii < qp.nX*qp.nXttl; ++ii) {
+				err = fmax( err, fabs( dLambdaDx0[ii] - dLambdaDx0FD[ii] ) );
+			}
+			test_check( &nErrors, err <= TOL,
+						"solver %d, scaling %d: initial value sensitivity differs from finite differences by %.3e", nwtnHssnFacAlg[alg], scaled, err );
+
+			qpDUNES_cleanup( &qpData );
+		}
+	}
+
+	free( x0 );
+	free( dx0 );
+	free( dc );
+	free( c );
+	free( dz );
+	free( dLambda );
+	free( dzDx0 );
+	free( dLambdaDx0 );
+	free( zPlus );
+	free( zMinus );
+	free( lambdaPlus );
+	free( lambdaMinus );
+	free( dzFD );
+	free( dLambdaFD );
+	free( dzDx0FD );
+	free( dLambdaDx0FD );
+	test_freeProblem( &qp );
+
+	return test_finish( "sensitivity", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
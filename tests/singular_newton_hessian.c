@@ -0,0 +1,92 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/singular_newton_hessian.c
+ *
+ *	Solves a test QP whose strong linear terms drive all variables of
+ *	several stages to their bounds, so that the Newton Hessian becomes
+ *	singular, with the regularization by the unconstrained Newton Hessian
+ *	curvature, and compares the solution with a solve that regularizes
+ *	singular directions by the regularization parameter.
+ */
+
+
+#include "test_utils.h"
+
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t it;
+	int_t nErrors = 0;
+	boolean_t isRegularized = QPDUNES_FALSE;
+
+	testProblem_t qp;
+
+	qpData_t qpData;
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel = QPDUNES_LOG_ITERATIONS;
+	qpOptions.stationarityTolerance = 1.0e-8;
+
+
+	test_createProblem( &qp, 10, 3, 2, 20.0, 0.5, -0.5, 0.5 );
+
+	qpOptions.regType = QPDUNES_REG_SINGULAR_DIRECTIONS;
+	if ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	qpOptions.regType = QPDUNES_REG_UNCONSTRAINED_HESSIAN;
+	if ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+
+	test_check( &nErrors, qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "reference QP solver failed" );
+	test_check( &nErrors, qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND,
+				"QP solver failed with the unconstrained Newton Hessian regularization" );
+	test_check( &nErrors, test_solutionDifference( &qpData, &qpDataRef ) <= TOL,
+				"solution with the unconstrained Newton Hessian regularization differs by %.3e", test_solutionDifference( &qpData, &qpDataRef ) );
+
+	/* the test is void if the Newton Hessian never needed regularization */
+	for (it = 1; it <= qpData.log.numIter; ++it) {
+		if ( qpData.log.itLog[it].isHessianRegularized == QPDUNES_TRUE ) {
+			isRegularized = QPDUNES_TRUE;
+		}
+	}
+	test_check( &nErrors, isRegularized, "Newton Hessian was never regularized" );
+
+	qpDUNES_cleanup( &qpData );
+	qpDUNES_cleanup( &qpDataRef );
+	test_freeProblem( &qp );
+
+	return test_finish( "singular_newton_hessian", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,161 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/soft_bounds.c
+ *
+ *	Checks L1/L2 soft variable bounds: exact L1 penalties reproduce the
+ *	hard bounded solution, penalized solutions are stationary with the
+ *	reported multipliers, and setting, clearing and setting the soft
+ *	bounds again on one instance matches freshly initialized solvers.
+ */
+
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "test_utils.h"
+
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t ii, jj, kk, off, nV;
+	int_t nErrors = 0;
+	int_t nViolated = 0;
+
+	real_t err, res;
+
+	testProblem_t qp;
+	real_t *softL1, *softL2, *softL1Exact;
+	real_t *z, *lambda, *y;
+
+	qpData_t qpData;
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+
+
+	/* bounds tight enough to be violated by the soft solution */
+	test_createProblem( &qp, 6, 2, 1, 4.0, 0.3, -0.6, 0.6 );
+	softL1 = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	softL2 = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	softL1Exact = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	z = (real_t*)calloc( qp.nZttl, sizeof(real_t) );
+	lambda = (real_t*)calloc( qp.nXttl, sizeof(real_t) );
+	y = (real_t*)calloc( 2*qp.nZttl, sizeof(real_t) );
+	for (ii = 0; ii < qp.nZttl; ++ii) {
+		softL1[ii] = ( ii % 3 ) ? 0.5 : 0.;
+		softL2[ii] = ( ii % 2 ) ? 1.0 : 0.5;
+		softL1Exact[ii] = 1.0e3;
+	}
+
+	if ( ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) ||
+		 ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) )
+	{
+		return 1;
+	}
+	test_check( &nErrors, qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "hard bounded QP solver failed" );
+
+
+	/* (1) exact L1 penalties reproduce the hard bounded solution */
+	qpDUNES_setSoftBounds( &qpData, softL1Exact, 0 );
+	test_check( &nErrors, qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "QP solver failed with exact penalties" );
+	err = test_solutionDifference( &qpData, &qpDataRef );
+	test_check( &nErrors, err <= TOL, "exact penalty solution differs from hard bounds by %.3e", err );
+
+
+	/* (2) penalized soft bounds: fresh solve and stationarity with the reported multipliers */
+	qpDUNES_setSoftBounds( &qpData, softL1, softL2 );
+	test_check( &nErrors, qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "QP solver failed with soft bounds" );
+	qpDUNES_cleanup( &qpDataRef );
+	test_setupSolver( &qpDataRef, &qp, &qpOptions );
+	qpDUNES_setSoftBounds( &qpDataRef, softL1, softL2 );
+	test_check( &nErrors, qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "fresh soft bounded QP solver failed" );
+	err = test_solutionDifference( &qpData, &qpDataRef );
+	test_check( &nErrors, err <= TOL, "soft bounded solution differs from fresh solve by %.3e", err );
+
+	qpDUNES_getPrimalSol( &qpData, z );
+	qpDUNES_getDualSol( &qpData, lambda, y );
+	err = 0.;
+	for (kk = 0; kk <= qp.nI; ++kk) {
+		off = kk * qp.nZ;
+		nV = ( kk < qp.nI ) ? qp.nZ : qp.nX;
+		for (ii = 0; ii < nV; ++ii) {
+			if ( fmax( qp.zLow[off+ii] - z[off+ii], z[off+ii] - qp.zUpp[off+ii] ) > TOL ) {
+				++nViolated;
+			}
+			res = qp.H[kk*qp.nZ*qp.nZ + ii*nV + ii] * z[off+ii] + qp.g[off+ii] - y[2*(off+ii)] + y[2*(off+ii)+1];
+			if ( kk < qp.nI ) {
+				for (jj = 0; jj < qp.nX; ++jj) {
+					res += qp.C[(kk*qp.nX + jj)*qp.nZ + ii] * lambda[kk*qp.nX + jj];
+				}
+			}
+			if ( ( kk > 0 ) && ( ii < qp.nX ) ) {
+				res -= lambda[(kk-1)*qp.nX + ii];
+			}
+			err = fmax( err, fabs( res ) );
+		}
+	}
+	test_check( &nErrors, nViolated > 0, "no soft bound is violated, test problem too loose" );
+	test_check( &nErrors, err <= TOL, "soft bounded solution not stationary with reported multipliers, residual %.3e", err );
+
+
+	/* (3) clearing the soft bounds restores the hard bounded solution */
+	qpDUNES_setSoftBounds( &qpData, 0, 0 );
+	test_check( &nErrors, qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "QP solver failed after clearing soft bounds" );
+	qpDUNES_cleanup( &qpDataRef );
+	test_setupSolver( &qpDataRef, &qp, &qpOptions );
+	test_check( &nErrors, qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND, "hard bounded QP solver failed" );
+	err = test_solutionDifference( &qpData, &qpDataRef );
+	test_check( &nErrors, err <= TOL, "solution after clearing soft bounds differs from hard bounds by %.3e", err );
+
+
+	/* (4) setting them again matches the fresh soft solve */
+	qpDUNES_setSoftBounds( &qpData, softL1, softL2 );
+	qpDUNES_setSoftBounds( &qpDataRef, softL1, softL2 );
+	test_check( &nErrors, ( qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+						  ( qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ),
+				"QP solver failed after setting soft bounds again" );
+	err = test_solutionDifference( &qpData, &qpDataRef );
+	test_check( &nErrors, err <= TOL, "solution after setting soft bounds again differs by %.3e", err );
+
+	qpDUNES_cleanup( &qpData );
+	qpDUNES_cleanup( &qpDataRef );
+	test_freeProblem( &qp );
+	free( softL1 );
+	free( softL2 );
+	free( softL1Exact );
+	free( z );
+	free( lambda );
+	free( y );
+
+	return test_finish( "soft_bounds", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,117 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/structured_dynamics.c
+ *
+ *	Checks the detection of block diagonal, banded and integrator chain
+ *	state blocks in the dynamics and compares the structure exploiting
+ *	solution with the general dense path.
+ */
+
+
+#include "test_utils.h"
+
+#define TOL 1.0e-10
+
+
+int main( )
+{
+	int_t ii, jj, kk, mode, run;
+	int_t nErrors = 0;
+	boolean_t inStructure;
+
+	testProblem_t qp;
+
+	/* expected structure per mode */
+	structureType_t expectedType[3] = { QPDUNES_STRUCTURE_BLOCK_DIAGONAL, QPDUNES_STRUCTURE_BANDED, QPDUNES_STRUCTURE_INTEGRATOR_CHAIN };
+
+	qpData_t qpData;
+	qpData_t qpDataRef;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+	qpOptions.sparseDensityThreshold = 0.;		/* keep C dense, so that structure is detected */
+
+
+	for (mode = 0; mode < 3; ++mode)
+	{
+		/* state blocks: 0 block diagonal (3x3), 1 banded, 2 integrator chain */
+		test_createProblem( &qp, 10, 6, 2, 3.0, 0.3, -1.5, 1.0 );
+		for (kk = 0; kk < qp.nI; ++kk) {
+			for (ii = 0; ii < qp.nX; ++ii) {
+				for (jj = 0; jj < qp.nX; ++jj) {
+					inStructure = (mode == 0) ? (ii/3 == jj/3) : ( (mode == 1) ? ( (jj >= ii-2) && (jj <= ii+1) ) : ( (jj == ii) || (jj == ii+1) ) );
+					qp.C[(kk*qp.nX + ii)*qp.nZ + jj] = 0.;
+					if (inStructure) {
+						qp.C[(kk*qp.nX + ii)*qp.nZ + jj] = ( (mode == 2) && (ii == jj) ) ? 1.0 : 0.5*test_random() + (ii == jj);
+					}
+				}
+			}
+		}
+
+		if ( ( test_setupSolver( &qpData, &qp, &qpOptions ) != QPDUNES_OK ) ||
+			 ( test_setupSolver( &qpDataRef, &qp, &qpOptions ) != QPDUNES_OK ) )
+		{
+			return 1;
+		}
+		for (kk = 0; kk < qp.nI; ++kk) {
+			test_check( &nErrors, qpData.intervals[kk]->C.structure.type == expectedType[mode],
+						"mode %d: structure %d detected on stage %d, expected %d", mode, qpData.intervals[kk]->C.structure.type, kk, expectedType[mode] );
+			qpDataRef.intervals[kk]->C.structure.type = QPDUNES_STRUCTURE_GENERAL;	/* reference: general dense kernels */
+		}
+
+		/* solve, then break the structure by a data update and solve again */
+		for (run = 0; run < 2; ++run)
+		{
+			test_check( &nErrors, ( qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+								  ( qpDUNES_solve( &qpDataRef ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ),
+						"mode %d: QP solver failed", mode );
+			test_check( &nErrors, test_solutionDifference( &qpData, &qpDataRef ) <= TOL,
+						"mode %d, solve %d: solution differs from dense path", mode, run );
+
+			if (run == 0) {
+				for (kk = 0; kk < qp.nI; ++kk) {
+					qp.C[(kk*qp.nX + qp.nX-1)*qp.nZ] = 0.3;
+				}
+				qpDUNES_updateData( &qpData, 0, 0, qp.C, 0, 0, 0, 0, 0, 0 );
+				qpDUNES_updateData( &qpDataRef, 0, 0, qp.C, 0, 0, 0, 0, 0, 0 );
+				for (kk = 0; kk < qp.nI; ++kk) {
+					test_check( &nErrors, qpData.intervals[kk]->C.structure.type == QPDUNES_STRUCTURE_GENERAL,
+								"mode %d: stale structure %d on stage %d after update", mode, qpData.intervals[kk]->C.structure.type, kk );
+				}
+			}
+		}
+
+		qpDUNES_cleanup( &qpData );
+		qpDUNES_cleanup( &qpDataRef );
+		test_freeProblem( &qp );
+	}
+
+	return test_finish( "structured_dynamics", nErrors );
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,315 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/test_utils.c
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include "test_utils.h"
+
+
+static unsigned int seed = 1u;
+
+
+/* ----------------------------------------------
+ * restart random sequence
+ *
+ >>>>>>                                           */
+void test_setSeed(	unsigned int newSeed
+					)
+{
+	seed = newSeed;
+}
+/*<<< END OF test_setSeed */
+
+
+/* ----------------------------------------------
+ * linear congruential generator, uniform in [-1,1]
+ *
+ >>>>>>                                           */
+real_t test_random( )
+{
+	seed = 1103515245u * seed + 12345u;
+	return ((seed >> 8) % 2001) / 1000.0 - 1.0;
+}
+/*<<< END OF test_random */
+
+
+/* ----------------------------------------------
+ * random test QP
+ *
+ >>>>>>                                           */
+return_t test_createProblem(	testProblem_t* const problem,
+								int_t nI,
+								int_t nX,
+								int_t nU,
+								real_t gScale,
+								real_t cScale,
+								real_t lowerBound,
+								real_t upperBound
+								)
+{
+	int_t ii, jj, kk;
+	int_t nV;
+
+	problem->nI = nI;
+	problem->nX = nX;
+	problem->nU = nU;
+	problem->nZ = nX + nU;
+	problem->nZttl = nI * problem->nZ + nX;
+	problem->nXttl = nI * nX;
+
+	problem->H = (real_t*)calloc( nI*problem->nZ*problem->nZ + nX*nX, sizeof(real_t) );
+	problem->g = (real_t*)calloc( problem->nZttl, sizeof(real_t) );
+	problem->C = (real_t*)calloc( nI*nX*problem->nZ, sizeof(real_t) );
+	problem->c = (real_t*)calloc( problem->nXttl, sizeof(real_t) );
+	problem->zLow = (real_t*)calloc( problem->nZttl, sizeof(real_t) );
+	problem->zUpp = (real_t*)calloc( problem->nZttl, sizeof(real_t) );
+	if ( ( problem->H == 0 ) || ( problem->g == 0 ) || ( problem->C == 0 ) || ( problem->c == 0 ) || ( problem->zLow == 0 ) || ( problem->zUpp == 0 ) ) {
+		test_freeProblem( problem );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	for (kk = 0; kk <= nI; ++kk) {
+		nV = ( kk < nI ) ? problem->nZ : nX;
+		for (ii = 0; ii < nV; ++ii) {
+			problem->H[kk*problem->nZ*problem->nZ + ii*nV + ii] = 2.0 + test_random();
+		}
+	}
+	for (ii = 0; ii < problem->nZttl; ++ii) {
+		problem->g[ii] = gScale * test_random();
+		problem->zLow[ii] = lowerBound;
+		problem->zUpp[ii] = upperBound;
+	}
+	for (kk = 0; kk < nI; ++kk) {
+		for (ii = 0; ii < nX; ++ii) {
+			for (jj = 0; jj < problem->nZ; ++jj) {
+				problem->C[(kk*nX + ii)*problem->nZ + jj] = cScale * test_random() + ( ii == jj );
+			}
+			problem->c[kk*nX + ii] = 0.3 * test_random();
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF test_createProblem */
+
+
+/* ----------------------------------------------
+ * free test QP data
+ *
+ >>>>>>                                           */
+void test_freeProblem(	testProblem_t* const problem
+						)
+{
+	qpDUNES_free( &(problem->H) );
+	qpDUNES_free( &(problem->g) );
+	qpDUNES_free( &(problem->C) );
+	qpDUNES_free( &(problem->c) );
+	qpDUNES_free( &(problem->zLow) );
+	qpDUNES_free( &(problem->zUpp) );
+}
+/*<<< END OF test_freeProblem */
+
+
+/* ----------------------------------------------
+ * new gradient and initial value
+ *
+ >>>>>>                                           */
+void test_perturbProblem(	testProblem_t* const problem
+							)
+{
+	int_t ii;
+
+	for (ii = 0; ii < problem->nZttl; ++ii) {
+		if ( test_random() > 0.5 ) {
+			problem->g[ii] += 0.5 * test_random();
+		}
+	}
+	for (ii = 0; ii < problem->nX; ++ii) {
+		problem->zLow[ii] = 0.3 * test_random();
+		problem->zUpp[ii] = problem->zLow[ii];
+	}
+}
+/*<<< END OF test_perturbProblem */
+
+
+/* ----------------------------------------------
+ * set up and initialize a solver for a test QP
+ *
+ >>>>>>                                           */
+return_t test_setupSolver(	qpData_t* const qpData,
+							const testProblem_t* const problem,
+							qpOptions_t* const qpOptions
+							)
+{
+	return_t statusFlag;
+
+	statusFlag = qpDUNES_setup( qpData, problem->nI, problem->nX, problem->nU, 0, qpOptions );
+	if ( statusFlag != QPDUNES_OK ) {
+		printf( "Setup of the QP solver failed\n" );
+		return statusFlag;
+	}
+
+	return qpDUNES_init( qpData, problem->H, problem->g, problem->C, problem->c, problem->zLow, problem->zUpp, 0, 0, 0 );
+}
+/*<<< END OF test_setupSolver */
+
+
+/* ----------------------------------------------
+ * solve with a fresh solver instance
+ *
+ >>>>>>                                           */
+return_t test_solveProblem(	const testProblem_t* const problem,
+							qpOptions_t* const qpOptions,
+							real_t* const z,
+							real_t* const lambda
+							)
+{
+	return_t statusFlag;
+	qpData_t qpData;
+	real_t* y;
+
+	statusFlag = test_setupSolver( &qpData, problem, qpOptions );
+	if ( statusFlag != QPDUNES_OK ) {
+		qpDUNES_cleanup( &qpData );
+		return statusFlag;
+	}
+	statusFlag = qpDUNES_solve( &qpData );
+
+	y = (real_t*)calloc( 2*problem->nZttl, sizeof(real_t) );
+	qpDUNES_getPrimalSol( &qpData, z );
+	qpDUNES_getDualSol( &qpData, lambda, y );
+	free( y );
+
+	qpDUNES_cleanup( &qpData );
+
+	return statusFlag;
+}
+/*<<< END OF test_solveProblem */
+
+
+/* ----------------------------------------------
+ * maximum difference of primal solutions and coupling multipliers
+ *
+ >>>>>>                                           */
+real_t test_solutionDifference(	qpData_t* const qpData,
+								qpData_t* const qpDataRef
+								)
+{
+	uint_t ii, kk;
+	uint_t nZttl = 0;
+	real_t err = 0.;
+	real_t* z;
+	real_t* zRef;
+	real_t* lambda;
+	real_t* lambdaRef;
+	real_t* y;
+
+	for (kk = 0; kk <= qpData->nI; ++kk) {
+		nZttl += qpData->intervals[kk]->nV;
+	}
+	z = (real_t*)calloc( nZttl, sizeof(real_t) );
+	zRef = (real_t*)calloc( nZttl, sizeof(real_t) );
+	lambda = (real_t*)calloc( qpData->nXttl, sizeof(real_t) );
+	lambdaRef = (real_t*)calloc( qpData->nXttl, sizeof(real_t) );
+	y = (real_t*)calloc( 2*(nZttl + qpData->nDttl), sizeof(real_t) );
+
+	qpDUNES_getPrimalSol( qpData, z );
+	qpDUNES_getPrimalSol( qpDataRef, zRef );
+	qpDUNES_getDualSol( qpData, lambda, y );
+	qpDUNES_getDualSol( qpDataRef, lambdaRef, y );
+
+	for (ii = 0; ii < nZttl; ++ii) {
+		err = fmax( err, fabs( z[ii] - zRef[ii] ) );
+	}
+	for (ii = 0; ii < qpData->nXttl; ++ii) {
+		err = fmax( err, fabs( lambda[ii] - lambdaRef[ii] ) );
+	}
+
+	free( z );
+	free( zRef );
+	free( lambda );
+	free( lambdaRef );
+	free( y );
+
+	return err;
+}
+/*<<< END OF test_solutionDifference */
+
+
+/* ----------------------------------------------
+ * error reporting
+ *
+ >>>>>>                                           */
+void test_check(	int_t* const nErrors,
+					boolean_t passed,
+					const char* const format,
+					...
+					)
+{
+	va_list args;
+
+	if ( passed == QPDUNES_TRUE ) {
+		return;
+	}
+
+	va_start( args, format );
+	vprintf( format, args );
+	va_end( args );
+	printf( "\n" );
+
+	++(*nErrors);
+}
+/*<<< END OF test_check */
+
+
+/* ----------------------------------------------
+ * test summary
+ *
+ >>>>>>                                           */
+int test_finish(	const char* const testName,
+					int_t nErrors
+					)
+{
+	if ( nErrors > 0 ) {
+		printf( "%s failed with %d errors.\n", testName, (int)nErrors );
+		return 1;
+	}
+	printf( "%s passed.\n", testName );
+
+	return 0;
+}
+/*<<< END OF test_finish */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,152 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/test_utils.h
+ *
+ *	Shared fixture of the qpDUNES tests: deterministic random test QPs
+ *	with constant stage dimensions, solver setup, comparison of solutions
+ *	and error reporting.
+ */
+
+
+#ifndef QPDUNES_TEST_UTILS_H
+#define QPDUNES_TEST_UTILS_H
+
+
+#include <qpDUNES.h>
+
+
+/** test QP with constant stage dimensions, data laid out as expected by qpDUNES_init */
+typedef struct
+{
+	int_t nI;
+	int_t nX;
+	int_t nU;
+	int_t nZ;
+	int_t nZttl;		/**< number of primal variables, nI*nZ+nX */
+	int_t nXttl;		/**< number of coupling multipliers, nI*nX */
+
+	real_t* H;			/**< diagonal stage Hessians (nI*nZ*nZ+nX*nX entries) */
+	real_t* g;
+	real_t* C;			/**< row major nX x nZ dynamics per stage */
+	real_t* c;
+	real_t* zLow;
+	real_t* zUpp;
+} testProblem_t;
+
+
+/**
+ *	\brief restart the deterministic random number sequence
+ */
+void test_setSeed(	unsigned int seed
+					);
+
+/**
+ *	\brief deterministic pseudo random number in [-1,1]
+ */
+real_t test_random( );
+
+/**
+ *	\brief allocate a test QP and fill it with random data
+ *
+ *	Hessians are diagonal with entries in [1,3], gradients are scaled by
+ *	gScale, the dynamics are identity plus cScale-scaled perturbations on
+ *	all columns, and all variables are bounded by [lowerBound,upperBound].
+ */
+return_t test_createProblem(	testProblem_t* const problem,
+								int_t nI,
+								int_t nX,
+								int_t nU,
+								real_t gScale,
+								real_t cScale,
+								real_t lowerBound,
+								real_t upperBound
+								);
+
+void test_freeProblem(	testProblem_t* const problem
+						);
+
+/**
+ *	\brief next QP of an MPC like sequence
+ *
+ *	Perturbs about a quarter of the gradient entries and fixes the
+ *	initial state to a new random value through its bounds.
+ */
+void test_perturbProblem(	testProblem_t* const problem
+							);
+
+/**
+ *	\brief set up a solver instance for the test QP and initialize it with its data
+ */
+return_t test_setupSolver(	qpData_t* const qpData,
+							const testProblem_t* const problem,
+							qpOptions_t* const qpOptions
+							);
+
+/**
+ *	\brief solve the test QP with a fresh solver instance
+ *
+ *	Returns the status of qpDUNES_solve; z (nZttl) and lambda (nXttl)
+ *	receive the primal and coupling multiplier solutions.
+ */
+return_t test_solveProblem(	const testProblem_t* const problem,
+							qpOptions_t* const qpOptions,
+							real_t* const z,
+							real_t* const lambda
+							);
+
+/**
+ *	\brief largest difference of the primal and coupling multiplier
+ *	solutions of two solver instances with equal dimensions
+ */
+real_t test_solutionDifference(	qpData_t* const qpData,
+								qpData_t* const qpDataRef
+								);
+
+/**
+ *	\brief count and report a failed check
+ *
+ *	Prints the message if passed is false and increases nErrors.
+ */
+void test_check(	int_t* const nErrors,
+					boolean_t passed,
+					const char* const format,
+					...
+					);
+
+/**
+ *	\brief print the test summary and return the process exit code
+ */
+int test_finish(	const char* const testName,
+					int_t nErrors
+					);
+
+
+#endif	/* QPDUNES_TEST_UTILS_H */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,173 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tests/variable_dimensions.c
+ *
+ *	Solves a QP with stage dependent state and control dimensions and
+ *	compares it with the same QP padded to constant dimensions, where
+ *	the padding variables are decoupled and zero at the optimum.
+ */
+
+
+#include <math.h>
+
+#include "test_utils.h"
+
+#define TOL 1.0e-6
+
+
+int main( )
+{
+	int_t ii, jj, kk;
+	int_t nV, nXK1;
+	int_t iP, jP;				/* indices in the padded stage */
+	int_t nErrors = 0;
+
+	uint_t nX[7] = { 2, 3, 4, 3, 2, 2, 3 };
+	uint_t nU[6] = { 1, 2, 1, 1, 2, 1 };
+	uint_t nD[7] = { 0 };
+
+	/* offsets into the variable dimension data */
+	int_t offH = 0, offZ = 0, offC = 0, offX = 0;
+
+	real_t err = 0.;
+
+	testProblem_t padded;			/* constant dimensions nX = 4, nU = 2 */
+	real_t H[7*6*6], g[7*6], C[6*4*6], c[6*4], zLow[7*6], zUpp[7*6];
+	real_t z[7*6], lambda[6*4], y[2*7*6];
+	real_t zP[6*6+4], lambdaP[6*4];
+
+	qpData_t qpData;
+	qpData_t qpDataPadded;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.printLevel = 0;
+
+
+	/* padded problem: decoupled unit curvature variables */
+	test_createProblem( &padded, 6, 4, 2, 0., 0., -10., 10. );
+	for (kk = 0; kk <= padded.nI; ++kk) {
+		nV = ( kk < padded.nI ) ? padded.nZ : padded.nX;
+		for (ii = 0; ii < nV; ++ii) {
+			padded.H[kk*padded.nZ*padded.nZ + ii*nV + ii] = 1.;
+		}
+	}
+	for (ii = 0; ii < padded.nI*padded.nX*padded.nZ; ++ii) {
+		padded.C[ii] = 0.;
+	}
+	for (ii = 0; ii < padded.nXttl; ++ii) {
+		padded.c[ii] = 0.;
+	}
+
+	/* variable dimension problem and its embedding */
+	for (kk = 0; kk <= padded.nI; ++kk) {
+		nV = ( kk < padded.nI ) ? (int_t)(nX[kk] + nU[kk]) : (int_t)nX[kk];
+		for (ii = 0; ii < nV; ++ii) {
+			iP = ( ii < (int_t)nX[kk] ) ? ii : padded.nX + ii - (int_t)nX[kk];
+			for (jj = 0; jj < nV; ++jj) {
+				H[offH + ii*nV + jj] = ( ii == jj ) ? 2.0 + test_random() : 0.;
+			}
+			g[offZ + ii] = 3.0 * test_random();
+			zLow[offZ + ii] = -1.0;
+			zUpp[offZ + ii] = 0.8;
+
+			padded.H[kk*padded.nZ*padded.nZ + iP*( ( kk < padded.nI ) ? padded.nZ : padded.nX ) + iP] = H[offH + ii*nV + ii];
+			padded.g[kk*padded.nZ + iP] = g[offZ + ii];
+			padded.zLow[kk*padded.nZ + iP] = zLow[offZ + ii];
+			padded.zUpp[kk*padded.nZ + iP] = zUpp[offZ + ii];
+		}
+		if ( kk < padded.nI ) {
+			nXK1 = nX[kk+1];
+			for (ii = 0; ii < nXK1; ++ii) {
+				for (jj = 0; jj < nV; ++jj) {
+					jP = ( jj < (int_t)nX[kk] ) ? jj : padded.nX + jj - (int_t)nX[kk];
+					C[offC + ii*nV + jj] = 0.4 * test_random() + ( ii == jj );
+					padded.C[(kk*padded.nX + ii)*padded.nZ + jP] = C[offC + ii*nV + jj];
+				}
+				c[offX + ii] = 0.3 * test_random();
+				padded.c[kk*padded.nX + ii] = c[offX + ii];
+			}
+			offC += nXK1*nV;
+			offX += nXK1;
+		}
+		offH += nV*nV;
+		offZ += nV;
+	}
+
+
+	/* solve both */
+	if ( qpDUNES_setupVariableDims( &qpData, padded.nI, nX, nU, nD, &qpOptions ) != QPDUNES_OK ) {
+		printf( "Setup of the QP solver failed\n" );
+		return 1;
+	}
+	if ( test_setupSolver( &qpDataPadded, &padded, &qpOptions ) != QPDUNES_OK ) {
+		return 1;
+	}
+	qpDUNES_init( &qpData, H, g, C, c, zLow, zUpp, 0, 0, 0 );
+
+	test_check( &nErrors, ( qpDUNES_solve( &qpData ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+						  ( qpDUNES_solve( &qpDataPadded ) == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ),
+				"QP solver failed" );
+	qpDUNES_getPrimalSol( &qpData, z );
+	qpDUNES_getPrimalSol( &qpDataPadded, zP );
+	qpDUNES_getDualSol( &qpData, lambda, y );
+	qpDUNES_getDualSol( &qpDataPadded, lambdaP, y );
+
+
+	/* compare, padding variables have to vanish */
+	offZ = 0;
+	offX = 0;
+	for (kk = 0; kk <= padded.nI; ++kk) {
+		for (iP = 0; iP < ( ( kk < padded.nI ) ? padded.nZ : padded.nX ); ++iP) {
+			if ( iP < (int_t)nX[kk] ) {
+				err = fmax( err, fabs( z[offZ + iP] - zP[kk*padded.nZ + iP] ) );
+			}
+			else if ( ( iP >= padded.nX ) && ( iP < padded.nX + (int_t)nU[kk] ) ) {
+				err = fmax( err, fabs( z[offZ + nX[kk] + iP - padded.nX] - zP[kk*padded.nZ + iP] ) );
+			}
+			else {
+				err = fmax( err, fabs( zP[kk*padded.nZ + iP] ) );
+			}
+		}
+		if ( kk < padded.nI ) {
+			for (ii = 0; ii < (int_t)nX[kk+1]; ++ii) {
+				err = fmax( err, fabs( lambda[offX + ii] - lambdaP[kk*padded.nX + ii] ) );
+			}
+			offX += nX[kk+1];
+			offZ += nX[kk] + nU[kk];
+		}
+	}
+	test_check( &nErrors, err <= TOL, "solution differs from padded problem by %.3e", err );
+
+	qpDUNES_cleanup( &qpData );
+	qpDUNES_cleanup( &qpDataPadded );
+	test_freeProblem( &padded );
+
+	return test_finish( "variable_dimensions", nErrors );
+}
+
+
+/*
+ *	end of file
+ */